@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>      // size_t
+#include <new>          // operator new(), operator delete(), align_val_t
+
+// Cache-line aligned heap blocks for the array containers (VecSoA, VecIndex, MatX, ComplexArray):
+// one allocation path, one alignment, and the padding that starts a following stream on a boundary.
+class Aligned {
+    Aligned() = delete;
+    Aligned(const Aligned&) = delete;
+    Aligned(Aligned&&) noexcept = delete;
+    ~Aligned() noexcept = delete;
+
+    Aligned& operator=(const Aligned&) = delete;
+    Aligned& operator=(Aligned&&) noexcept = delete;
+
+    public:
+        inline static constexpr std::size_t ALIGNMENT = 64;
+
+        // count uninitialized T on an ALIGNMENT boundary, throws std::bad_alloc
+        template <typename T>
+        static inline T* allocate(const std::size_t& count);
+        // a block from allocate(), nullptr does nothing
+        static inline void release(void*) noexcept;
+
+        // count rounded up to whole ALIGNMENT bytes of T, so a stream placed after it stays aligned
+        template <typename T>
+        static inline constexpr std::size_t roundUp(const std::size_t& count) noexcept;
+};
+
+template <typename T>
+inline T* Aligned::allocate(const std::size_t& count) { return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{ ALIGNMENT })); }
+inline void Aligned::release(void* block) noexcept {
+    if (block != nullptr)
+        ::operator delete(block, std::align_val_t{ ALIGNMENT });
+}
+
+template <typename T>
+inline constexpr std::size_t Aligned::roundUp(const std::size_t& count) noexcept {
+    static_assert(ALIGNMENT % sizeof(T) == 0);
+
+    constexpr std::size_t lanes = ALIGNMENT / sizeof(T);
+
+    return ((count + lanes - 1) / lanes) * lanes;
+}
\ No newline at end of file
@@ -6,4 +6,8 @@ template <typename T, unsigned int DIM, typename = enableIF<isArithmetic<T>>>
 class Vec;
 
 template <typename T, unsigned int ROW, unsigned int COL, typename = enableIF<isArithmetic<T>>>
-class Mat;
\ No newline at end of file
+class Mat;
+
+// lazy lane-wise expression (expr.hpp)
+template <typename E>
+class Expr;
\ No newline at end of file
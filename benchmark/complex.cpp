@@ -0,0 +1,154 @@
+// Complex<float> / Complex<double> elementary functions against std::complex: M values per second for
+// std::complex<T>, the scalar member and the batched static form over 4096 values with both parts in
+// [-4, 4], and the largest relative error of each against std::complex<long double>.
+//
+//   g++ -std=c++17 -O2 -DNDEBUG -I.. complex.cpp -o complex      [-DMATH_ENABLE_SIMD -mavx2 -mfma]
+
+#include "../complex.hpp"
+
+#include <algorithm>    // max()
+#include <chrono>       // steady_clock
+#include <complex>      // complex, abs(), arg(), exp(), log(), sqrt(), pow()
+#include <cstddef>      // size_t
+#include <cstdio>       // printf()
+#include <random>       // mt19937, uniform_real_distribution
+#include <vector>       // vector
+
+using Reference = std::complex<long double>;
+
+// best of seven rounds of 50 calls of f() over count values, in M values per second
+template <typename F>
+static double rate(const F& f, const std::size_t& count) {
+    using Clock = std::chrono::steady_clock;
+
+    double best = 0;
+    for (int round = 0; round < 7; ++round) {
+        const Clock::time_point start = Clock::now();
+
+        for (int rep = 0; rep < 50; ++rep) {
+            f();
+            asm volatile("" ::: "memory");
+        }
+
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        best = std::max(best, 50.0 * static_cast<double>(count) / seconds / 1e6);
+    }
+
+    return best;
+}
+
+template <typename T>
+static double error(const T& a, const long double& exact) {
+    const long double d = std::abs(static_cast<long double>(a) - exact);
+
+    return static_cast<double>((exact != 0) ? d / std::abs(exact) : d);
+}
+template <typename T>
+static double error(const Complex<T>& a, const Reference& exact) {
+    const long double d = std::abs(Reference(a.real(), a.imaginary()) - exact);
+
+    return static_cast<double>((std::abs(exact) != 0) ? d / std::abs(exact) : d);
+}
+
+// one function: std(z), one(z) and batch(in, out) for every value, checked against ref(z)
+template <typename T, typename O, typename S, typename F, typename B, typename R>
+static void measure(const char* name, const std::vector<Complex<T>>& in, const S& std, const F& one, const B& batch, const R& ref) {
+    const std::size_t count = in.size();
+
+    std::vector<O> a(count), b(count), c(count);
+    batch(in.data(), c.data());
+
+    double errorStd = 0, errorOne = 0, errorBatch = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto exact = ref(Reference(in[i].real(), in[i].imaginary()));
+
+        errorStd = std::max(errorStd, error(std(in[i]), exact));
+        errorOne = std::max(errorOne, error(one(in[i]), exact));
+        errorBatch = std::max(errorBatch, error(c[i], exact));
+    }
+
+    const double rateStd = rate([&] {
+        for (std::size_t i = 0; i < count; ++i)
+            a[i] = std(in[i]);
+    }, count);
+    const double rateOne = rate([&] {
+        for (std::size_t i = 0; i < count; ++i)
+            b[i] = one(in[i]);
+    }, count);
+    const double rateBatch = rate([&] { batch(in.data(), c.data()); }, count);
+
+    std::printf("  %-7s std %6.1f   scalar %6.1f   batch %6.1f   (M/s)   error std %.1e   scalar %.1e   batch %.1e\n",
+                name, rateStd, rateOne, rateBatch, errorStd, errorOne, errorBatch);
+}
+
+template <typename T>
+static void run(const char* name) {
+    using C = Complex<T>;
+    using S = std::complex<T>;
+
+    const std::size_t count = 4096;
+
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<T> dist(-4, 4);
+
+    std::vector<C> in(count);
+    for (C& z: in)
+        z = C(dist(rng), dist(rng));
+
+    const C w(static_cast<T>(0.5), static_cast<T>(0.3));
+    const T p = static_cast<T>(2.5);
+
+    const auto toC = [](const S& z) { return C(z.real(), z.imag()); };
+
+    std::printf("%s\n", name);
+
+    measure<T, T>("abs", in,
+        [](const C& z) { return std::abs(S(z.real(), z.imaginary())); },
+        [](const C& z) { return z.magnitude(); },
+        [&](const C* src, T* dst) { C::magnitude(src, dst, count); },
+        [](const Reference& z) { return std::abs(z); });
+    measure<T, T>("arg", in,
+        [](const C& z) { return std::arg(S(z.real(), z.imaginary())); },
+        [](const C& z) { return z.argument(); },
+        [&](const C* src, T* dst) { C::argument(src, dst, count); },
+        [](const Reference& z) { return std::arg(z); });
+    measure<T, C>("exp", in,
+        [&](const C& z) { return toC(std::exp(S(z.real(), z.imaginary()))); },
+        [](const C& z) { return z.exp(); },
+        [&](const C* src, C* dst) { C::exp(src, dst, count); },
+        [](const Reference& z) { return std::exp(z); });
+    measure<T, C>("log", in,
+        [&](const C& z) { return toC(std::log(S(z.real(), z.imaginary()))); },
+        [](const C& z) { return z.log(); },
+        [&](const C* src, C* dst) { C::log(src, dst, count); },
+        [](const Reference& z) { return std::log(z); });
+    measure<T, C>("sqrt", in,
+        [&](const C& z) { return toC(std::sqrt(S(z.real(), z.imaginary()))); },
+        [](const C& z) { return z.sqrt(); },
+        [&](const C* src, C* dst) { C::sqrt(src, dst, count); },
+        [](const Reference& z) { return std::sqrt(z); });
+    measure<T, C>("pow(w)", in,
+        [&](const C& z) { return toC(std::pow(S(z.real(), z.imaginary()), S(w.real(), w.imaginary()))); },
+        [&](const C& z) { return z.pow(w); },
+        [&](const C* src, C* dst) { C::pow(src, w, dst, count); },
+        [&](const Reference& z) { return std::pow(z, Reference(w.real(), w.imaginary())); });
+    measure<T, C>("pow(p)", in,
+        [&](const C& z) { return toC(std::pow(S(z.real(), z.imaginary()), p)); },
+        [&](const C& z) { return z.pow(p); },
+        [&](const C* src, C* dst) { C::pow(src, p, dst, count); },
+        [&](const Reference& z) { return std::pow(z, static_cast<long double>(p)); });
+}
+
+int main() {
+    #if defined(MATH_ENABLE_SIMD)
+        std::printf("SIMD\n");
+    #else
+        std::printf("scalar\n");
+    #endif
+
+    run<float>("Complex<float>");
+    run<double>("Complex<double>");
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,138 @@
+// Eager operators against lazy() expressions: a Vec3<float> / Vec4<float> physics update over
+// 4096 elements and a three term Mat4<float> blend over 1024 matrices, in M elements per second.
+// Both sides must produce the same lanes. Build it at a few levels to see where fusing pays:
+//
+//   g++ -std=c++17 -O2 -DNDEBUG -I.. expr.cpp -o expr      (also -O1, -Og)
+//   g++ -std=c++17 -O2 -DNDEBUG -I.. -DMATH_ENABLE_SIMD -mavx2 -mfma expr.cpp -o expr_simd
+
+#include "../expr.hpp"
+#include "../matrix/mat4.hpp"
+#include "../vector/vec3.hpp"
+#include "../vector/vec4.hpp"
+
+#include <algorithm>    // max()
+#include <chrono>       // steady_clock
+#include <cstddef>      // size_t
+#include <cstdio>       // printf()
+#include <cstring>      // memcmp()
+#include <random>       // mt19937, uniform_real_distribution
+#include <vector>       // vector
+
+// best of seven rounds of 200 calls of f() over count elements, in M elements per second
+template <typename F>
+static double rate(const F& f, const std::size_t& count) {
+    using Clock = std::chrono::steady_clock;
+
+    double best = 0;
+    for (int round = 0; round < 7; ++round) {
+        const Clock::time_point start = Clock::now();
+
+        for (int rep = 0; rep < 200; ++rep) {
+            f();
+            asm volatile("" ::: "memory");
+        }
+
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        best = std::max(best, 200.0 * static_cast<double>(count) / seconds / 1e6);
+    }
+
+    return best;
+}
+
+template <typename V>
+__attribute__((noinline)) static void eager(V* pos, V* vel, const V* acc, const std::size_t& count, const float& dt) {
+    const float half = 0.5f * dt * dt;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        pos[i] = pos[i] + vel[i] * dt + acc[i] * half;
+        vel[i] = vel[i] + acc[i] * dt;
+    }
+}
+template <typename V>
+__attribute__((noinline)) static void fused(V* pos, V* vel, const V* acc, const std::size_t& count, const float& dt) {
+    const float half = 0.5f * dt * dt;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        pos[i] = lazy(pos[i]) + lazy(vel[i]) * dt + lazy(acc[i]) * half;
+        vel[i] = lazy(vel[i]) + lazy(acc[i]) * dt;
+    }
+}
+
+__attribute__((noinline)) static void eager(const Mat4<float>* a, const Mat4<float>* b, const Mat4<float>* c, Mat4<float>* out, const std::size_t& count) {
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] = a[i] * 0.25f + b[i] * 0.5f - c[i];
+}
+__attribute__((noinline)) static void fused(const Mat4<float>* a, const Mat4<float>* b, const Mat4<float>* c, Mat4<float>* out, const std::size_t& count) {
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] = lazy(a[i]) * 0.25f + lazy(b[i]) * 0.5f - lazy(c[i]);
+}
+
+template <typename V>
+static void run(const char* name) {
+    const std::size_t count = 4096;
+
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> dist(-1, 1);
+
+    std::vector<V> pos(count), vel(count), acc(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        for (unsigned int k = 0; k < sizeof(V) / sizeof(float); ++k) {
+            pos[i][k] = dist(rng);
+            vel[i][k] = dist(rng);
+            acc[i][k] = dist(rng);
+        }
+    }
+
+    std::vector<V> pos2(pos), vel2(vel);
+    eager(pos.data(), vel.data(), acc.data(), count, 0.01f);
+    fused(pos2.data(), vel2.data(), acc.data(), count, 0.01f);
+
+    const bool same = (std::memcmp(pos.data(), pos2.data(), count * sizeof(V)) == 0) &&
+                      (std::memcmp(vel.data(), vel2.data(), count * sizeof(V)) == 0);
+
+    const double e = rate([&] { eager(pos.data(), vel.data(), acc.data(), count, 0.001f); }, count);
+    const double f = rate([&] { fused(pos2.data(), vel2.data(), acc.data(), count, 0.001f); }, count);
+
+    std::printf("%-14s eager %7.0f   lazy %7.0f   (M/s)   %s\n", name, e, f, same ? "same lanes" : "LANES DIFFER");
+}
+
+static void runMat() {
+    const std::size_t count = 1024;
+
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> dist(-1, 1);
+
+    std::vector<Mat4<float>> a(count), b(count), c(count), out(count), out2(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        for (unsigned int row = 0; row < 4; ++row) {
+            a[i][row] = Vec4<float>{ dist(rng), dist(rng), dist(rng), dist(rng) };
+            b[i][row] = Vec4<float>{ dist(rng), dist(rng), dist(rng), dist(rng) };
+            c[i][row] = Vec4<float>{ dist(rng), dist(rng), dist(rng), dist(rng) };
+        }
+    }
+
+    eager(a.data(), b.data(), c.data(), out.data(), count);
+    fused(a.data(), b.data(), c.data(), out2.data(), count);
+
+    const bool same = (std::memcmp(out.data(), out2.data(), count * sizeof(Mat4<float>)) == 0);
+
+    const double e = rate([&] { eager(a.data(), b.data(), c.data(), out.data(), count); }, count);
+    const double f = rate([&] { fused(a.data(), b.data(), c.data(), out2.data(), count); }, count);
+
+    std::printf("%-14s eager %7.0f   lazy %7.0f   (M/s)   %s\n", "Mat4f blend", e, f, same ? "same lanes" : "LANES DIFFER");
+}
+
+int main() {
+    #if defined(MATH_ENABLE_SIMD)
+        std::printf("SIMD\n");
+    #else
+        std::printf("scalar\n");
+    #endif
+
+    run<Vec3<float>>("Vec3f update");
+    run<Vec4<float>>("Vec4f update");
+    runMat();
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,168 @@
+// Error and speed of the rsqrt-based fast paths: SIMD::rsqrt over a sweep of the normal floats, then
+// fastNormalize / fastLength of Vec2 / Vec3 / Vec4<float> (member and batch form) against normalize() /
+// length(), over 2^20 random directions with lengths 2^-30 .. 2^30. The reference is computed in double.
+// Normalize errors are per lane, relative to the unit length (in units of FLT_EPSILON), length errors
+// relative and in ULP of the correctly rounded length. Then ns per vector over 4096 vectors.
+//
+//   g++ -std=c++17 -O2 -DNDEBUG -I.. fastNormalize.cpp -o fastNormalize [-DMATH_ENABLE_SIMD -mavx2 -mfma]
+
+#include "../vector/vec2.hpp"
+#include "../vector/vec3.hpp"
+#include "../vector/vec4.hpp"
+
+#include <algorithm>    // max(), min()
+#include <chrono>       // steady_clock
+#include <cmath>        // abs(), sqrt(), exp2()
+#include <cstddef>      // size_t
+#include <cstdint>      // int64_t, uint32_t
+#include <cstdio>       // printf()
+#include <cstring>      // memcpy()
+#include <limits>       // numeric_limits
+#include <random>       // mt19937, normal_distribution, uniform_real_distribution
+#include <vector>       // vector
+
+// best of seven rounds of 200 calls of f() over count vectors, in ns per vector
+template <typename F>
+static double cost(const F& f, const std::size_t& count) {
+    using Clock = std::chrono::steady_clock;
+
+    double best = 1e300;
+    for (int round = 0; round < 7; ++round) {
+        const Clock::time_point start = Clock::now();
+
+        for (int rep = 0; rep < 200; ++rep) {
+            f();
+            asm volatile("" ::: "memory");
+        }
+
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        best = std::min(best, seconds * 1e9 / (200.0 * static_cast<double>(count)));
+    }
+
+    return best;
+}
+
+// distance in representable floats between a and the float nearest to exact
+static std::int64_t ulp(const float& a, const double& exact) {
+    const float b = static_cast<float>(exact);
+
+    std::uint32_t x, y;
+    std::memcpy(&x, &a, sizeof(float));
+    std::memcpy(&y, &b, sizeof(float));
+
+    // same sign throughout here, the bit patterns are ordered
+    return (x > y) ? static_cast<std::int64_t>(x - y) : static_cast<std::int64_t>(y - x);
+}
+
+struct Error {
+    double relative = 0;
+    std::int64_t ulps = 0;
+
+    void add(const float& a, const double& exact, const double& scale) {
+        relative = std::max(relative, std::abs(a - exact) / scale);
+        ulps = std::max(ulps, ulp(a, exact));
+    }
+};
+
+static void rsqrt() {
+    Error error;
+
+    // every 4099th bit pattern from FLT_MIN to FLT_MAX
+    for (std::uint32_t bits = 0x0080'0000; bits < 0x7F80'0000; bits += 4099) {
+        float x;
+        std::memcpy(&x, &bits, sizeof(float));
+
+        const double exact = 1 / std::sqrt(static_cast<double>(x));
+        error.add(SIMD::rsqrt(x), exact, exact);
+    }
+
+    std::printf("SIMD::rsqrt    max relative %.2e   max %lld ulp\n", error.relative, static_cast<long long>(error.ulps));
+}
+
+template <unsigned int DIM>
+static void run(const char* name) {
+    using V = Vec<float, DIM>;
+
+    const std::size_t count = 1 << 20;
+
+    std::mt19937 rng(1);
+    std::normal_distribution<float> direction;
+    std::uniform_real_distribution<float> exponent(-30, 30);
+
+    std::vector<V> in(count), fast(count), batch(count), exact(count);
+    std::vector<float> length(count);
+    for (V& v: in) {
+        const float scale = std::exp2(exponent(rng));
+
+        do {
+            for (unsigned int d = 0; d < DIM; ++d)
+                v[d] = direction(rng);
+        } while (v.lengthSquare() < 1e-6f);
+
+        v = v * (scale / v.length());
+    }
+
+    V::fastNormalize(in.data(), batch.data(), count);
+    V::fastLength(in.data(), length.data(), count);
+
+    Error normalizeFast, normalizeBatch, normalizeExact, lengthFast, lengthBatch, lengthExact;
+    for (std::size_t i = 0; i < count; ++i) {
+        double sq = 0;
+        for (unsigned int d = 0; d < DIM; ++d)
+            sq += static_cast<double>(in[i][d]) * static_cast<double>(in[i][d]);
+
+        const double len = std::sqrt(sq);
+        const V f = in[i].fastNormalize();
+        const V e = in[i].normalize();
+
+        for (unsigned int d = 0; d < DIM; ++d) {
+            const double ref = static_cast<double>(in[i][d]) / len;
+
+            // per lane against the unit length, the ULP count of a tiny lane says nothing
+            normalizeFast.add(f[d], ref, 1);
+            normalizeBatch.add(batch[i][d], ref, 1);
+            normalizeExact.add(e[d], ref, 1);
+        }
+
+        lengthFast.add(in[i].fastLength(), len, len);
+        lengthBatch.add(length[i], len, len);
+        lengthExact.add(in[i].length(), len, len);
+    }
+
+    const double eps = std::numeric_limits<float>::epsilon();
+
+    std::printf("%-6s normalize error (eps)   fast %5.2f   batch %5.2f   exact %5.2f\n",
+                name, normalizeFast.relative / eps, normalizeBatch.relative / eps, normalizeExact.relative / eps);
+    std::printf("%-6s length relative / ulp   fast %.2e / %lld   batch %.2e / %lld   exact %.2e / %lld\n",
+                name, lengthFast.relative, static_cast<long long>(lengthFast.ulps), lengthBatch.relative,
+                static_cast<long long>(lengthBatch.ulps), lengthExact.relative, static_cast<long long>(lengthExact.ulps));
+
+    const std::size_t hot = 4096;
+
+    const double normalizeLoop = cost([&] {
+        for (std::size_t i = 0; i < hot; ++i)
+            exact[i] = in[i].normalize();
+    }, hot);
+    const double normalizeFastLoop = cost([&] { V::fastNormalize(in.data(), fast.data(), hot); }, hot);
+    const double lengthFastLoop = cost([&] { V::fastLength(in.data(), length.data(), hot); }, hot);
+
+    std::printf("%-6s ns/vector               normalize() loop %5.2f   fastNormalize batch %5.2f   fastLength batch %5.2f\n",
+                name, normalizeLoop, normalizeFastLoop, lengthFastLoop);
+}
+
+int main() {
+    #if defined(MATH_ENABLE_SIMD)
+        std::printf("SIMD\n");
+    #else
+        std::printf("scalar\n");
+    #endif
+
+    rsqrt();
+
+    run<2>("Vec2f");
+    run<3>("Vec3f");
+    run<4>("Vec4f");
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+// FFT<float> / FFT<double> transforms per second: complex and real, forward + inverse pairs,
+// single-threaded and on every hardware thread.
+//
+//   g++ -std=c++17 -O2 -I.. fft.cpp -o fft -pthread [-DMATH_ENABLE_SIMD -mavx2 -mfma]
+
+#include "../fft.hpp"
+
+#include <algorithm>    // max()
+#include <chrono>       // steady_clock
+#include <cstddef>      // size_t
+#include <cstdio>       // printf()
+#include <random>       // mt19937, uniform_real_distribution
+#include <vector>       // vector
+
+// best of five rounds of f() repeated for about 0.1 s, in calls per second
+template <typename F>
+static double rate(const F& f) {
+    using Clock = std::chrono::steady_clock;
+
+    double best = 0;
+    for (int round = 0; round < 5; ++round) {
+        std::size_t calls = 0;
+        const Clock::time_point start = Clock::now();
+        double seconds = 0;
+
+        do {
+            f();
+            ++calls;
+            seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        } while (seconds < 0.1);
+
+        best = std::max(best, static_cast<double>(calls) / seconds);
+    }
+
+    return best;
+}
+
+template <typename T>
+static void run(const char* name, const std::size_t& n) {
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<T> dist(-1, 1);
+
+    std::vector<Complex<T>> x(n), spectrum(n);
+    std::vector<T> real(n), back(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        x[i] = Complex<T>(dist(rng), dist(rng));
+        real[i] = dist(rng);
+    }
+
+    const FFT<T>& plan = FFT<T>::plan(n);
+
+    const double complex1 = rate([&] { plan.forward(x.data(), spectrum.data(), 1); plan.inverse(spectrum.data(), spectrum.data(), 1); });
+    const double complexN = rate([&] { plan.forward(x.data(), spectrum.data(), 0); plan.inverse(spectrum.data(), spectrum.data(), 0); });
+    const double real1    = rate([&] { plan.forward(real.data(), spectrum.data(), 1); plan.inverse(spectrum.data(), back.data(), 1); });
+
+    std::printf("%-6s n %8zu   complex pairs/s %10.0f (1 thread) %10.0f (all)   real pairs/s %10.0f\n", name, n, complex1, complexN, real1);
+}
+
+int main() {
+    for (const std::size_t n: { 64, 1024, 4096, 1000, 1031, 65536, 1 << 20 }) {
+        run<float>("float", n);
+        run<double>("double", n);
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,203 @@
+// Mat4<float> / Mat4<double> products per second over 1024 matrices, and how many of the result
+// entries differ in any bit from the old triple loop (sum += a[row][k] * b[k][col], not contracted).
+// Then inversions per second (tryInverse) against Gauss-Jordan with partial pivoting over the same
+// matrices, with the largest |m * inverse(m) - I| entry of each. Build it against an older checkout
+// to compare inverse times across commits. Three builds: the scalar path, SIMD without FMA and with FMA:
+//
+//   g++ -std=c++17 -O2 -DNDEBUG -I.. mat4.cpp -o mat4
+//   g++ -std=c++17 -O2 -DNDEBUG -I.. -DMATH_ENABLE_SIMD -mavx2 -mno-fma mat4.cpp -o mat4_simd
+//   g++ -std=c++17 -O2 -DNDEBUG -I.. -DMATH_ENABLE_SIMD -mavx2 -mfma mat4.cpp -o mat4_fma
+
+#include "../matrix/mat4.hpp"
+
+#include <algorithm>    // max()
+#include <chrono>       // steady_clock
+#include <cmath>        // abs()
+#include <cstddef>      // size_t
+#include <cstdio>       // printf()
+#include <cstring>      // memcmp()
+#include <random>       // mt19937, uniform_real_distribution
+#include <utility>      // swap()
+#include <vector>       // vector
+
+// best of seven rounds of 200 calls of f() over count matrices, in M per second
+template <typename F>
+static double rate(const F& f, const std::size_t& count) {
+    using Clock = std::chrono::steady_clock;
+
+    double best = 0;
+    for (int round = 0; round < 7; ++round) {
+        const Clock::time_point start = Clock::now();
+
+        for (int rep = 0; rep < 200; ++rep) {
+            f();
+            asm volatile("" ::: "memory");
+        }
+
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        best = std::max(best, 200.0 * static_cast<double>(count) / seconds / 1e6);
+    }
+
+    return best;
+}
+
+// inverse by Gauss-Jordan elimination with partial pivoting on [m | I], false if a pivot is zero
+template <typename T>
+static bool gaussJordan(const Mat4<T>& m, Mat4<T>& out) {
+    T a[4][8];
+    for (unsigned int row = 0; row < 4; ++row) {
+        for (unsigned int col = 0; col < 4; ++col) {
+            a[row][col] = m[row][col];
+            a[row][col + 4] = static_cast<T>(row == col);
+        }
+    }
+
+    for (unsigned int k = 0; k < 4; ++k) {
+        unsigned int pivot = k;
+        for (unsigned int row = k + 1; row < 4; ++row) {
+            if (std::abs(a[row][k]) > std::abs(a[pivot][k]))
+                pivot = row;
+        }
+
+        if (a[pivot][k] == 0)
+            return false;
+
+        for (unsigned int col = 0; col < 8; ++col)
+            std::swap(a[k][col], a[pivot][col]);
+
+        const T scale = 1 / a[k][k];
+        for (unsigned int col = 0; col < 8; ++col)
+            a[k][col] *= scale;
+
+        for (unsigned int row = 0; row < 4; ++row) {
+            if (row == k)
+                continue;
+
+            const T f = a[row][k];
+            for (unsigned int col = 0; col < 8; ++col)
+                a[row][col] -= f * a[k][col];
+        }
+    }
+
+    for (unsigned int row = 0; row < 4; ++row) {
+        for (unsigned int col = 0; col < 4; ++col)
+            out[row][col] = a[row][col + 4];
+    }
+
+    return true;
+}
+
+// largest |m * inverse - I| entry
+template <typename T>
+static double residual(const Mat4<T>& m, const Mat4<T>& inverse) {
+    double worst = 0;
+    for (unsigned int row = 0; row < 4; ++row) {
+        for (unsigned int col = 0; col < 4; ++col) {
+            double sum = -static_cast<double>(row == col);
+            for (unsigned int k = 0; k < 4; ++k)
+                sum += static_cast<double>(m[row][k]) * static_cast<double>(inverse[k][col]);
+
+            worst = std::max(worst, std::abs(sum));
+        }
+    }
+
+    return worst;
+}
+
+// the product as it was computed before the row kernels, one rounding per multiply and add
+// (GCC contracts a * b + c into an FMA by default when -mfma is on)
+template <typename T>
+__attribute__((optimize("fp-contract=off"))) static Mat4<T> reference(const Mat4<T>& a, const Mat4<T>& b) {
+    Mat4<T> result;
+
+    for (unsigned int row = 0; row < 4; ++row) {
+        for (unsigned int col = 0; col < 4; ++col) {
+            T sum{ };
+            for (unsigned int k = 0; k < 4; ++k)
+                sum += static_cast<T>(a[row][k] * b[k][col]);
+
+            result[row][col] = sum;
+        }
+    }
+
+    return result;
+}
+
+template <typename T>
+static void run(const char* name) {
+    const std::size_t count = 1024;
+
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<T> dist(-1, 1);
+
+    std::vector<Mat4<T>> m(count + 1), out(count);
+    for (Mat4<T>& x: m) {
+        for (unsigned int row = 0; row < 4; ++row)
+            x[row] = Vec4<T>{ dist(rng), dist(rng), dist(rng), dist(rng) };
+    }
+
+    // a row of -0 against a positive column: every product is -0, the old loop summed from +0
+    m[0][0] = Vec4<T>{ -static_cast<T>(0), -static_cast<T>(0), -static_cast<T>(0), -static_cast<T>(0) };
+    for (unsigned int k = 0; k < 4; ++k)
+        m[1][k].x = static_cast<T>(1);
+
+    std::size_t differ = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const Mat4<T> fast = m[i] * m[i + 1];
+        const Mat4<T> slow = reference(m[i], m[i + 1]);
+
+        for (unsigned int row = 0; row < 4; ++row) {
+            for (unsigned int col = 0; col < 4; ++col)
+                differ += (std::memcmp(&fast[row][col], &slow[row][col], sizeof(T)) != 0);
+        }
+    }
+
+    const double products = rate([&] {
+        for (std::size_t i = 0; i < count; ++i)
+            out[i] = m[i] * m[i + 1];
+    }, count);
+
+    std::printf("%-6s  %7.1f M products/s   %zu of %zu entries differ from the old loop\n", name, products, differ, 16 * count);
+
+    std::size_t singular = 0;
+    double error = 0, errorGJ = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        Mat4<T> inverse, inverseGJ;
+
+        if (!m[i].tryInverse(inverse) || !gaussJordan(m[i], inverseGJ)) {
+            ++singular;
+            continue;
+        }
+
+        error = std::max(error, residual(m[i], inverse));
+        errorGJ = std::max(errorGJ, residual(m[i], inverseGJ));
+    }
+
+    const double inverses = rate([&] {
+        for (std::size_t i = 0; i < count; ++i)
+            m[i].tryInverse(out[i]);
+    }, count);
+    const double inversesGJ = rate([&] {
+        for (std::size_t i = 0; i < count; ++i)
+            gaussJordan(m[i], out[i]);
+    }, count);
+
+    std::printf("%-6s  %7.1f M inverses/s (%5.1f ns, error %.1e)   Gauss-Jordan %5.1f M/s (%5.1f ns, error %.1e)   %zu singular\n",
+                name, inverses, 1e3 / inverses, error, inversesGJ, 1e3 / inversesGJ, errorGJ, singular);
+}
+
+int main() {
+    #if defined(MATH_SIMD_FMA)
+        std::printf("SIMD + FMA\n");
+    #elif defined(MATH_ENABLE_SIMD)
+        std::printf("SIMD\n");
+    #else
+        std::printf("scalar\n");
+    #endif
+
+    run<float>("float");
+    run<double>("double");
+
+    return 0;
+}
\ No newline at end of file
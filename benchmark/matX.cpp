@@ -0,0 +1,121 @@
+// MatX<float> / MatX<double> products in GFLOP/s for n x n operands, single-threaded and on every
+// hardware thread, against the naive triple loop up to n = 1000. Every product is first checked
+// against the naive loop on an odd 517 x 389 x 263 shape, and the threaded result against the
+// single-threaded one (the split never changes the order of a sum, so they must match exactly).
+//
+//   g++ -std=c++17 -O2 -DNDEBUG -I.. matX.cpp -o matX -pthread [-DMATH_ENABLE_SIMD -mavx2 -mfma]
+
+#include "../matrix/matX.hpp"
+
+#include <algorithm>    // max(), min()
+#include <chrono>       // steady_clock
+#include <cmath>        // abs()
+#include <cstddef>      // size_t
+#include <cstdio>       // printf()
+#include <cstring>      // memcmp()
+#include <random>       // mt19937, uniform_real_distribution
+#include <utility>      // move()
+
+// best of `rounds` calls of f(), in seconds
+template <typename F>
+static double best(const F& f, const int& rounds) {
+    using Clock = std::chrono::steady_clock;
+
+    double seconds = 1e300;
+    for (int round = 0; round < rounds; ++round) {
+        const Clock::time_point start = Clock::now();
+        f();
+        seconds = std::min(seconds, std::chrono::duration<double>(Clock::now() - start).count());
+    }
+
+    return seconds;
+}
+
+template <typename T>
+static MatX<T> naive(const MatX<T>& a, const MatX<T>& b) {
+    MatX<T> result(a.rows(), b.cols());
+
+    for (std::size_t row = 0; row < a.rows(); ++row) {
+        for (std::size_t col = 0; col < b.cols(); ++col) {
+            T sum{ };
+            for (std::size_t k = 0; k < a.cols(); ++k)
+                sum += a[row][k] * b[k][col];
+
+            result[row][col] = sum;
+        }
+    }
+
+    return result;
+}
+
+template <typename T>
+static MatX<T> random(const std::size_t& rows, const std::size_t& cols, std::mt19937& rng) {
+    std::uniform_real_distribution<T> dist(-1, 1);
+
+    MatX<T> m(rows, cols);
+    for (std::size_t i = 0; i < rows * cols; ++i)
+        m.data()[i] = dist(rng);
+
+    return m;
+}
+
+template <typename T>
+static void check(const char* name, std::mt19937& rng) {
+    const MatX<T> a = random<T>(517, 389, rng);
+    const MatX<T> b = random<T>(389, 263, rng);
+    const MatX<T> slow = naive(a, b);
+
+    MatX<T> one, all;
+    MatX<T>::multiply(a, b, one, 1);
+    MatX<T>::multiply(a, b, all, 3);
+
+    double error = 0;
+    for (std::size_t i = 0; i < slow.rows() * slow.cols(); ++i)
+        error = std::max(error, static_cast<double>(std::abs(one.data()[i] - slow.data()[i])));
+
+    const bool same = (std::memcmp(one.data(), all.data(), one.rows() * one.cols() * sizeof(T)) == 0);
+
+    std::printf("%-6s  517 x 389 x 263   max error %.2g against the naive loop   3 threads %s\n", name, error, same ? "same lanes" : "LANES DIFFER");
+}
+
+template <typename T>
+static void run(const char* name) {
+    std::mt19937 rng(1);
+
+    check<T>(name, rng);
+
+    for (const std::size_t n: { 500, 1000, 2000 }) {
+        const MatX<T> a = random<T>(n, n, rng);
+        const MatX<T> b = random<T>(n, n, rng);
+        MatX<T> out;
+
+        const double flops = 2.0 * static_cast<double>(n) * static_cast<double>(n) * static_cast<double>(n) / 1e9;
+        const int rounds = (n <= 1000) ? 5 : 2;
+
+        const double one = best([&] { MatX<T>::multiply(a, b, out, 1); }, rounds);
+        const double all = best([&] { MatX<T>::multiply(a, b, out, 0); }, rounds);
+
+        std::printf("%-6s  n %5zu   %7.2f GFLOP/s (1 thread) %7.2f (all)", name, n, flops / one, flops / all);
+
+        if (n <= 1000) {
+            const double slow = best([&] { out = naive(a, b); }, 1);
+
+            std::printf("   naive %6.2f", flops / slow);
+        }
+
+        std::printf("\n");
+    }
+}
+
+int main() {
+    #if defined(MATH_ENABLE_SIMD)
+        std::printf("SIMD\n");
+    #else
+        std::printf("scalar\n");
+    #endif
+
+    run<float>("float");
+    run<double>("double");
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,182 @@
+// Batched Mat3 / Mat4 solve (LU) and solveCholesky, float and double, in M systems per second over
+// 2^20 random systems, against a per-system partial-pivot LU loop. One system in 1000 is planted
+// singular (a zero row, LU) or indefinite (a negative diagonal entry, Cholesky); the count the solvers
+// report must equal the planted one. Next to it the largest backward error of the systems that solved,
+// max |a x - b| / (max |a| max |x| + max |b|).
+//
+//   g++ -std=c++17 -O2 -DNDEBUG -I.. solve.cpp -o solve      [-DMATH_ENABLE_SIMD -mavx2 -mfma]
+
+#include "../matrix/mat.hpp"
+
+#include <algorithm>    // max()
+#include <chrono>       // steady_clock
+#include <cmath>        // abs()
+#include <cstddef>      // size_t
+#include <cstdio>       // printf()
+#include <random>       // mt19937, uniform_real_distribution
+#include <utility>      // swap()
+#include <vector>       // vector
+
+// best of three calls of f() over count systems, in M systems per second
+template <typename F>
+static double rate(const F& f, const std::size_t& count) {
+    using Clock = std::chrono::steady_clock;
+
+    double best = 0;
+    for (int round = 0; round < 3; ++round) {
+        const Clock::time_point start = Clock::now();
+        f();
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        best = std::max(best, static_cast<double>(count) / seconds / 1e6);
+    }
+
+    return best;
+}
+
+// one system at a time, partial pivoting, x = 0 if a pivot is zero
+template <unsigned int N, typename M, typename V>
+__attribute__((noinline)) static std::size_t reference(const M* a, const V* b, V* x, const std::size_t& count) {
+    using T = decltype(+b[0][0]);
+
+    std::size_t singular = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        T m[N][N + 1];
+        for (unsigned int row = 0; row < N; ++row) {
+            for (unsigned int col = 0; col < N; ++col)
+                m[row][col] = a[i][row][col];
+
+            m[row][N] = b[i][row];
+        }
+
+        bool bad = false;
+        for (unsigned int k = 0; k < N && !bad; ++k) {
+            unsigned int pivot = k;
+            for (unsigned int row = k + 1; row < N; ++row) {
+                if (std::abs(m[row][k]) > std::abs(m[pivot][k]))
+                    pivot = row;
+            }
+
+            if (m[pivot][k] == 0) {
+                bad = true;
+                break;
+            }
+
+            for (unsigned int col = k; col <= N; ++col)
+                std::swap(m[k][col], m[pivot][col]);
+
+            for (unsigned int row = k + 1; row < N; ++row) {
+                const T f = m[row][k] / m[k][k];
+                for (unsigned int col = k; col <= N; ++col)
+                    m[row][col] -= f * m[k][col];
+            }
+        }
+
+        singular += bad;
+        for (unsigned int row = N; row-- > 0;) {
+            T sum = m[row][N];
+            for (unsigned int col = row + 1; col < N; ++col)
+                sum -= m[row][col] * x[i][col];
+
+            x[i][row] = bad ? static_cast<T>(0) : sum / m[row][row];
+        }
+    }
+
+    return singular;
+}
+
+// largest backward error over the systems whose x is not zero
+template <unsigned int N, typename M, typename V>
+static double residual(const std::vector<M>& a, const std::vector<V>& b, const std::vector<V>& x) {
+    double worst = 0;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        double maxA = 0, maxB = 0, maxX = 0, maxR = 0;
+
+        for (unsigned int row = 0; row < N; ++row) {
+            double sum = -static_cast<double>(b[i][row]);
+            for (unsigned int col = 0; col < N; ++col) {
+                sum += static_cast<double>(a[i][row][col]) * static_cast<double>(x[i][col]);
+                maxA = std::max(maxA, std::abs(static_cast<double>(a[i][row][col])));
+            }
+
+            maxB = std::max(maxB, std::abs(static_cast<double>(b[i][row])));
+            maxX = std::max(maxX, std::abs(static_cast<double>(x[i][row])));
+            maxR = std::max(maxR, std::abs(sum));
+        }
+
+        if (maxX > 0)
+            worst = std::max(worst, maxR / (maxA * maxX + maxB));
+    }
+
+    return worst;
+}
+
+template <typename T, unsigned int N>
+static void run(const char* name) {
+    using M = Mat<T, N, N>;
+    using V = Vec<T, N>;
+
+    const std::size_t count = 1 << 20;
+
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<T> dist(-1, 1);
+
+    // general systems, and symmetric positive definite ones (g g^T + I)
+    std::vector<M> general(count), spd(count);
+    std::vector<V> b(count), x(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        M g;
+        for (unsigned int row = 0; row < N; ++row) {
+            for (unsigned int col = 0; col < N; ++col) {
+                general[i][row][col] = dist(rng);
+                g[row][col] = dist(rng);
+            }
+
+            b[i][row] = dist(rng);
+        }
+
+        for (unsigned int row = 0; row < N; ++row) {
+            for (unsigned int col = 0; col < N; ++col) {
+                T sum = static_cast<T>(row == col);
+                for (unsigned int k = 0; k < N; ++k)
+                    sum += g[row][k] * g[col][k];
+
+                spd[i][row][col] = sum;
+            }
+        }
+
+        if (i % 1000 == 999) {
+            general[i][N - 1] = V{ };
+            spd[i][0][0] = -spd[i][0][0];
+        }
+    }
+
+    const std::size_t planted = count / 1000;
+
+    const std::size_t singularLU = M::solve(general.data(), b.data(), x.data(), count);
+    const double errorLU = residual<N>(general, b, x);
+    const std::size_t singularCholesky = M::solveCholesky(spd.data(), b.data(), x.data(), count);
+    const double errorCholesky = residual<N>(spd, b, x);
+
+    const double lu = rate([&] { M::solve(general.data(), b.data(), x.data(), count); }, count);
+    const double cholesky = rate([&] { M::solveCholesky(spd.data(), b.data(), x.data(), count); }, count);
+    const double loop = rate([&] { reference<N>(general.data(), b.data(), x.data(), count); }, count);
+
+    std::printf("%-13s  LU %6.1f   Cholesky %6.1f   per-system LU %6.1f   (M/s)   reported %zu / %zu of %zu   backward error %.1e / %.1e\n",
+                name, lu, cholesky, loop, singularLU, singularCholesky, planted, errorLU, errorCholesky);
+}
+
+int main() {
+    #if defined(MATH_ENABLE_SIMD)
+        std::printf("SIMD\n");
+    #else
+        std::printf("scalar\n");
+    #endif
+
+    run<float, 3>("Mat3<float>");
+    run<float, 4>("Mat4<float>");
+    run<double, 3>("Mat3<double>");
+    run<double, 4>("Mat4<double>");
+
+    return 0;
+}
\ No newline at end of file
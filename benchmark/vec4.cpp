@@ -0,0 +1,78 @@
+// Vec4<float> / Vec4<double> arithmetic and normalize over 4096-element arrays, in M vectors per second.
+// Build it twice to compare the scalar path with the SIMD one:
+//
+//   g++ -std=c++17 -O2 -DNDEBUG -I.. vec4.cpp -o vec4
+//   g++ -std=c++17 -O2 -DNDEBUG -I.. -DMATH_ENABLE_SIMD -mavx2 -mfma vec4.cpp -o vec4_simd
+
+#include "../vector/vec4.hpp"
+
+#include <algorithm>    // max()
+#include <chrono>       // steady_clock
+#include <cstddef>      // size_t
+#include <cstdio>       // printf()
+#include <random>       // mt19937, uniform_real_distribution
+#include <vector>       // vector
+
+// best of seven rounds of 200 calls of f() over count elements, in M elements per second
+template <typename F>
+static double rate(const F& f, const std::size_t& count) {
+    using Clock = std::chrono::steady_clock;
+
+    double best = 0;
+    for (int round = 0; round < 7; ++round) {
+        const Clock::time_point start = Clock::now();
+
+        for (int rep = 0; rep < 200; ++rep) {
+            f();
+            asm volatile("" ::: "memory");
+        }
+
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        best = std::max(best, 200.0 * static_cast<double>(count) / seconds / 1e6);
+    }
+
+    return best;
+}
+
+template <typename T>
+static void run(const char* name) {
+    const std::size_t count = 4096;
+
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<T> dist(-1, 1);
+
+    std::vector<Vec4<T>> a(count), b(count), out(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        a[i] = Vec4<T>{ dist(rng), dist(rng), dist(rng), dist(rng) };
+        b[i] = Vec4<T>{ dist(rng), dist(rng), dist(rng), dist(rng) } + static_cast<T>(2);
+    }
+
+    const double axpy = rate([&] {
+        for (std::size_t i = 0; i < count; ++i)
+            out[i] = a[i] * static_cast<T>(2) + b[i];
+    }, count);
+    const double normalize = rate([&] {
+        for (std::size_t i = 0; i < count; ++i)
+            out[i] = (a[i] * static_cast<T>(2) + b[i]).normalize();
+    }, count);
+    const double dot = rate([&] {
+        for (std::size_t i = 0; i < count; ++i)
+            out[i].x = a[i].dot(b[i]);
+    }, count);
+
+    std::printf("%-6s  a * 2 + b %7.0f   normalize %7.0f   dot %7.0f   (M/s)\n", name, axpy, normalize, dot);
+}
+
+int main() {
+    #if defined(MATH_ENABLE_SIMD)
+        std::printf("SIMD\n");
+    #else
+        std::printf("scalar\n");
+    #endif
+
+    run<float>("float");
+    run<double>("double");
+
+    return 0;
+}
\ No newline at end of file
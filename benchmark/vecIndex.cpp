@@ -0,0 +1,130 @@
+// VecIndex<float, 128> queries per second over 200k vectors in 256 gaussian clusters, 200 queries
+// at k = 10: FULL against INT8 at rerank 1, 4 and 8, with the recall@10 of INT8 against FULL.
+// FULL is first checked against a naive brute force over the same vectors.
+//
+//   g++ -std=c++17 -O2 -DNDEBUG -I.. vecIndex.cpp -o vecIndex -pthread [-DMATH_ENABLE_SIMD -mavx2 -mfma]
+
+#include "../vector/vecIndex.hpp"
+
+#include <algorithm>    // max(), partial_sort()
+#include <chrono>       // steady_clock
+#include <cmath>        // sqrt()
+#include <cstddef>      // size_t
+#include <cstdio>       // printf()
+#include <random>       // mt19937, normal_distribution
+#include <utility>      // pair
+#include <vector>       // vector
+
+constexpr unsigned int DIM = 128;
+
+using Index = VecIndex<float, DIM>;
+
+// best of three rounds of f() answering count queries, in queries per second
+template <typename F>
+static double rate(const F& f, const std::size_t& count) {
+    using Clock = std::chrono::steady_clock;
+
+    double best = 0;
+    for (int round = 0; round < 3; ++round) {
+        const Clock::time_point start = Clock::now();
+        f();
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        best = std::max(best, static_cast<double>(count) / seconds);
+    }
+
+    return best;
+}
+
+// how many of the k hits of every query in a are also among its k hits in b
+static double recall(const std::vector<Index::Hit>& a, const std::vector<Index::Hit>& b, const std::size_t& queries, const std::size_t& k) {
+    std::size_t found = 0;
+    for (std::size_t q = 0; q < queries; ++q) {
+        for (std::size_t i = 0; i < k; ++i) {
+            for (std::size_t j = 0; j < k; ++j)
+                found += (a[q * k + i].index == b[q * k + j].index);
+        }
+    }
+
+    return static_cast<double>(found) / static_cast<double>(queries * k);
+}
+
+// hits of FULL for query that are also among the best k of a naive scan (lower key is better)
+static std::size_t brute(const std::vector<Vec<float, DIM>>& data, const Vec<float, DIM>& query, const Index::Metric& metric, const Index::Hit* hits, const std::size_t& k) {
+    std::vector<std::pair<double, std::size_t>> all(data.size());
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        double dot = 0, qq = 0, xx = 0;
+        for (unsigned int d = 0; d < DIM; ++d) {
+            dot += static_cast<double>(query[d]) * data[i][d];
+            qq += static_cast<double>(query[d]) * query[d];
+            xx += static_cast<double>(data[i][d]) * data[i][d];
+        }
+
+        all[i] = { (metric == Index::Metric::COSINE) ? -dot / std::sqrt(qq * xx) : qq + xx - 2 * dot, i };
+    }
+
+    std::partial_sort(all.begin(), all.begin() + k, all.end());
+
+    std::size_t found = 0;
+    for (std::size_t i = 0; i < k; ++i) {
+        for (std::size_t j = 0; j < k; ++j)
+            found += (hits[i].index == all[j].second);
+    }
+
+    return found;
+}
+
+static void run(const char* name, const Index::Metric& metric, const std::vector<Vec<float, DIM>>& data, const std::vector<Vec<float, DIM>>& queries) {
+    const std::size_t k = 10;
+    const std::size_t count = queries.size();
+
+    Index full(metric);
+    full.add(data.data(), data.size());
+
+    std::vector<Index::Hit> expected(count * k), hits(count * k);
+
+    const double fullRate = rate([&] { full.search(queries.data(), count, k, expected.data()); }, count);
+    const std::size_t exact = brute(data, queries[0], metric, expected.data(), k);
+
+    std::printf("%-6s  FULL %6.0f QPS (%zu of %zu match brute force)", name, fullRate, exact, k);
+
+    for (const unsigned int rerank: { 1u, 4u, 8u }) {
+        Index int8(metric, Index::Storage::INT8, rerank);
+        int8.add(data.data(), data.size());
+
+        const double int8Rate = rate([&] { int8.search(queries.data(), count, k, hits.data()); }, count);
+
+        std::printf("   INT8 r%u %6.0f / %.3f", rerank, int8Rate, recall(expected, hits, count, k));
+    }
+
+    std::printf("   (QPS / recall@10)\n");
+}
+
+int main() {
+    #if defined(MATH_ENABLE_SIMD)
+        std::printf("SIMD\n");
+    #else
+        std::printf("scalar\n");
+    #endif
+
+    std::mt19937 rng(1);
+    std::normal_distribution<float> dist;
+
+    std::vector<Vec<float, DIM>> centers(256), data(200'000), queries(200);
+    for (Vec<float, DIM>& c: centers) {
+        for (unsigned int d = 0; d < DIM; ++d)
+            c[d] = dist(rng);
+    }
+    for (std::vector<Vec<float, DIM>>* points: { &data, &queries }) {
+        for (Vec<float, DIM>& x: *points) {
+            const Vec<float, DIM>& c = centers[rng() % centers.size()];
+            for (unsigned int d = 0; d < DIM; ++d)
+                x[d] = c[d] + 0.5f * dist(rng);
+        }
+    }
+
+    run("cosine", Index::Metric::COSINE, data, queries);
+    run("L2", Index::Metric::L2, data, queries);
+
+    return 0;
+}
\ No newline at end of file
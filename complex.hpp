@@ -4,17 +4,21 @@
 #include "./typeHandler.hpp"
 #include "./math.hpp"
 
+#include <cmath>        // sqrt(), copysign()
+#include <cstddef>      // size_t
+#include <limits>       // numeric_limits
+
 template <typename T>
 class Complex {
     public:
-        Complex();
-        Complex(Complex<T>&& other) noexcept;
-        Complex(const Complex<T>& other);
+        Complex() = default;
+        Complex(Complex<T>&& other) noexcept = default;
+        Complex(const Complex<T>& other) = default;
         Complex(const T& real, const T& imaginary);
-        ~Complex() noexcept;
+        ~Complex() noexcept = default;
 
-        Complex<T>& operator=(const Complex<T>& other);
-        Complex<T>& operator=(Complex<T>&& other) noexcept;
+        Complex<T>& operator=(const Complex<T>& other) = default;
+        Complex<T>& operator=(Complex<T>&& other) noexcept = default;
 
         // comparing operators here
         // support floating-point types
@@ -32,39 +36,59 @@ class Complex {
         // add type restriction? (T must be signed)
         Complex<T> conjugate() const noexcept;
 
+        // Polar form and elementary functions (float / double) on the principal branch, the cut along
+        // the negative real axis. Built on the Math kernels: no std::complex, no libm per element
+        inline T magnitude() const noexcept;
+        inline T magnitudeSquare() const noexcept;
+        // in [-pi, pi]
+        inline T argument() const noexcept;
+        static Complex<T> polar(const T& magnitude, const T& argument) noexcept;
+
+        Complex<T> exp() const noexcept;
+        Complex<T> log() const noexcept;
+        Complex<T> sqrt() const noexcept;
+        // exp(w log(z)), 0 for z = 0
+        Complex<T> pow(const Complex<T>& w) const noexcept;
+        Complex<T> pow(const T& p) const noexcept;
+
+        // count values: BLOCK at a time split into real / imaginary planes on the stack, through the
+        // Math array kernels (float: four per SSE register), then interleaved back. Without those
+        // kernels (double) the planes only cost, each value runs the scalar form. out may be in
+        static void magnitude(const Complex<T>* in, T* out, const std::size_t& count) noexcept;
+        static void argument(const Complex<T>* in, T* out, const std::size_t& count) noexcept;
+        static void polar(const T* magnitude, const T* argument, Complex<T>* out, const std::size_t& count) noexcept;
+
+        static void exp(const Complex<T>* in, Complex<T>* out, const std::size_t& count) noexcept;
+        static void log(const Complex<T>* in, Complex<T>* out, const std::size_t& count) noexcept;
+        static void sqrt(const Complex<T>* in, Complex<T>* out, const std::size_t& count) noexcept;
+        static void pow(const Complex<T>* in, const Complex<T>& w, Complex<T>* out, const std::size_t& count) noexcept;
+        static void pow(const Complex<T>* in, const T& p, Complex<T>* out, const std::size_t& count) noexcept;
+
         void real(const T& real) noexcept;
         void imaginary(const T& imaginary) noexcept;
 
         inline T real() const noexcept;
         inline T imaginary() const noexcept;
 
+    private:
+        inline static constexpr std::size_t BLOCK = 256;
+        inline static constexpr bool PLANES = isSame<T, float> && SIMD::SSE;
+
+        // the planes of a block and back
+        static void split(const Complex<T>* in, T* re, T* im, const std::size_t& count) noexcept;
+        static void merge(const T* re, const T* im, Complex<T>* out, const std::size_t& count) noexcept;
+
+        // on planes of count <= BLOCK values, outputs may be inputs
+        static void expPlanes(const T* re, const T* im, T* outR, T* outI, const std::size_t& count) noexcept;
+        static void logPlanes(const T* re, const T* im, T* outR, T* outI, const std::size_t& count) noexcept;
+
     private:
         T mReal{ };
         T mImaginary{ };
 };
 
-template <typename T> Complex<T>::Complex() { }
 template <typename T> Complex<T>::Complex(const T& real, const T& imaginary)
     : mReal{real}, mImaginary{imaginary} { }
-template <typename T> Complex<T>::Complex(const Complex<T>& other) { *this = other; }
-template <typename T> Complex<T>::Complex(Complex<T>&& other) noexcept { *this = move(other); }
-template <typename T> Complex<T>::~Complex() noexcept { }
-
-template <typename T> Complex<T>& Complex<T>::operator=(const Complex<T>& other) {
-    mReal      = other.mReal;
-    mImaginary = other.mImaginary;
-
-    return *this;
-}
-template <typename T> Complex<T>& Complex<T>::operator=(Complex<T>&& other) noexcept {
-    mReal      = other.mReal;
-    mImaginary = other.mImaginary;
-
-    other.mReal      = { };
-    other.mImaginary = { };
-
-    return *this;
-}
 
 template <typename T> template <typename U>
 Complex<T>& Complex<T>::operator+=(const Complex<U>& other) noexcept { return (*this = (*this + other)); }
@@ -110,8 +134,298 @@ Complex<T> Complex<T>::operator/(const Complex<U>& other) const noexcept {
 
 template <typename T> Complex<T> Complex<T>::conjugate() const noexcept { return Complex<T>(mReal, -mImaginary); }
 
+template <typename T> inline T Complex<T>::magnitude() const noexcept { return Math::hypot(mReal, mImaginary); }
+template <typename T> inline T Complex<T>::magnitudeSquare() const noexcept { return mReal * mReal + mImaginary * mImaginary; }
+template <typename T> inline T Complex<T>::argument() const noexcept { return Math::atan2(mImaginary, mReal); }
+
+template <typename T>
+Complex<T> Complex<T>::polar(const T& magnitude, const T& argument) noexcept {
+    T s, c;
+    Math::sincos(argument, s, c);
+
+    return {magnitude * c, magnitude * s};
+}
+
+template <typename T>
+Complex<T> Complex<T>::exp() const noexcept { return polar(Math::exp(mReal), mImaginary); }
+template <typename T>
+Complex<T> Complex<T>::log() const noexcept { return {Math::log(magnitude()), argument()}; }
+template <typename T>
+Complex<T> Complex<T>::sqrt() const noexcept {
+    // t = sqrt((|z| + |re|) / 2), the other part im / 2t, no cancellation on either side of the cut
+    const T t = std::sqrt((magnitude() + Math::abs(mReal)) / 2);
+
+    if (t == 0)
+        return {T(0), mImaginary};
+
+    if (mReal >= 0)
+        return {t, mImaginary / (2 * t)};
+
+    return {Math::abs(mImaginary) / (2 * t), std::copysign(t, mImaginary)};
+}
+template <typename T>
+Complex<T> Complex<T>::pow(const Complex<T>& w) const noexcept {
+    if (mReal == 0 && mImaginary == 0)
+        return { };
+
+    return (w * log()).exp();
+}
+template <typename T>
+Complex<T> Complex<T>::pow(const T& p) const noexcept {
+    if (mReal == 0 && mImaginary == 0)
+        return { };
+
+    return polar(Math::exp(p * Math::log(magnitude())), p * argument());
+}
+
+template <typename T>
+void Complex<T>::magnitude(const Complex<T>* in, T* out, const std::size_t& count) noexcept {
+    if constexpr (!PLANES) {
+        for (std::size_t i = 0; i < count; ++i)
+            out[i] = in[i].magnitude();
+
+        return;
+    }
+
+    T re[BLOCK], im[BLOCK];
+
+    for (std::size_t i = 0; i < count; i += BLOCK) {
+        const std::size_t n = (count - i < BLOCK) ? count - i : BLOCK;
+
+        split(in + i, re, im, n);
+        Math::hypot(re, im, out + i, n);
+    }
+}
+template <typename T>
+void Complex<T>::argument(const Complex<T>* in, T* out, const std::size_t& count) noexcept {
+    if constexpr (!PLANES) {
+        for (std::size_t i = 0; i < count; ++i)
+            out[i] = in[i].argument();
+
+        return;
+    }
+
+    T re[BLOCK], im[BLOCK];
+
+    for (std::size_t i = 0; i < count; i += BLOCK) {
+        const std::size_t n = (count - i < BLOCK) ? count - i : BLOCK;
+
+        split(in + i, re, im, n);
+        Math::atan2(im, re, out + i, n);
+    }
+}
+template <typename T>
+void Complex<T>::polar(const T* magnitude, const T* argument, Complex<T>* out, const std::size_t& count) noexcept {
+    if constexpr (!PLANES) {
+        for (std::size_t i = 0; i < count; ++i)
+            out[i] = polar(magnitude[i], argument[i]);
+
+        return;
+    }
+
+    T s[BLOCK], c[BLOCK];
+
+    for (std::size_t i = 0; i < count; i += BLOCK) {
+        const std::size_t n = (count - i < BLOCK) ? count - i : BLOCK;
+
+        Math::sincos(argument + i, s, c, n);
+
+        for (std::size_t j = 0; j < n; ++j) {
+            c[j] *= magnitude[i + j];
+            s[j] *= magnitude[i + j];
+        }
+
+        merge(c, s, out + i, n);
+    }
+}
+
+template <typename T>
+void Complex<T>::exp(const Complex<T>* in, Complex<T>* out, const std::size_t& count) noexcept {
+    if constexpr (!PLANES) {
+        for (std::size_t i = 0; i < count; ++i)
+            out[i] = in[i].exp();
+
+        return;
+    }
+
+    T re[BLOCK], im[BLOCK];
+
+    for (std::size_t i = 0; i < count; i += BLOCK) {
+        const std::size_t n = (count - i < BLOCK) ? count - i : BLOCK;
+
+        split(in + i, re, im, n);
+        expPlanes(re, im, re, im, n);
+        merge(re, im, out + i, n);
+    }
+}
+template <typename T>
+void Complex<T>::log(const Complex<T>* in, Complex<T>* out, const std::size_t& count) noexcept {
+    if constexpr (!PLANES) {
+        for (std::size_t i = 0; i < count; ++i)
+            out[i] = in[i].log();
+
+        return;
+    }
+
+    T re[BLOCK], im[BLOCK];
+
+    for (std::size_t i = 0; i < count; i += BLOCK) {
+        const std::size_t n = (count - i < BLOCK) ? count - i : BLOCK;
+
+        split(in + i, re, im, n);
+        logPlanes(re, im, re, im, n);
+        merge(re, im, out + i, n);
+    }
+}
+template <typename T>
+void Complex<T>::sqrt(const Complex<T>* in, Complex<T>* out, const std::size_t& count) noexcept {
+    if constexpr (!PLANES) {
+        for (std::size_t i = 0; i < count; ++i)
+            out[i] = in[i].sqrt();
+
+        return;
+    }
+
+    T re[BLOCK], im[BLOCK], r[BLOCK];
+
+    for (std::size_t i = 0; i < count; i += BLOCK) {
+        const std::size_t n = (count - i < BLOCK) ? count - i : BLOCK;
+
+        split(in + i, re, im, n);
+        Math::hypot(re, im, r, n);
+
+        // selects rather than branches, the signs are random
+        for (std::size_t j = 0; j < n; ++j) {
+            const T t = std::sqrt((r[j] + Math::abs(re[j])) / 2);
+            const T other = (t > 0) ? Math::abs(im[j]) / (2 * t) : T(0);
+            const bool right = re[j] >= 0;
+
+            r[j] = right ? t : other;
+            im[j] = right ? ((t > 0) ? im[j] / (2 * t) : im[j]) : std::copysign(t, im[j]);
+        }
+
+        merge(r, im, out + i, n);
+    }
+}
+template <typename T>
+void Complex<T>::pow(const Complex<T>* in, const Complex<T>& w, Complex<T>* out, const std::size_t& count) noexcept {
+    if constexpr (!PLANES) {
+        for (std::size_t i = 0; i < count; ++i)
+            out[i] = in[i].pow(w);
+
+        return;
+    }
+
+    T re[BLOCK], im[BLOCK];
+    bool zero[BLOCK];
+
+    for (std::size_t i = 0; i < count; i += BLOCK) {
+        const std::size_t n = (count - i < BLOCK) ? count - i : BLOCK;
+
+        split(in + i, re, im, n);
+
+        for (std::size_t j = 0; j < n; ++j)
+            zero[j] = re[j] == 0 && im[j] == 0;
+
+        logPlanes(re, im, re, im, n);
+
+        for (std::size_t j = 0; j < n; ++j) {
+            const T a = re[j] * w.mReal - im[j] * w.mImaginary;
+            const T b = re[j] * w.mImaginary + im[j] * w.mReal;
+
+            // log(0) = -inf would turn into NaN
+            re[j] = zero[j] ? -std::numeric_limits<T>::infinity() : a;
+            im[j] = zero[j] ? T(0) : b;
+        }
+
+        expPlanes(re, im, re, im, n);
+        merge(re, im, out + i, n);
+    }
+}
+template <typename T>
+void Complex<T>::pow(const Complex<T>* in, const T& p, Complex<T>* out, const std::size_t& count) noexcept {
+    if constexpr (!PLANES) {
+        for (std::size_t i = 0; i < count; ++i)
+            out[i] = in[i].pow(p);
+
+        return;
+    }
+
+    T re[BLOCK], im[BLOCK], r[BLOCK];
+    bool zero[BLOCK];
+
+    for (std::size_t i = 0; i < count; i += BLOCK) {
+        const std::size_t n = (count - i < BLOCK) ? count - i : BLOCK;
+
+        split(in + i, re, im, n);
+
+        for (std::size_t j = 0; j < n; ++j)
+            zero[j] = re[j] == 0 && im[j] == 0;
+
+        // |z|^p = exp(p log|z|), p arg(z)
+        Math::hypot(re, im, r, n);
+        Math::log(r, r, n);
+        Math::atan2(im, re, im, n);
+
+        for (std::size_t j = 0; j < n; ++j) {
+            // p log(0) is NaN for p = 0 and inf for p < 0, exp(-inf) is the 0 of the scalar form
+            r[j] = zero[j] ? -std::numeric_limits<T>::infinity() : r[j] * p;
+            im[j] = zero[j] ? T(0) : im[j] * p;
+        }
+
+        Math::exp(r, r, n);
+        Math::sincos(im, im, re, n);
+
+        for (std::size_t j = 0; j < n; ++j) {
+            re[j] *= r[j];
+            im[j] *= r[j];
+        }
+
+        merge(re, im, out + i, n);
+    }
+}
+
+template <typename T>
+void Complex<T>::split(const Complex<T>* in, T* re, T* im, const std::size_t& count) noexcept {
+    for (std::size_t i = 0; i < count; ++i) {
+        re[i] = in[i].mReal;
+        im[i] = in[i].mImaginary;
+    }
+}
+template <typename T>
+void Complex<T>::merge(const T* re, const T* im, Complex<T>* out, const std::size_t& count) noexcept {
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i].mReal = re[i];
+        out[i].mImaginary = im[i];
+    }
+}
+
+template <typename T>
+void Complex<T>::expPlanes(const T* re, const T* im, T* outR, T* outI, const std::size_t& count) noexcept {
+    T e[BLOCK];
+
+    Math::exp(re, e, count);
+    Math::sincos(im, outI, outR, count);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        outR[i] *= e[i];
+        outI[i] *= e[i];
+    }
+}
+template <typename T>
+void Complex<T>::logPlanes(const T* re, const T* im, T* outR, T* outI, const std::size_t& count) noexcept {
+    T r[BLOCK];
+
+    Math::hypot(re, im, r, count);
+    Math::atan2(im, re, outI, count);
+    Math::log(r, outR, count);
+}
+
 template <typename T> void Complex<T>::real(const T& real) noexcept { mReal = real; }
 template <typename T> void Complex<T>::imaginary(const T& imaginary) noexcept { mImaginary = imaginary; }
 
 template <typename T> inline T Complex<T>::real() const noexcept { return mReal; }
-template <typename T> inline T Complex<T>::imaginary() const noexcept { return mImaginary; }
\ No newline at end of file
+template <typename T> inline T Complex<T>::imaginary() const noexcept { return mImaginary; }
+
+static_assert(isTriviallyCopyable<Complex<float>>  && isStandardLayout<Complex<float>>);
+static_assert(isTriviallyCopyable<Complex<double>> && isStandardLayout<Complex<double>>);
\ No newline at end of file
@@ -0,0 +1,385 @@
+#pragma once
+
+#include "./aligned.hpp"
+#include "./complex.hpp"
+#include "./math.hpp"
+#include "./simd.hpp"
+#include "./typeHandler.hpp"
+
+#include <cassert>      // assert()
+#include <cstddef>      // size_t
+
+// Bulk Complex<T> values in one 64-byte aligned block, either INTERLEAVED (real, imaginary
+// pairs, the layout of a Complex<T> array) or SPLIT (a real plane, then an imaginary plane).
+// The element-wise operations run the SIMD::complex*N kernels over whole blocks; SPLIT needs
+// no shuffles, INTERLEAVED is what FFT buffers and most I/O hand over.
+template <typename T>
+class ComplexArray {
+    static_assert(isFloat<T>);
+
+    public:
+        enum class Layout: unsigned char { INTERLEAVED, SPLIT };
+
+        inline static constexpr std::size_t ALIGNMENT = Aligned::ALIGNMENT;
+
+    public:
+        explicit ComplexArray(const Layout& = Layout::SPLIT) noexcept;
+        ComplexArray(const ComplexArray<T>&);
+        ComplexArray(ComplexArray<T>&&) noexcept;
+        ~ComplexArray() noexcept;
+
+        explicit ComplexArray(const std::size_t& count, const Layout& = Layout::SPLIT);
+        ComplexArray(const Complex<T>* src, const std::size_t& count, const Layout& = Layout::SPLIT);
+
+        ComplexArray<T>& operator=(const ComplexArray<T>&);
+        ComplexArray<T>& operator=(ComplexArray<T>&&) noexcept;
+
+        inline Complex<T> get(const std::size_t& idx) const;
+        inline void set(const std::size_t& idx, const Complex<T>&);
+
+        // SPLIT: the planes. INTERLEAVED: the first real / imaginary lane, both 2 lanes apart
+        inline T* real() noexcept;
+        inline const T* real() const noexcept;
+        inline T* imaginary() noexcept;
+        inline const T* imaginary() const noexcept;
+        // INTERLEAVED only: the block as Complex<T> values
+        inline Complex<T>* data() noexcept;
+        inline const Complex<T>* data() const noexcept;
+
+        inline Layout layout() const noexcept;
+        // the same values in the other layout (in place)
+        void setLayout(const Layout&);
+
+        void resize(const std::size_t& count);
+        void fromAoS(const Complex<T>* src, const std::size_t& count);
+        void toAoS(Complex<T>* dst) const noexcept;
+
+        inline std::size_t size() const noexcept;
+        inline std::size_t capacity() const noexcept;
+
+        // element-wise, a and b of the same size and layout, out may be either (else it takes their layout)
+        static void multiply(const ComplexArray<T>& a, const ComplexArray<T>& b, ComplexArray<T>& out);
+        // out = a * conj(b)
+        static void conjugateMultiply(const ComplexArray<T>& a, const ComplexArray<T>& b, ComplexArray<T>& out);
+        // zero divisors are not checked
+        static void divide(const ComplexArray<T>& a, const ComplexArray<T>& b, ComplexArray<T>& out);
+
+        inline ComplexArray<T>& operator*=(const ComplexArray<T>&);
+        inline ComplexArray<T>& operator/=(const ComplexArray<T>&);
+
+        ComplexArray<T>& conjugate() noexcept;
+
+        // out[i] = |z[i]|, |z[i]|^2, arg(z[i]) in [-pi, pi]
+        void magnitude(T* out) const noexcept;
+        void magnitudeSquare(T* out) const noexcept;
+        void phase(T* out) const noexcept;
+
+    private:
+        // the layout of the inputs and count values for an output (their contents are not kept on a layout change)
+        void prepare(const Layout&, const std::size_t& count);
+
+        void allocate(const std::size_t& count);
+        void release() noexcept;
+
+
+    private:
+        // 2 * mCapacity lanes: mCapacity pairs or two planes of mCapacity
+        T* mData{ };
+        std::size_t mSize{ };
+        std::size_t mCapacity{ };
+        Layout mLayout{ Layout::SPLIT };
+};
+
+template <typename T> ComplexArray<T>::ComplexArray(const Layout& layout) noexcept
+    : mLayout{layout} { }
+template <typename T> ComplexArray<T>::ComplexArray(const ComplexArray<T>& other) { *this = other; }
+template <typename T> ComplexArray<T>::ComplexArray(ComplexArray<T>&& other) noexcept { *this = move(other); }
+template <typename T> ComplexArray<T>::~ComplexArray() noexcept { release(); }
+
+template <typename T>
+ComplexArray<T>::ComplexArray(const std::size_t& count, const Layout& layout)
+    : mLayout{layout} { resize(count); }
+template <typename T>
+ComplexArray<T>::ComplexArray(const Complex<T>* src, const std::size_t& count, const Layout& layout)
+    : mLayout{layout} { fromAoS(src, count); }
+
+template <typename T>
+ComplexArray<T>& ComplexArray<T>::operator=(const ComplexArray<T>& other) {
+    if (this == &other)
+        return *this;
+
+    prepare(other.mLayout, other.mSize);
+
+    if (mLayout == Layout::INTERLEAVED) {
+        for (std::size_t i = 0; i < 2 * mSize; ++i)
+            mData[i] = other.mData[i];
+    }
+    else {
+        T* re = real();
+        T* im = imaginary();
+
+        for (std::size_t i = 0; i < mSize; ++i) {
+            re[i] = other.real()[i];
+            im[i] = other.imaginary()[i];
+        }
+    }
+
+    return *this;
+}
+template <typename T>
+ComplexArray<T>& ComplexArray<T>::operator=(ComplexArray<T>&& other) noexcept {
+    if (this == &other)
+        return *this;
+
+    release();
+
+    mData     = other.mData;
+    mSize     = other.mSize;
+    mCapacity = other.mCapacity;
+    mLayout   = other.mLayout;
+
+    other.mData     = nullptr;
+    other.mSize     = 0;
+    other.mCapacity = 0;
+
+    return *this;
+}
+
+template <typename T>
+inline Complex<T> ComplexArray<T>::get(const std::size_t& idx) const {
+    assert(idx < mSize);
+
+    if (mLayout == Layout::INTERLEAVED)
+        return Complex<T>(mData[2 * idx], mData[2 * idx + 1]);
+
+    return Complex<T>(real()[idx], imaginary()[idx]);
+}
+template <typename T>
+inline void ComplexArray<T>::set(const std::size_t& idx, const Complex<T>& z) {
+    assert(idx < mSize);
+
+    if (mLayout == Layout::INTERLEAVED) {
+        mData[2 * idx]     = z.real();
+        mData[2 * idx + 1] = z.imaginary();
+    }
+    else {
+        real()[idx]      = z.real();
+        imaginary()[idx] = z.imaginary();
+    }
+}
+
+template <typename T>
+inline T* ComplexArray<T>::real() noexcept { return mData; }
+template <typename T>
+inline const T* ComplexArray<T>::real() const noexcept { return mData; }
+template <typename T>
+inline T* ComplexArray<T>::imaginary() noexcept { return (mLayout == Layout::INTERLEAVED) ? mData + 1 : mData + mCapacity; }
+template <typename T>
+inline const T* ComplexArray<T>::imaginary() const noexcept { return (mLayout == Layout::INTERLEAVED) ? mData + 1 : mData + mCapacity; }
+template <typename T>
+inline Complex<T>* ComplexArray<T>::data() noexcept {
+    assert(mLayout == Layout::INTERLEAVED);
+
+    return reinterpret_cast<Complex<T>*>(mData);
+}
+template <typename T>
+inline const Complex<T>* ComplexArray<T>::data() const noexcept {
+    assert(mLayout == Layout::INTERLEAVED);
+
+    return reinterpret_cast<const Complex<T>*>(mData);
+}
+
+template <typename T>
+inline typename ComplexArray<T>::Layout ComplexArray<T>::layout() const noexcept { return mLayout; }
+template <typename T>
+void ComplexArray<T>::setLayout(const Layout& layout) {
+    if (layout == mLayout)
+        return;
+
+    // both layouts use the same 2 * mCapacity lanes, the other one is filled from a copy
+    ComplexArray<T> converted(layout);
+    converted.allocate(mCapacity);
+    converted.mSize = mSize;
+
+    T* re = converted.real();
+    T* im = converted.imaginary();
+
+    const std::size_t from = (mLayout == Layout::INTERLEAVED) ? 2 : 1;
+    const std::size_t to   = (layout == Layout::INTERLEAVED) ? 2 : 1;
+
+    for (std::size_t i = 0; i < mSize; ++i) {
+        re[i * to] = real()[i * from];
+        im[i * to] = imaginary()[i * from];
+    }
+
+    *this = move(converted);
+}
+
+template <typename T>
+void ComplexArray<T>::resize(const std::size_t& count) {
+    const std::size_t oldSize = mSize;
+
+    if (count > mCapacity) {
+        ComplexArray<T> grown(mLayout);
+        grown.allocate(count);
+        grown.mSize = mSize;
+
+        for (std::size_t i = 0; i < mSize; ++i)
+            grown.set(i, get(i));
+
+        *this = move(grown);
+    }
+
+    mSize = count;
+
+    for (std::size_t i = oldSize; i < count; ++i)
+        set(i, Complex<T>{ });
+}
+template <typename T>
+void ComplexArray<T>::fromAoS(const Complex<T>* src, const std::size_t& count) {
+    resize(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+        set(i, src[i]);
+}
+template <typename T>
+void ComplexArray<T>::toAoS(Complex<T>* dst) const noexcept {
+    for (std::size_t i = 0; i < mSize; ++i)
+        dst[i] = get(i);
+}
+
+template <typename T>
+inline std::size_t ComplexArray<T>::size() const noexcept { return mSize; }
+template <typename T>
+inline std::size_t ComplexArray<T>::capacity() const noexcept { return mCapacity; }
+
+template <typename T>
+void ComplexArray<T>::multiply(const ComplexArray<T>& a, const ComplexArray<T>& b, ComplexArray<T>& out) {
+    assert(a.mSize == b.mSize && a.mLayout == b.mLayout);
+
+    if (&out != &a && &out != &b)
+        out.prepare(a.mLayout, a.mSize);
+
+    if (a.mLayout == Layout::INTERLEAVED)
+        SIMD::complexMulN(a.mData, b.mData, out.mData, a.mSize);
+    else
+        SIMD::complexMulN(a.real(), a.imaginary(), b.real(), b.imaginary(), out.real(), out.imaginary(), a.mSize);
+}
+template <typename T>
+void ComplexArray<T>::conjugateMultiply(const ComplexArray<T>& a, const ComplexArray<T>& b, ComplexArray<T>& out) {
+    assert(a.mSize == b.mSize && a.mLayout == b.mLayout);
+
+    if (&out != &a && &out != &b)
+        out.prepare(a.mLayout, a.mSize);
+
+    if (a.mLayout == Layout::INTERLEAVED)
+        SIMD::complexConjMulN(a.mData, b.mData, out.mData, a.mSize);
+    else
+        SIMD::complexConjMulN(a.real(), a.imaginary(), b.real(), b.imaginary(), out.real(), out.imaginary(), a.mSize);
+}
+template <typename T>
+void ComplexArray<T>::divide(const ComplexArray<T>& a, const ComplexArray<T>& b, ComplexArray<T>& out) {
+    assert(a.mSize == b.mSize && a.mLayout == b.mLayout);
+
+    if (&out != &a && &out != &b)
+        out.prepare(a.mLayout, a.mSize);
+
+    if (a.mLayout == Layout::INTERLEAVED)
+        SIMD::complexDivN(a.mData, b.mData, out.mData, a.mSize);
+    else
+        SIMD::complexDivN(a.real(), a.imaginary(), b.real(), b.imaginary(), out.real(), out.imaginary(), a.mSize);
+}
+
+template <typename T>
+inline ComplexArray<T>& ComplexArray<T>::operator*=(const ComplexArray<T>& other) {
+    multiply(*this, other, *this);
+
+    return *this;
+}
+template <typename T>
+inline ComplexArray<T>& ComplexArray<T>::operator/=(const ComplexArray<T>& other) {
+    divide(*this, other, *this);
+
+    return *this;
+}
+
+template <typename T>
+ComplexArray<T>& ComplexArray<T>::conjugate() noexcept {
+    T* im = imaginary();
+    const std::size_t step = (mLayout == Layout::INTERLEAVED) ? 2 : 1;
+
+    for (std::size_t i = 0; i < mSize; ++i)
+        im[i * step] = -im[i * step];
+
+    return *this;
+}
+
+template <typename T>
+void ComplexArray<T>::magnitude(T* out) const noexcept {
+    if (mLayout == Layout::INTERLEAVED)
+        SIMD::complexMagnitudeN(mData, out, mSize);
+    else
+        SIMD::complexMagnitudeN(real(), imaginary(), out, mSize);
+}
+template <typename T>
+void ComplexArray<T>::magnitudeSquare(T* out) const noexcept {
+    if (mLayout == Layout::INTERLEAVED)
+        SIMD::complexMagnitudeSquareN(mData, out, mSize);
+    else
+        SIMD::complexMagnitudeSquareN(real(), imaginary(), out, mSize);
+}
+template <typename T>
+void ComplexArray<T>::phase(T* out) const noexcept {
+    if (mLayout == Layout::SPLIT) {
+        Math::atan2(imaginary(), real(), out, mSize);
+
+        return;
+    }
+
+    // blocks of the pairs split into L1-resident planes first
+    constexpr std::size_t BLOCK = 1024;
+    alignas(ALIGNMENT) T re[BLOCK];
+    alignas(ALIGNMENT) T im[BLOCK];
+
+    for (std::size_t base = 0; base < mSize; base += BLOCK) {
+        const std::size_t count = (mSize - base < BLOCK) ? (mSize - base) : BLOCK;
+
+        for (std::size_t i = 0; i < count; ++i) {
+            re[i] = mData[2 * (base + i)];
+            im[i] = mData[2 * (base + i) + 1];
+        }
+
+        Math::atan2(im, re, out + base, count);
+    }
+}
+
+template <typename T>
+void ComplexArray<T>::prepare(const Layout& layout, const std::size_t& count) {
+    if (layout != mLayout) {
+        mLayout = layout;
+        mSize   = 0;
+    }
+
+    resize(count);
+}
+
+template <typename T>
+void ComplexArray<T>::allocate(const std::size_t& count) {
+    release();
+
+    // the imaginary plane starts on an ALIGNMENT boundary too
+    const std::size_t capacity = Aligned::roundUp<T>(count);
+    if (capacity == 0)
+        return;
+
+    mData     = Aligned::allocate<T>(2 * capacity);
+    mCapacity = capacity;
+}
+template <typename T>
+void ComplexArray<T>::release() noexcept {
+    Aligned::release(mData);
+
+    mData     = nullptr;
+    mSize     = 0;
+    mCapacity = 0;
+}
\ No newline at end of file
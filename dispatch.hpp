@@ -0,0 +1,509 @@
+#pragma once
+
+#include "typeHandler.hpp"
+#include "matrix/mat4.hpp"
+#include "vector/vec4.hpp"
+
+#include <cstddef>      // size_t
+#include <cstdlib>      // getenv()
+#include <cstring>      // memcpy(), strcmp()
+
+// Runtime instruction set dispatch for float batch kernels. The CPU is probed once
+// (cpuid / xgetbv) on first use and every entry point below jumps through a table bound
+// to the best tier it supports, so a single binary runs the AVX-512 kernels where they
+// exist and the AVX2 ones elsewhere. Independent of MATH_ENABLE_SIMD: the BASELINE tier
+// is the library's own compile-time code path.
+//
+// MATH_DISPATCH_TIER=baseline|sse4.2|avx2|avx512 lowers the tier (it never raises it).
+// Tiers may differ in the last bit: summation order and FMA contraction are not the same.
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+    #define MATH_DISPATCH_X86
+    #define MATH_TARGET(isa) __attribute__((target(isa)))
+
+    #include <cpuid.h>      // __get_cpuid(), __get_cpuid_count()
+    #include <immintrin.h>
+#endif
+
+class Dispatch {
+    Dispatch() = delete;
+    Dispatch(const Dispatch&) = delete;
+    Dispatch(Dispatch&&) noexcept = delete;
+    ~Dispatch() noexcept = delete;
+
+    Dispatch& operator=(const Dispatch&) = delete;
+    Dispatch& operator=(Dispatch&&) noexcept = delete;
+
+    public:
+        enum class Tier: unsigned char {
+            BASELINE,
+            SSE42,
+            AVX2,       // AVX2 + FMA
+            AVX512      // AVX-512F
+        };
+
+        struct Features {
+            bool sse42  = false;
+            bool avx2   = false;
+            bool fma    = false;
+            bool avx512 = false;
+        };
+
+        static inline const Features& features() noexcept;
+        // best supported tier, after MATH_DISPATCH_TIER
+        static inline Tier tier() noexcept;
+        static inline const char* name(const Tier&) noexcept;
+
+    // Batch entry points (in and out may be the same array)
+    public:
+        static inline void normalize(const Vec4<float>* in, Vec4<float>* out, const std::size_t& count) noexcept;
+        static inline void dot(const Vec4<float>* a, const Vec4<float>* b, float* out, const std::size_t& count) noexcept;
+        // out[i] = m * in[i]
+        static inline void transform(const Mat4<float>& m, const Vec4<float>* in, Vec4<float>* out, const std::size_t& count) noexcept;
+        // out[i] = a[i] * b[i]
+        static inline void multiply(const Mat4<float>* a, const Mat4<float>* b, Mat4<float>* out, const std::size_t& count) noexcept;
+
+    private:
+        struct Table {
+            void (*normalize)(const float*, float*, std::size_t) noexcept;
+            void (*dot)(const float*, const float*, float*, std::size_t) noexcept;
+            void (*transform)(const float*, const float*, float*, std::size_t) noexcept;
+            void (*multiply)(const float*, const float*, float*, std::size_t) noexcept;
+        };
+
+        static inline Features detect() noexcept;
+        static inline Tier lower(const Tier&) noexcept;
+        static inline const Table& table() noexcept;
+
+        template <typename K>
+        inline static constexpr Table bind() noexcept { return { &K::normalize, &K::dot, &K::transform, &K::multiply }; }
+
+        struct Baseline {
+            static inline void normalize(const float*, float*, std::size_t) noexcept;
+            static inline void dot(const float*, const float*, float*, std::size_t) noexcept;
+            static inline void transform(const float*, const float*, float*, std::size_t) noexcept;
+            static inline void multiply(const float*, const float*, float*, std::size_t) noexcept;
+        };
+
+        #if defined(MATH_DISPATCH_X86)
+            struct SSE42 {
+                MATH_TARGET("sse4.2") static inline void normalize(const float*, float*, std::size_t) noexcept;
+                MATH_TARGET("sse4.2") static inline void dot(const float*, const float*, float*, std::size_t) noexcept;
+                MATH_TARGET("sse4.2") static inline void transform(const float*, const float*, float*, std::size_t) noexcept;
+                MATH_TARGET("sse4.2") static inline void multiply(const float*, const float*, float*, std::size_t) noexcept;
+            };
+            struct AVX2 {
+                MATH_TARGET("avx2,fma") static inline void normalize(const float*, float*, std::size_t) noexcept;
+                MATH_TARGET("avx2,fma") static inline void dot(const float*, const float*, float*, std::size_t) noexcept;
+                MATH_TARGET("avx2,fma") static inline void transform(const float*, const float*, float*, std::size_t) noexcept;
+                MATH_TARGET("avx2,fma") static inline void multiply(const float*, const float*, float*, std::size_t) noexcept;
+            };
+            struct AVX512 {
+                // the zero-masked forms of the intrinsics that take _mm512_undefined_ps(), which GCC
+                // builds from a self-initialized variable and then warns about (-Wuninitialized)
+                inline static constexpr __mmask16 ALL = 0xFFFF;
+
+                MATH_TARGET("avx512f") static inline void normalize(const float*, float*, std::size_t) noexcept;
+                MATH_TARGET("avx512f") static inline void dot(const float*, const float*, float*, std::size_t) noexcept;
+                MATH_TARGET("avx512f") static inline void transform(const float*, const float*, float*, std::size_t) noexcept;
+                MATH_TARGET("avx512f") static inline void multiply(const float*, const float*, float*, std::size_t) noexcept;
+            };
+        #endif
+};
+
+inline const Dispatch::Features& Dispatch::features() noexcept {
+    static const Features sFeatures = detect();
+
+    return sFeatures;
+}
+inline Dispatch::Tier Dispatch::tier() noexcept {
+    static const Tier sTier = [] {
+        const Features& f = features();
+
+        Tier best = Tier::BASELINE;
+        if (f.avx512)
+            best = Tier::AVX512;
+        else if (f.avx2 && f.fma)
+            best = Tier::AVX2;
+        else if (f.sse42)
+            best = Tier::SSE42;
+
+        return lower(best);
+    }();
+
+    return sTier;
+}
+inline const char* Dispatch::name(const Tier& t) noexcept {
+    switch (t) {
+        case Tier::SSE42:  return "sse4.2";
+        case Tier::AVX2:   return "avx2";
+        case Tier::AVX512: return "avx512";
+        default:           return "baseline";
+    }
+}
+
+// the kernels take lanes: SIMD::blocks copies the objects in and out
+inline void Dispatch::normalize(const Vec4<float>* in, Vec4<float>* out, const std::size_t& count) noexcept {
+    if (count != 0)
+        SIMD::blocks<float>(count, table().normalize, in, out);
+}
+inline void Dispatch::dot(const Vec4<float>* a, const Vec4<float>* b, float* out, const std::size_t& count) noexcept {
+    if (count != 0)
+        SIMD::blocks<float>(count, table().dot, a, b, out);
+}
+inline void Dispatch::transform(const Mat4<float>& m, const Vec4<float>* in, Vec4<float>* out, const std::size_t& count) noexcept {
+    if (count == 0)
+        return;
+
+    float lanes[16];
+    std::memcpy(lanes, &m, sizeof(lanes));
+
+    const auto kernel = table().transform;
+    SIMD::blocks<float>(count, [&](const float* src, float* dst, const std::size_t& n) { kernel(lanes, src, dst, n); }, in, out);
+}
+inline void Dispatch::multiply(const Mat4<float>* a, const Mat4<float>* b, Mat4<float>* out, const std::size_t& count) noexcept {
+    if (count != 0)
+        SIMD::blocks<float>(count, table().multiply, a, b, out);
+}
+
+inline Dispatch::Features Dispatch::detect() noexcept {
+    Features f{ };
+
+    #if defined(MATH_DISPATCH_X86)
+        unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+        if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+            return f;
+
+        f.sse42 = (ecx & bit_SSE4_2) != 0;
+
+        // the OS must save the wide registers too (XCR0: 1-2 xmm/ymm, 5-7 opmask/zmm)
+        unsigned int xcr0 = 0;
+        if ((ecx & bit_OSXSAVE) != 0) {
+            unsigned int hi = 0;
+            __asm__ volatile ("xgetbv" : "=a"(xcr0), "=d"(hi) : "c"(0));
+        }
+
+        const bool ymm = (ecx & bit_AVX) != 0 && (xcr0 & 0x06) == 0x06;
+        const bool zmm = ymm && (xcr0 & 0xE0) == 0xE0;
+
+        f.fma = ymm && (ecx & bit_FMA) != 0;
+
+        if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+            f.avx2   = ymm && (ebx & bit_AVX2) != 0;
+            f.avx512 = zmm && (ebx & bit_AVX512F) != 0;
+        }
+    #endif
+
+    return f;
+}
+inline Dispatch::Tier Dispatch::lower(const Tier& best) noexcept {
+    const char* env = std::getenv("MATH_DISPATCH_TIER");
+    if (env == nullptr)
+        return best;
+
+    const Tier tiers[] = { Tier::BASELINE, Tier::SSE42, Tier::AVX2, Tier::AVX512 };
+    for (const Tier& t: tiers)
+        if (std::strcmp(env, name(t)) == 0)
+            return (t < best) ? t : best;
+
+    return best;
+}
+inline const Dispatch::Table& Dispatch::table() noexcept {
+    static const Table sTable = [] {
+        #if defined(MATH_DISPATCH_X86)
+            switch (tier()) {
+                case Tier::AVX512: return bind<AVX512>();
+                case Tier::AVX2:   return bind<AVX2>();
+                case Tier::SSE42:  return bind<SSE42>();
+                default:           break;
+            }
+        #endif
+
+        return bind<Baseline>();
+    }();
+
+    return sTable;
+}
+
+// the class operators on copies of the lanes, so out may alias the inputs (void*: Vec4 / Mat4 are trivially
+// copyable, -Wclass-memaccess only sees their default member initializers)
+inline void Dispatch::Baseline::normalize(const float* in, float* out, std::size_t count) noexcept {
+    for (std::size_t i = 0; i < count; ++i) {
+        Vec4<float> v;
+        std::memcpy(static_cast<void*>(&v), in + i * 4, sizeof(v));
+
+        v = v.normalize();
+        std::memcpy(out + i * 4, &v, sizeof(v));
+    }
+}
+inline void Dispatch::Baseline::dot(const float* a, const float* b, float* out, std::size_t count) noexcept {
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] = SIMD::dot4(a + i * 4, b + i * 4);
+}
+// as Mat4::transformHomogeneous
+inline void Dispatch::Baseline::transform(const float* m, const float* in, float* out, std::size_t count) noexcept {
+    if constexpr (SIMD::has4<float>) {
+        SIMD::transform4(m, in, out, count);
+
+        return;
+    }
+
+    Mat4<float> mat;
+    std::memcpy(static_cast<void*>(&mat), m, sizeof(mat));
+
+    for (std::size_t i = 0; i < count; ++i) {
+        Vec4<float> v;
+        std::memcpy(static_cast<void*>(&v), in + i * 4, sizeof(v));
+
+        v = mat * v;
+        std::memcpy(out + i * 4, &v, sizeof(v));
+    }
+}
+inline void Dispatch::Baseline::multiply(const float* a, const float* b, float* out, std::size_t count) noexcept {
+    for (std::size_t i = 0; i < count; ++i) {
+        Mat4<float> lhs, rhs;
+        std::memcpy(static_cast<void*>(&lhs), a + i * 16, sizeof(lhs));
+        std::memcpy(static_cast<void*>(&rhs), b + i * 16, sizeof(rhs));
+
+        const Mat4<float> product = lhs * rhs;
+        std::memcpy(out + i * 16, &product, sizeof(product));
+    }
+}
+
+#if defined(MATH_DISPATCH_X86)
+    // SSE4.2: one Vec4 per register
+    inline void Dispatch::SSE42::normalize(const float* in, float* out, std::size_t count) noexcept {
+        for (std::size_t i = 0; i < count * 4; i += 4) {
+            const __m128 v = _mm_loadu_ps(in + i);
+
+            _mm_storeu_ps(out + i, _mm_div_ps(v, _mm_sqrt_ps(_mm_dp_ps(v, v, 0xFF))));
+        }
+    }
+    inline void Dispatch::SSE42::dot(const float* a, const float* b, float* out, std::size_t count) noexcept {
+        std::size_t i = 0;
+
+        // four products folded into four sums at once
+        for (; i + 4 <= count; i += 4) {
+            const __m128 p0 = _mm_mul_ps(_mm_loadu_ps(a + i * 4),      _mm_loadu_ps(b + i * 4));
+            const __m128 p1 = _mm_mul_ps(_mm_loadu_ps(a + i * 4 + 4),  _mm_loadu_ps(b + i * 4 + 4));
+            const __m128 p2 = _mm_mul_ps(_mm_loadu_ps(a + i * 4 + 8),  _mm_loadu_ps(b + i * 4 + 8));
+            const __m128 p3 = _mm_mul_ps(_mm_loadu_ps(a + i * 4 + 12), _mm_loadu_ps(b + i * 4 + 12));
+
+            _mm_storeu_ps(out + i, _mm_hadd_ps(_mm_hadd_ps(p0, p1), _mm_hadd_ps(p2, p3)));
+        }
+        for (; i < count; ++i)
+            out[i] = _mm_cvtss_f32(_mm_dp_ps(_mm_loadu_ps(a + i * 4), _mm_loadu_ps(b + i * 4), 0xF1));
+    }
+    inline void Dispatch::SSE42::transform(const float* m, const float* in, float* out, std::size_t count) noexcept {
+        __m128 c0 = _mm_loadu_ps(m);
+        __m128 c1 = _mm_loadu_ps(m + 4);
+        __m128 c2 = _mm_loadu_ps(m + 8);
+        __m128 c3 = _mm_loadu_ps(m + 12);
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+        for (std::size_t i = 0; i < count * 4; i += 4) {
+            const __m128 v = _mm_loadu_ps(in + i);
+
+            __m128 acc =        _mm_mul_ps(c0, _mm_shuffle_ps(v, v, 0x00));
+            acc = _mm_add_ps(acc, _mm_mul_ps(c1, _mm_shuffle_ps(v, v, 0x55)));
+            acc = _mm_add_ps(acc, _mm_mul_ps(c2, _mm_shuffle_ps(v, v, 0xAA)));
+            acc = _mm_add_ps(acc, _mm_mul_ps(c3, _mm_shuffle_ps(v, v, 0xFF)));
+
+            _mm_storeu_ps(out + i, acc);
+        }
+    }
+    inline void Dispatch::SSE42::multiply(const float* a, const float* b, float* out, std::size_t count) noexcept {
+        for (std::size_t i = 0; i < count * 16; i += 16) {
+            const __m128 b0 = _mm_loadu_ps(b + i);
+            const __m128 b1 = _mm_loadu_ps(b + i + 4);
+            const __m128 b2 = _mm_loadu_ps(b + i + 8);
+            const __m128 b3 = _mm_loadu_ps(b + i + 12);
+
+            for (std::size_t row = i; row < i + 16; row += 4) {
+                const __m128 r = _mm_loadu_ps(a + row);
+
+                __m128 acc =        _mm_mul_ps(_mm_shuffle_ps(r, r, 0x00), b0);
+                acc = _mm_add_ps(acc, _mm_mul_ps(_mm_shuffle_ps(r, r, 0x55), b1));
+                acc = _mm_add_ps(acc, _mm_mul_ps(_mm_shuffle_ps(r, r, 0xAA), b2));
+                acc = _mm_add_ps(acc, _mm_mul_ps(_mm_shuffle_ps(r, r, 0xFF), b3));
+
+                _mm_storeu_ps(out + row, acc);
+            }
+        }
+    }
+
+    // AVX2 + FMA: two Vec4 per register, one per 128-bit half
+    inline void Dispatch::AVX2::normalize(const float* in, float* out, std::size_t count) noexcept {
+        std::size_t i = 0;
+
+        for (; i + 2 <= count; i += 2) {
+            const __m256 v = _mm256_loadu_ps(in + i * 4);
+
+            __m256 sum = _mm256_mul_ps(v, v);
+            sum = _mm256_hadd_ps(sum, sum);
+            sum = _mm256_hadd_ps(sum, sum);
+
+            _mm256_storeu_ps(out + i * 4, _mm256_div_ps(v, _mm256_sqrt_ps(sum)));
+        }
+        if (i < count) {
+            const __m128 v = _mm_loadu_ps(in + i * 4);
+
+            _mm_storeu_ps(out + i * 4, _mm_div_ps(v, _mm_sqrt_ps(_mm_dp_ps(v, v, 0xFF))));
+        }
+    }
+    inline void Dispatch::AVX2::dot(const float* a, const float* b, float* out, std::size_t count) noexcept {
+        // hadd works per half: pairs come out as 0 2 4 6 | 1 3 5 7
+        const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const float* pa = a + i * 4;
+            const float* pb = b + i * 4;
+
+            const __m256 p0 = _mm256_mul_ps(_mm256_loadu_ps(pa),      _mm256_loadu_ps(pb));
+            const __m256 p1 = _mm256_mul_ps(_mm256_loadu_ps(pa + 8),  _mm256_loadu_ps(pb + 8));
+            const __m256 p2 = _mm256_mul_ps(_mm256_loadu_ps(pa + 16), _mm256_loadu_ps(pb + 16));
+            const __m256 p3 = _mm256_mul_ps(_mm256_loadu_ps(pa + 24), _mm256_loadu_ps(pb + 24));
+
+            const __m256 sum = _mm256_hadd_ps(_mm256_hadd_ps(p0, p1), _mm256_hadd_ps(p2, p3));
+
+            _mm256_storeu_ps(out + i, _mm256_permutevar8x32_ps(sum, order));
+        }
+        for (; i < count; ++i)
+            out[i] = _mm_cvtss_f32(_mm_dp_ps(_mm_loadu_ps(a + i * 4), _mm_loadu_ps(b + i * 4), 0xF1));
+    }
+    inline void Dispatch::AVX2::transform(const float* m, const float* in, float* out, std::size_t count) noexcept {
+        __m128 c0 = _mm_loadu_ps(m);
+        __m128 c1 = _mm_loadu_ps(m + 4);
+        __m128 c2 = _mm_loadu_ps(m + 8);
+        __m128 c3 = _mm_loadu_ps(m + 12);
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+        const __m256 w0 = _mm256_set_m128(c0, c0);
+        const __m256 w1 = _mm256_set_m128(c1, c1);
+        const __m256 w2 = _mm256_set_m128(c2, c2);
+        const __m256 w3 = _mm256_set_m128(c3, c3);
+
+        std::size_t i = 0;
+        for (; i + 2 <= count; i += 2) {
+            const __m256 v = _mm256_loadu_ps(in + i * 4);
+
+            __m256 acc = _mm256_mul_ps(w0, _mm256_permute_ps(v, 0x00));
+            acc = _mm256_fmadd_ps(w1, _mm256_permute_ps(v, 0x55), acc);
+            acc = _mm256_fmadd_ps(w2, _mm256_permute_ps(v, 0xAA), acc);
+            acc = _mm256_fmadd_ps(w3, _mm256_permute_ps(v, 0xFF), acc);
+
+            _mm256_storeu_ps(out + i * 4, acc);
+        }
+        if (i < count) {
+            const __m128 v = _mm_loadu_ps(in + i * 4);
+
+            __m128 acc = _mm_mul_ps(c0, _mm_permute_ps(v, 0x00));
+            acc = _mm_fmadd_ps(c1, _mm_permute_ps(v, 0x55), acc);
+            acc = _mm_fmadd_ps(c2, _mm_permute_ps(v, 0xAA), acc);
+            acc = _mm_fmadd_ps(c3, _mm_permute_ps(v, 0xFF), acc);
+
+            _mm_storeu_ps(out + i * 4, acc);
+        }
+    }
+    inline void Dispatch::AVX2::multiply(const float* a, const float* b, float* out, std::size_t count) noexcept {
+        for (std::size_t i = 0; i < count * 16; i += 16) {
+            const __m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + i));
+            const __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + i + 4));
+            const __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + i + 8));
+            const __m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + i + 12));
+
+            // rows 0-1, then rows 2-3
+            for (std::size_t row = i; row < i + 16; row += 8) {
+                const __m256 r = _mm256_loadu_ps(a + row);
+
+                __m256 acc = _mm256_mul_ps(_mm256_permute_ps(r, 0x00), b0);
+                acc = _mm256_fmadd_ps(_mm256_permute_ps(r, 0x55), b1, acc);
+                acc = _mm256_fmadd_ps(_mm256_permute_ps(r, 0xAA), b2, acc);
+                acc = _mm256_fmadd_ps(_mm256_permute_ps(r, 0xFF), b3, acc);
+
+                _mm256_storeu_ps(out + row, acc);
+            }
+        }
+    }
+
+    // AVX-512F: four Vec4 (or one Mat4) per register, tails through lane masks
+    inline void Dispatch::AVX512::normalize(const float* in, float* out, std::size_t count) noexcept {
+        for (std::size_t i = 0; i < count; i += 4) {
+            const __mmask16 mask = (count - i >= 4) ? 0xFFFF : static_cast<__mmask16>((1u << ((count - i) * 4)) - 1);
+
+            const __m512 v = _mm512_maskz_loadu_ps(mask, in + i * 4);
+
+            __m512 sum = _mm512_mul_ps(v, v);
+            sum = _mm512_add_ps(sum, _mm512_maskz_permute_ps(ALL, sum, 0x4E));
+            sum = _mm512_add_ps(sum, _mm512_maskz_permute_ps(ALL, sum, 0xB1));
+
+            _mm512_mask_storeu_ps(out + i * 4, mask, _mm512_div_ps(v, _mm512_maskz_sqrt_ps(ALL, sum)));
+        }
+    }
+    inline void Dispatch::AVX512::dot(const float* a, const float* b, float* out, std::size_t count) noexcept {
+        // pair 4j + k comes out in lane k, slot j
+        const __m512i order = _mm512_setr_epi32(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+
+        std::size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            const float* pa = a + i * 4;
+            const float* pb = b + i * 4;
+
+            const __m512 p0 = _mm512_mul_ps(_mm512_loadu_ps(pa),      _mm512_loadu_ps(pb));
+            const __m512 p1 = _mm512_mul_ps(_mm512_loadu_ps(pa + 16), _mm512_loadu_ps(pb + 16));
+            const __m512 p2 = _mm512_mul_ps(_mm512_loadu_ps(pa + 32), _mm512_loadu_ps(pb + 32));
+            const __m512 p3 = _mm512_mul_ps(_mm512_loadu_ps(pa + 48), _mm512_loadu_ps(pb + 48));
+
+            // (x + y, z + w) of two vectors per half, then the full sums of four
+            const __m512 s01 = _mm512_add_ps(_mm512_shuffle_ps(p0, p1, 0x88), _mm512_shuffle_ps(p0, p1, 0xDD));
+            const __m512 s23 = _mm512_add_ps(_mm512_shuffle_ps(p2, p3, 0x88), _mm512_shuffle_ps(p2, p3, 0xDD));
+            const __m512 sum = _mm512_add_ps(_mm512_shuffle_ps(s01, s23, 0x88), _mm512_shuffle_ps(s01, s23, 0xDD));
+
+            _mm512_storeu_ps(out + i, _mm512_maskz_permutexvar_ps(ALL, order, sum));
+        }
+        for (; i < count; ++i) {
+            const __m128 p = _mm_mul_ps(_mm_loadu_ps(a + i * 4), _mm_loadu_ps(b + i * 4));
+            const __m128 s = _mm_add_ps(p, _mm_movehl_ps(p, p));
+
+            out[i] = _mm_cvtss_f32(_mm_add_ss(s, _mm_movehdup_ps(s)));
+        }
+    }
+    inline void Dispatch::AVX512::transform(const float* m, const float* in, float* out, std::size_t count) noexcept {
+        __m128 c0 = _mm_loadu_ps(m);
+        __m128 c1 = _mm_loadu_ps(m + 4);
+        __m128 c2 = _mm_loadu_ps(m + 8);
+        __m128 c3 = _mm_loadu_ps(m + 12);
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+        const __m512 w0 = _mm512_maskz_broadcast_f32x4(ALL, c0);
+        const __m512 w1 = _mm512_maskz_broadcast_f32x4(ALL, c1);
+        const __m512 w2 = _mm512_maskz_broadcast_f32x4(ALL, c2);
+        const __m512 w3 = _mm512_maskz_broadcast_f32x4(ALL, c3);
+
+        for (std::size_t i = 0; i < count; i += 4) {
+            const __mmask16 mask = (count - i >= 4) ? 0xFFFF : static_cast<__mmask16>((1u << ((count - i) * 4)) - 1);
+
+            const __m512 v = _mm512_maskz_loadu_ps(mask, in + i * 4);
+
+            __m512 acc = _mm512_mul_ps(w0, _mm512_maskz_permute_ps(ALL, v, 0x00));
+            acc = _mm512_fmadd_ps(w1, _mm512_maskz_permute_ps(ALL, v, 0x55), acc);
+            acc = _mm512_fmadd_ps(w2, _mm512_maskz_permute_ps(ALL, v, 0xAA), acc);
+            acc = _mm512_fmadd_ps(w3, _mm512_maskz_permute_ps(ALL, v, 0xFF), acc);
+
+            _mm512_mask_storeu_ps(out + i * 4, mask, acc);
+        }
+    }
+    inline void Dispatch::AVX512::multiply(const float* a, const float* b, float* out, std::size_t count) noexcept {
+        for (std::size_t i = 0; i < count * 16; i += 16) {
+            const __m512 r = _mm512_loadu_ps(a + i);
+
+            // every row of a against each row of b at once
+            __m512 acc = _mm512_mul_ps(_mm512_maskz_permute_ps(ALL, r, 0x00), _mm512_maskz_broadcast_f32x4(ALL, _mm_loadu_ps(b + i)));
+            acc = _mm512_fmadd_ps(_mm512_maskz_permute_ps(ALL, r, 0x55), _mm512_maskz_broadcast_f32x4(ALL, _mm_loadu_ps(b + i + 4)),  acc);
+            acc = _mm512_fmadd_ps(_mm512_maskz_permute_ps(ALL, r, 0xAA), _mm512_maskz_broadcast_f32x4(ALL, _mm_loadu_ps(b + i + 8)),  acc);
+            acc = _mm512_fmadd_ps(_mm512_maskz_permute_ps(ALL, r, 0xFF), _mm512_maskz_broadcast_f32x4(ALL, _mm_loadu_ps(b + i + 12)), acc);
+
+            _mm512_storeu_ps(out + i, acc);
+        }
+    }
+#endif
\ No newline at end of file
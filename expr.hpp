@@ -0,0 +1,152 @@
+#pragma once
+
+#include "base.hpp"
+#include "typeHandler.hpp"
+
+// Lazy lane-wise arithmetic over Vec / Mat. Wrap the operands with lazy(), combine them
+// with + - * / and assign the result to a Vec or Mat: every lane is computed in one pass
+// straight into the destination, without the temporaries of the eager operators.
+//
+//     pos = lazy(pos) + lazy(vel) * dt + lazy(acc) * (dt * dt / 2);
+//
+// At -O2 GCC already drops the temporaries of small Vec updates, lazy() pays for multi term Mat
+// blends (benchmark/expr.cpp). Without inlining (-Og) the expression calls cost more than they save.
+//
+// Every step is converted to the type of its left operand, as the eager operators do, so the
+// lanes come out exactly as the eager expression would compute them (integers truncate).
+// Leaves refer to their operands, so an expression must not outlive the full statement.
+// Vec / Mat operator=(const Expr&) read every lane before writing one, so the destination may
+// appear in its own expression (v = lazy(v) * 2 + lazy(w)).
+template <typename E>
+class Expr {
+    public:
+        inline constexpr auto operator[](const unsigned int& idx) const noexcept { return static_cast<const E&>(*this)[idx]; }
+};
+
+template <typename T, unsigned int DIM>
+class ExprVec: public Expr<ExprVec<T, DIM>> {
+    public:
+        using Type = T;
+
+        // a column
+        inline static constexpr unsigned int ROWS = DIM;
+        inline static constexpr unsigned int COLS = 1;
+        inline static constexpr unsigned int LANES = DIM;
+
+        explicit constexpr ExprVec(const Vec<T, DIM>& v) noexcept: mVec{v} { }
+
+        inline constexpr T operator[](const unsigned int& idx) const noexcept { return mVec[idx]; }
+
+    private:
+        const Vec<T, DIM>& mVec;
+};
+
+template <typename T, unsigned int ROW, unsigned int COL>
+class ExprMat: public Expr<ExprMat<T, ROW, COL>> {
+    public:
+        using Type = T;
+
+        inline static constexpr unsigned int ROWS = ROW;
+        inline static constexpr unsigned int COLS = COL;
+        inline static constexpr unsigned int LANES = ROW * COL;
+
+        explicit constexpr ExprMat(const Mat<T, ROW, COL>& m) noexcept: mMat{m} { }
+
+        // row-major lanes, through the rows (separate Vec objects)
+        inline constexpr T operator[](const unsigned int& idx) const noexcept { return mMat.mROW[idx / COL][idx % COL]; }
+
+    private:
+        const Mat<T, ROW, COL>& mMat;
+};
+
+template <typename L, typename R, typename OP>
+class ExprBinary: public Expr<ExprBinary<L, R, OP>> {
+    public:
+        static_assert((L::ROWS == R::ROWS) && (L::COLS == R::COLS), "operands of different shapes");
+
+        using Type = typename L::Type;
+
+        inline static constexpr unsigned int ROWS = L::ROWS;
+        inline static constexpr unsigned int COLS = L::COLS;
+        inline static constexpr unsigned int LANES = L::LANES;
+
+        constexpr ExprBinary(const L& l, const R& r) noexcept: mL{l}, mR{r} { }
+
+        inline constexpr Type operator[](const unsigned int& idx) const noexcept { return static_cast<Type>(OP::apply(mL[idx], mR[idx])); }
+
+    private:
+        const L mL;
+        const R mR;
+};
+
+// every lane of L against the same scalar
+template <typename L, typename U, typename OP>
+class ExprScalar: public Expr<ExprScalar<L, U, OP>> {
+    public:
+        using Type = typename L::Type;
+
+        inline static constexpr unsigned int ROWS = L::ROWS;
+        inline static constexpr unsigned int COLS = L::COLS;
+        inline static constexpr unsigned int LANES = L::LANES;
+
+        constexpr ExprScalar(const L& l, const U& val) noexcept: mL{l}, mVal{val} { }
+
+        inline constexpr Type operator[](const unsigned int& idx) const noexcept { return static_cast<Type>(OP::apply(mL[idx], mVal)); }
+
+    private:
+        const L mL;
+        const U mVal;
+};
+
+template <typename L>
+class ExprNegate: public Expr<ExprNegate<L>> {
+    public:
+        using Type = typename L::Type;
+
+        inline static constexpr unsigned int ROWS = L::ROWS;
+        inline static constexpr unsigned int COLS = L::COLS;
+        inline static constexpr unsigned int LANES = L::LANES;
+
+        explicit constexpr ExprNegate(const L& l) noexcept: mL{l} { }
+
+        inline constexpr Type operator[](const unsigned int& idx) const noexcept { return static_cast<Type>(-mL[idx]); }
+
+    private:
+        const L mL;
+};
+
+class ExprOP {
+    ExprOP() = delete;
+    ExprOP(const ExprOP&) = delete;
+    ExprOP(ExprOP&&) noexcept = delete;
+    ~ExprOP() noexcept = delete;
+
+    ExprOP& operator=(const ExprOP&) = delete;
+    ExprOP& operator=(ExprOP&&) noexcept = delete;
+
+    public:
+        struct Add { template <typename A, typename B> inline static constexpr auto apply(const A& a, const B& b) noexcept { return a + b; } };
+        struct Sub { template <typename A, typename B> inline static constexpr auto apply(const A& a, const B& b) noexcept { return a - b; } };
+        struct Mul { template <typename A, typename B> inline static constexpr auto apply(const A& a, const B& b) noexcept { return a * b; } };
+        struct Div { template <typename A, typename B> inline static constexpr auto apply(const A& a, const B& b) noexcept { return a / b; } };
+};
+
+template <typename T, unsigned int DIM>
+inline constexpr ExprVec<T, DIM> lazy(const Vec<T, DIM>& v) noexcept { return ExprVec<T, DIM>{ v }; }
+template <typename T, unsigned int ROW, unsigned int COL>
+inline constexpr ExprMat<T, ROW, COL> lazy(const Mat<T, ROW, COL>& m) noexcept { return ExprMat<T, ROW, COL>{ m }; }
+
+template <typename L, typename R>
+inline constexpr ExprBinary<L, R, ExprOP::Add> operator+(const Expr<L>& l, const Expr<R>& r) noexcept { return { static_cast<const L&>(l), static_cast<const R&>(r) }; }
+template <typename L, typename R>
+inline constexpr ExprBinary<L, R, ExprOP::Sub> operator-(const Expr<L>& l, const Expr<R>& r) noexcept { return { static_cast<const L&>(l), static_cast<const R&>(r) }; }
+
+template <typename L, typename U, typename = enableIF<isArithmetic<U>>>
+inline constexpr ExprScalar<L, U, ExprOP::Mul> operator*(const Expr<L>& l, const U& val) noexcept { return { static_cast<const L&>(l), val }; }
+template <typename L, typename U, typename = enableIF<isArithmetic<U>>>
+inline constexpr ExprScalar<L, U, ExprOP::Mul> operator*(const U& val, const Expr<L>& l) noexcept { return { static_cast<const L&>(l), val }; }
+template <typename L, typename U, typename = enableIF<isArithmetic<U>>>
+inline constexpr ExprScalar<L, U, ExprOP::Div> operator/(const Expr<L>& l, const U& val) noexcept { return { static_cast<const L&>(l), val }; }
+
+template <typename L>
+inline constexpr ExprNegate<L> operator-(const Expr<L>& l) noexcept { return ExprNegate<L>{ static_cast<const L&>(l) }; }
\ No newline at end of file
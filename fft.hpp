@@ -0,0 +1,643 @@
+#pragma once
+
+#include "./complex.hpp"
+#include "./math.hpp"
+#include "./parallel.hpp"
+#include "./typeHandler.hpp"
+
+#include <cassert>      // assert()
+#include <condition_variable> // condition_variable
+#include <cstddef>      // size_t
+#include <map>          // map
+#include <memory>       // unique_ptr, make_unique()
+#include <mutex>        // mutex, lock_guard, unique_lock
+#include <vector>       // vector
+
+// Discrete Fourier transform of n contiguous Complex<T>, X[k] = sum x[j] e^(-2 pi i j k / n).
+// A plan factors n into radix 4 / 2 / 3 / 5 / generic passes of a Stockham autosort FFT: no bit
+// reversal, each pass reads one buffer and writes the other (out and a work buffer: the caller's
+// or a per-thread scratch, grown on a thread's first transform of a size),
+// every twiddle precomputed. A prime factor above MAX_RADIX runs Bluestein's chirp-z around
+// the plan of a power of two instead. Large transforms are split across threads, started once per
+// transform and synchronized between passes.
+//
+// inverse() is scaled by 1 / n, inverse(forward(x)) == x.
+template <typename T>
+class FFT {
+    static_assert(isFloat<T>);
+
+    public:
+        // largest prime factor run as a generic butterfly, a larger one goes through Bluestein
+        inline static constexpr std::size_t MAX_RADIX = 64;
+        // smallest share of points a transform thread handles
+        inline static constexpr std::size_t MIN_PER_THREAD = 1 << 15;
+
+    public:
+        explicit FFT(const std::size_t& n);
+        FFT(const FFT<T>&) = default;
+        FFT(FFT<T>&&) noexcept = default;
+        ~FFT() noexcept = default;
+
+        FFT<T>& operator=(const FFT<T>&) = default;
+        FFT<T>& operator=(FFT<T>&&) noexcept = default;
+
+        // the plan of n points, built once per size and shared by every thread
+        static const FFT<T>& plan(const std::size_t& n);
+
+        inline std::size_t size() const noexcept;
+        // points of work buffer any transform of this plan needs
+        inline std::size_t workSize() const noexcept;
+
+        // n points, out may be in, threads = 0 uses every hardware thread.
+        // work: workSize() points instead of the per-thread scratch, so the transform allocates nothing
+        void forward(const Complex<T>* in, Complex<T>* out, const unsigned int& threads = 0, Complex<T>* work = nullptr) const;
+        void inverse(const Complex<T>* in, Complex<T>* out, const unsigned int& threads = 0, Complex<T>* work = nullptr) const;
+
+        // real input: the n / 2 + 1 bins X[0, n / 2], the rest are their conjugates.
+        // An even n runs the complex plan of n / 2 on the packed pairs
+        void forward(const T* in, Complex<T>* out, const unsigned int& threads = 0, Complex<T>* work = nullptr) const;
+        // n / 2 + 1 bins back to n real points (out must not overlap in)
+        void inverse(const Complex<T>* in, T* out, const unsigned int& threads = 0, Complex<T>* work = nullptr) const;
+
+    private:
+        // length points left to split, stride = product of the radices before
+        struct Pass {
+            std::size_t radix;
+            std::size_t length;
+            std::size_t stride;
+            // (radix - 1) twiddles per butterfly column, then radix roots for a generic radix
+            std::size_t twiddle;
+            std::size_t root;
+        };
+        // the workers of one transform meet here after every pass
+        struct Barrier {
+            std::mutex lock;
+            std::condition_variable done;
+            unsigned int count;
+            unsigned int waiting;
+            std::size_t round;
+
+            void wait();
+        };
+
+        template <bool INVERSE> void transform(const Complex<T>* in, Complex<T>* out, const unsigned int& threads, Complex<T>* work) const;
+        template <bool INVERSE> void bluestein(const Complex<T>* in, Complex<T>* out, const unsigned int& threads, Complex<T>* work) const;
+        // part of parts of one pass x -> y: a share of the butterfly columns (or of the strided lanes of a late pass)
+        template <bool INVERSE> void run(const Pass&, const Complex<T>* x, Complex<T>* y, const unsigned int& part, const unsigned int& parts) const noexcept;
+        // columns [i0, i1) x lanes [q0, q1) of one pass
+        template <bool INVERSE> void butterflies(const Pass&, const Complex<T>* x, Complex<T>* y, const std::size_t& i0, const std::size_t& i1, const std::size_t& q0, const std::size_t& q1) const noexcept;
+
+        // e^(-2 pi i k / n)
+        static inline Complex<T> unit(const std::size_t& k, const std::size_t& n) noexcept;
+        // the conjugate of a forward twiddle for the inverse
+        template <bool INVERSE> static inline Complex<T> twiddle(const Complex<T>&) noexcept;
+        // -i z forward, i z inverse
+        template <bool INVERSE> static inline Complex<T> rotate(const Complex<T>&) noexcept;
+        static inline Complex<T> scale(const Complex<T>&, const T&) noexcept;
+
+        // per-thread buffers: 0 the Stockham ping-pong, 1 Bluestein, 2 an odd real transform
+        static Complex<T>* scratch(const unsigned int& slot, const std::size_t& count);
+
+    private:
+        std::size_t mSize{ };
+        std::size_t mWork{ };
+        std::vector<Pass> mPasses;
+        std::vector<Complex<T>> mTwiddles;
+        // real transforms: e^(-2 pi i k / n), k <= n / 4, and for an even n the plan of n / 2
+        std::vector<Complex<T>> mHalf;
+        const FFT<T>* mHalfPlan{ };
+
+        // Bluestein: the power of two plan of the convolution, e^(-pi i k^2 / n), the transformed kernel
+        const FFT<T>* mConvolution{ };
+        std::vector<Complex<T>> mChirp;
+        std::vector<Complex<T>> mKernel;
+};
+
+template <typename T>
+FFT<T>::FFT(const std::size_t& n)
+    : mSize{n} {
+    assert(n > 0);
+
+    // radix 4 first, one 2 left over at most, then the odd primes
+    std::vector<std::size_t> radices;
+    std::size_t rest = n;
+
+    while (rest % 4 == 0) {
+        radices.push_back(4);
+        rest /= 4;
+    }
+    if (rest % 2 == 0) {
+        radices.push_back(2);
+        rest /= 2;
+    }
+    for (std::size_t p = 3; p * p <= rest; p += 2) {
+        while (rest % p == 0) {
+            radices.push_back(p);
+            rest /= p;
+        }
+    }
+    if (rest > 1)
+        radices.push_back(rest);
+
+    if (n % 2 == 0) {
+        for (std::size_t k = 0; k <= n / 4; ++k)
+            mHalf.push_back(unit(k, n));
+
+        mHalfPlan = &plan(n / 2);
+    }
+
+    // the primes come out ascending, back() is the largest
+    if (!radices.empty() && radices.back() > MAX_RADIX) {
+        std::size_t m = 1;
+        while (m < 2 * n - 1)
+            m *= 2;
+
+        mConvolution = &plan(m);
+
+        mChirp.resize(n);
+        for (std::size_t k = 0; k < n; ++k)
+            mChirp[k] = unit(k * k % (2 * n), 2 * n);
+
+        mKernel.assign(m, Complex<T>{ });
+        for (std::size_t k = 0; k < n; ++k) {
+            mKernel[k] = mChirp[k].conjugate();
+
+            if (k > 0)
+                mKernel[m - k] = mKernel[k];
+        }
+
+        mConvolution->forward(mKernel.data(), mKernel.data(), 1);
+
+        // the convolution buffer, then the convolution plan's own work
+        mWork = m + mConvolution->workSize();
+    }
+    else {
+        std::size_t length = n;
+        std::size_t stride = 1;
+
+        for (const std::size_t& p: radices) {
+            Pass pass{ p, length, stride, mTwiddles.size(), 0 };
+
+            for (std::size_t i = 0; i < length / p; ++i)
+                for (std::size_t j = 1; j < p; ++j)
+                    mTwiddles.push_back(unit(i * j, length));
+
+            if (p > 5) {
+                pass.root = mTwiddles.size();
+
+                for (std::size_t r = 0; r < p; ++r)
+                    mTwiddles.push_back(unit(r, p));
+            }
+
+            mPasses.push_back(pass);
+
+            length /= p;
+            stride *= p;
+        }
+
+        mWork = n;
+    }
+
+    // an odd real transform: the full complex copy in front; an even one runs the plan of n / 2
+    if (n % 2 == 1)
+        mWork += n;
+    else if (mHalfPlan->workSize() > mWork)
+        mWork = mHalfPlan->workSize();
+}
+
+template <typename T>
+const FFT<T>& FFT<T>::plan(const std::size_t& n) {
+    static std::mutex lock;
+    static std::map<std::size_t, std::unique_ptr<FFT<T>>> plans;
+
+    {
+        const std::lock_guard<std::mutex> guard(lock);
+
+        const auto found = plans.find(n);
+        if (found != plans.end())
+            return *found->second;
+    }
+
+    // built unlocked, a Bluestein plan asks for its convolution plan
+    std::unique_ptr<FFT<T>> made = std::make_unique<FFT<T>>(n);
+
+    const std::lock_guard<std::mutex> guard(lock);
+
+    std::unique_ptr<FFT<T>>& slot = plans[n];
+    if (!slot)
+        slot.reset(made.release());
+
+    return *slot;
+}
+
+template <typename T> inline std::size_t FFT<T>::size() const noexcept { return mSize; }
+template <typename T> inline std::size_t FFT<T>::workSize() const noexcept { return mWork; }
+
+template <typename T>
+void FFT<T>::forward(const Complex<T>* in, Complex<T>* out, const unsigned int& threads, Complex<T>* work) const { transform<false>(in, out, threads, work); }
+template <typename T>
+void FFT<T>::inverse(const Complex<T>* in, Complex<T>* out, const unsigned int& threads, Complex<T>* work) const { transform<true>(in, out, threads, work); }
+
+template <typename T>
+void FFT<T>::forward(const T* in, Complex<T>* out, const unsigned int& threads, Complex<T>* work) const {
+    const std::size_t h = mSize / 2;
+
+    if (mSize % 2 == 1) {
+        Complex<T>* full = (work != nullptr) ? work : scratch(2, mSize);
+
+        for (std::size_t j = 0; j < mSize; ++j)
+            full[j] = Complex<T>(in[j], static_cast<T>(0));
+
+        transform<false>(full, full, threads, (work != nullptr) ? work + mSize : nullptr);
+
+        for (std::size_t k = 0; k <= h; ++k)
+            out[k] = full[k];
+
+        return;
+    }
+
+    // z[j] = x[2 j] + i x[2 j + 1], Z = FFT(z) in out[0, h)
+    mHalfPlan->forward(reinterpret_cast<const Complex<T>*>(in), out, threads, work);
+
+    // X[k] = E + w^k O with E = (Z[k] + Z*[h - k]) / 2, O = -i (Z[k] - Z*[h - k]) / 2,
+    // and X[h - k] = (E - w^k O)*, so k and h - k are done together in place
+    const T half = static_cast<T>(0.5);
+    const Complex<T> z0 = out[0];
+
+    out[0] = Complex<T>(z0.real() + z0.imaginary(), static_cast<T>(0));
+    out[h] = Complex<T>(z0.real() - z0.imaginary(), static_cast<T>(0));
+
+    for (std::size_t k = 1; k <= h - k; ++k) {
+        const Complex<T> zk = out[k];
+        const Complex<T> zm = out[h - k].conjugate();
+
+        const Complex<T> e = scale(zk + zm, half);
+        const Complex<T> o = mHalf[k] * scale(rotate<false>(zk - zm), half);
+
+        out[h - k] = (e - o).conjugate();
+        out[k]     = e + o;
+    }
+}
+template <typename T>
+void FFT<T>::inverse(const Complex<T>* in, T* out, const unsigned int& threads, Complex<T>* work) const {
+    const std::size_t h = mSize / 2;
+
+    if (mSize % 2 == 1) {
+        Complex<T>* full = (work != nullptr) ? work : scratch(2, mSize);
+
+        for (std::size_t k = 0; k <= h; ++k)
+            full[k] = in[k];
+        for (std::size_t k = h + 1; k < mSize; ++k)
+            full[k] = in[mSize - k].conjugate();
+
+        transform<true>(full, full, threads, (work != nullptr) ? work + mSize : nullptr);
+
+        for (std::size_t j = 0; j < mSize; ++j)
+            out[j] = full[j].real();
+
+        return;
+    }
+
+    // Z[k] = E + i O with E = (X[k] + X*[h - k]) / 2, O = (X[k] - X*[h - k]) w^-k / 2, then z = IFFT(Z)
+    Complex<T>* z = reinterpret_cast<Complex<T>*>(out);
+
+    const T half = static_cast<T>(0.5);
+    {
+        const Complex<T> xh = in[h].conjugate();
+
+        z[0] = scale(in[0] + xh, half) + rotate<true>(scale(in[0] - xh, half));
+    }
+
+    for (std::size_t k = 1; k <= h - k; ++k) {
+        const Complex<T> xk = in[k];
+        const Complex<T> xm = in[h - k].conjugate();
+
+        const Complex<T> e = scale(xk + xm, half);
+        const Complex<T> o = mHalf[k].conjugate() * scale(xk - xm, half);
+
+        z[h - k] = e.conjugate() + rotate<true>(o.conjugate());
+        z[k]     = e + rotate<true>(o);
+    }
+
+    mHalfPlan->inverse(z, z, threads, work);
+}
+
+template <typename T> template <bool INVERSE>
+void FFT<T>::transform(const Complex<T>* in, Complex<T>* out, const unsigned int& threads, Complex<T>* work) const {
+    if (mConvolution != nullptr) {
+        bluestein<INVERSE>(in, out, threads, work);
+
+        return;
+    }
+
+    const std::size_t passes = mPasses.size();
+    if (passes == 0) {
+        out[0] = in[0];
+
+        return;
+    }
+
+    // the last pass has to land in out: pass k writes out when passes - 1 - k is even
+    if (work == nullptr)
+        work = scratch(0, mSize);
+
+    const Complex<T>* x = in;
+
+    if (in == out && passes % 2 == 1) {
+        for (std::size_t j = 0; j < mSize; ++j)
+            work[j] = in[j];
+
+        x = work;
+    }
+
+    const unsigned int count = Parallel::workers(threads, mSize, MIN_PER_THREAD);
+    const Complex<T>* source = x;
+
+    // every part of pass k written before any part of pass k + 1 reads it
+    const auto all = [&](const unsigned int& part, Barrier* sync) {
+        const Complex<T>* a = source;
+
+        for (std::size_t k = 0; k < passes; ++k) {
+            Complex<T>* b = ((passes - 1 - k) % 2 == 0) ? out : work;
+
+            run<INVERSE>(mPasses[k], a, b, part, count);
+            a = b;
+
+            if (sync != nullptr)
+                sync->wait();
+        }
+    };
+
+    if (count == 1)
+        all(0, nullptr);
+    else {
+        Barrier sync{ {}, {}, count, 0, 0 };
+
+        Parallel::run(count, [&](const unsigned int& t) { all(t, &sync); });
+    }
+
+    if constexpr (INVERSE) {
+        const T inv = static_cast<T>(1) / static_cast<T>(mSize);
+
+        for (std::size_t j = 0; j < mSize; ++j)
+            out[j] = scale(out[j], inv);
+    }
+}
+template <typename T> template <bool INVERSE>
+void FFT<T>::bluestein(const Complex<T>* in, Complex<T>* out, const unsigned int& threads, Complex<T>* work) const {
+    // X[k] = c[k] sum x[j] c[j] c*[k - j] with c[k] = e^(-pi i k^2 / n): a circular convolution
+    // of m >= 2 n - 1 points. The inverse is the conjugate of the forward of the conjugate
+    const std::size_t m = mConvolution->size();
+    Complex<T>* a = (work != nullptr) ? work : scratch(1, m);
+    Complex<T>* rest = (work != nullptr) ? work + m : nullptr;
+
+    for (std::size_t j = 0; j < mSize; ++j)
+        a[j] = (INVERSE ? in[j].conjugate() : in[j]) * mChirp[j];
+    for (std::size_t j = mSize; j < m; ++j)
+        a[j] = Complex<T>{ };
+
+    mConvolution->forward(a, a, threads, rest);
+
+    for (std::size_t j = 0; j < m; ++j)
+        a[j] = a[j] * mKernel[j];
+
+    mConvolution->inverse(a, a, threads, rest);
+
+    if constexpr (INVERSE) {
+        const T inv = static_cast<T>(1) / static_cast<T>(mSize);
+
+        for (std::size_t k = 0; k < mSize; ++k)
+            out[k] = scale((a[k] * mChirp[k]).conjugate(), inv);
+    }
+    else {
+        for (std::size_t k = 0; k < mSize; ++k)
+            out[k] = a[k] * mChirp[k];
+    }
+}
+
+template <typename T> template <bool INVERSE>
+void FFT<T>::run(const Pass& pass, const Complex<T>* x, Complex<T>* y, const unsigned int& part, const unsigned int& parts) const noexcept {
+    const std::size_t columns = pass.length / pass.radix;
+
+    // early passes have many columns of few lanes, late ones few columns of many lanes
+    const bool byColumn = (columns >= parts);
+    const std::size_t range = byColumn ? columns : pass.stride;
+
+    const std::size_t begin = range * part / parts;
+    const std::size_t end = range * (part + 1) / parts;
+
+    if (byColumn)
+        butterflies<INVERSE>(pass, x, y, begin, end, 0, pass.stride);
+    else
+        butterflies<INVERSE>(pass, x, y, 0, columns, begin, end);
+}
+
+template <typename T> template <bool INVERSE>
+void FFT<T>::butterflies(const Pass& pass, const Complex<T>* x, Complex<T>* y, const std::size_t& i0, const std::size_t& i1, const std::size_t& q0, const std::size_t& q1) const noexcept {
+    // column i, lane q: a[k] = x[q + s (i + k m)], y[q + s (p i + j)] = w^(i j) DFT_p(a)[j]
+    const std::size_t p = pass.radix;
+    const std::size_t s = pass.stride;
+    const std::size_t m = pass.length / p;
+    const std::size_t sm = s * m;
+
+    const Complex<T>* tw = mTwiddles.data() + pass.twiddle;
+
+    switch (p) {
+        case 2:
+            for (std::size_t i = i0; i < i1; ++i) {
+                const Complex<T> w1 = twiddle<INVERSE>(tw[i]);
+
+                const Complex<T>* a = x + s * i;
+                Complex<T>* b = y + s * 2 * i;
+
+                for (std::size_t q = q0; q < q1; ++q) {
+                    const Complex<T> a0 = a[q];
+                    const Complex<T> a1 = a[q + sm];
+
+                    b[q]     = a0 + a1;
+                    b[q + s] = (a0 - a1) * w1;
+                }
+            }
+            break;
+
+        case 3: {
+            // DFT_3: u = a0 - (a1 + a2) / 2, v = -i sin(2 pi / 3) (a1 - a2)
+            const T half = static_cast<T>(0.5);
+            const T sin3 = static_cast<T>(0.866'025'403'784'438'6);
+
+            for (std::size_t i = i0; i < i1; ++i) {
+                const Complex<T> w1 = twiddle<INVERSE>(tw[2 * i]);
+                const Complex<T> w2 = twiddle<INVERSE>(tw[2 * i + 1]);
+
+                const Complex<T>* a = x + s * i;
+                Complex<T>* b = y + s * 3 * i;
+
+                for (std::size_t q = q0; q < q1; ++q) {
+                    const Complex<T> a0 = a[q];
+                    const Complex<T> a1 = a[q + sm];
+                    const Complex<T> a2 = a[q + 2 * sm];
+
+                    const Complex<T> t = a1 + a2;
+                    const Complex<T> u = a0 - scale(t, half);
+                    const Complex<T> v = scale(rotate<INVERSE>(a1 - a2), sin3);
+
+                    b[q]         = a0 + t;
+                    b[q + s]     = (u + v) * w1;
+                    b[q + 2 * s] = (u - v) * w2;
+                }
+            }
+            break;
+        }
+
+        case 4:
+            for (std::size_t i = i0; i < i1; ++i) {
+                const Complex<T> w1 = twiddle<INVERSE>(tw[3 * i]);
+                const Complex<T> w2 = twiddle<INVERSE>(tw[3 * i + 1]);
+                const Complex<T> w3 = twiddle<INVERSE>(tw[3 * i + 2]);
+
+                const Complex<T>* a = x + s * i;
+                Complex<T>* b = y + s * 4 * i;
+
+                for (std::size_t q = q0; q < q1; ++q) {
+                    const Complex<T> a0 = a[q];
+                    const Complex<T> a1 = a[q + sm];
+                    const Complex<T> a2 = a[q + 2 * sm];
+                    const Complex<T> a3 = a[q + 3 * sm];
+
+                    const Complex<T> t0 = a0 + a2;
+                    const Complex<T> t1 = a0 - a2;
+                    const Complex<T> t2 = a1 + a3;
+                    const Complex<T> t3 = rotate<INVERSE>(a1 - a3);
+
+                    b[q]         = t0 + t2;
+                    b[q + s]     = (t1 + t3) * w1;
+                    b[q + 2 * s] = (t0 - t2) * w2;
+                    b[q + 3 * s] = (t1 - t3) * w3;
+                }
+            }
+            break;
+
+        case 5: {
+            // DFT_5 from the pairs a1 +- a4, a2 +- a3 and cos / sin of 2 pi / 5, 4 pi / 5
+            const T c1 = static_cast<T>( 0.309'016'994'374'947'4);
+            const T c2 = static_cast<T>(-0.809'016'994'374'947'4);
+            const T s1 = static_cast<T>( 0.951'056'516'295'153'6);
+            const T s2 = static_cast<T>( 0.587'785'252'292'473'1);
+
+            for (std::size_t i = i0; i < i1; ++i) {
+                const Complex<T> w1 = twiddle<INVERSE>(tw[4 * i]);
+                const Complex<T> w2 = twiddle<INVERSE>(tw[4 * i + 1]);
+                const Complex<T> w3 = twiddle<INVERSE>(tw[4 * i + 2]);
+                const Complex<T> w4 = twiddle<INVERSE>(tw[4 * i + 3]);
+
+                const Complex<T>* a = x + s * i;
+                Complex<T>* b = y + s * 5 * i;
+
+                for (std::size_t q = q0; q < q1; ++q) {
+                    const Complex<T> a0 = a[q];
+                    const Complex<T> a1 = a[q + sm];
+                    const Complex<T> a2 = a[q + 2 * sm];
+                    const Complex<T> a3 = a[q + 3 * sm];
+                    const Complex<T> a4 = a[q + 4 * sm];
+
+                    const Complex<T> t1 = a1 + a4;
+                    const Complex<T> t2 = a2 + a3;
+                    const Complex<T> t3 = a1 - a4;
+                    const Complex<T> t4 = a2 - a3;
+
+                    const Complex<T> e1 = a0 + scale(t1, c1) + scale(t2, c2);
+                    const Complex<T> e2 = a0 + scale(t1, c2) + scale(t2, c1);
+                    const Complex<T> o1 = rotate<INVERSE>(scale(t3, s1) + scale(t4, s2));
+                    const Complex<T> o2 = rotate<INVERSE>(scale(t3, s2) - scale(t4, s1));
+
+                    b[q]         = a0 + t1 + t2;
+                    b[q + s]     = (e1 + o1) * w1;
+                    b[q + 2 * s] = (e2 + o2) * w2;
+                    b[q + 3 * s] = (e2 - o2) * w3;
+                    b[q + 4 * s] = (e1 - o1) * w4;
+                }
+            }
+            break;
+        }
+
+        default: {
+            // any other prime up to MAX_RADIX: p^2 multiplies against the roots e^(-2 pi i r / p)
+            Complex<T> root[MAX_RADIX];
+            Complex<T> in[MAX_RADIX];
+
+            for (std::size_t r = 0; r < p; ++r)
+                root[r] = twiddle<INVERSE>(mTwiddles[pass.root + r]);
+
+            for (std::size_t i = i0; i < i1; ++i) {
+                const Complex<T>* w = tw + (p - 1) * i;
+
+                const Complex<T>* a = x + s * i;
+                Complex<T>* b = y + s * p * i;
+
+                for (std::size_t q = q0; q < q1; ++q) {
+                    for (std::size_t k = 0; k < p; ++k)
+                        in[k] = a[q + k * sm];
+
+                    for (std::size_t j = 0; j < p; ++j) {
+                        Complex<T> sum = in[0];
+
+                        for (std::size_t k = 1, r = j; k < p; ++k, r = (r + j >= p) ? r + j - p : r + j)
+                            sum += in[k] * root[r];
+
+                        b[q + j * s] = (j == 0) ? sum : sum * twiddle<INVERSE>(w[j - 1]);
+                    }
+                }
+            }
+            break;
+        }
+    }
+}
+
+template <typename T>
+inline Complex<T> FFT<T>::unit(const std::size_t& k, const std::size_t& n) noexcept {
+    // in double whatever T is, the angle kept in [0, 2 pi)
+    double s, c;
+    Math::sincos(-2.0 * Math::PI<double> * static_cast<double>(k % n) / static_cast<double>(n), s, c);
+
+    return Complex<T>(static_cast<T>(c), static_cast<T>(s));
+}
+template <typename T> template <bool INVERSE>
+inline Complex<T> FFT<T>::twiddle(const Complex<T>& w) noexcept {
+    if constexpr (INVERSE)
+        return w.conjugate();
+    else
+        return w;
+}
+template <typename T> template <bool INVERSE>
+inline Complex<T> FFT<T>::rotate(const Complex<T>& z) noexcept {
+    if constexpr (INVERSE)
+        return Complex<T>(-z.imaginary(), z.real());
+    else
+        return Complex<T>(z.imaginary(), -z.real());
+}
+template <typename T>
+inline Complex<T> FFT<T>::scale(const Complex<T>& z, const T& val) noexcept { return Complex<T>(z.real() * val, z.imaginary() * val); }
+
+template <typename T>
+Complex<T>* FFT<T>::scratch(const unsigned int& slot, const std::size_t& count) {
+    thread_local std::vector<Complex<T>> buffers[3];
+
+    if (buffers[slot].size() < count)
+        buffers[slot].resize(count);
+
+    return buffers[slot].data();
+}
+template <typename T>
+void FFT<T>::Barrier::wait() {
+    std::unique_lock<std::mutex> guard(lock);
+
+    const std::size_t mine = round;
+    if (++waiting == count) {
+        waiting = 0;
+        ++round;
+
+        done.notify_all();
+    }
+    else
+        done.wait(guard, [&] { return round != mine; });
+}
\ No newline at end of file
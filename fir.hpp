@@ -0,0 +1,244 @@
+#pragma once
+
+#include "./complex.hpp"
+#include "./fft.hpp"
+#include "./simd.hpp"
+#include "./typeHandler.hpp"
+
+#include <cassert>      // assert()
+#include <cstddef>      // size_t
+#include <vector>       // vector
+
+// Streaming FIR filter over Complex<T> samples, y[n] = sum h[k] x[n - k], the stream fed in
+// chunks of any length. A short filter runs DIRECT: the taps reversed into split planes, every
+// output four SIMD dot products over a sliding window. A long one runs FREQUENCY, overlap-save:
+// blocks of L new samples behind the last taps - 1 go through an FFT of N = L + taps - 1, are
+// multiplied by the transformed taps and transformed back, the first taps - 1 outputs (wrapped
+// around) dropped. FREQUENCY delays the stream by latency() = L samples.
+//
+// Every buffer is sized by the constructor, the FFT's work buffer included (the plan's per-thread
+// scratch is not used), so process() allocates nothing on any thread.
+template <typename T>
+class FIR {
+    static_assert(isFloat<T>);
+
+    public:
+        enum class Mode: unsigned char { AUTO, DIRECT, FREQUENCY };
+
+        // AUTO runs DIRECT up to this many taps
+        inline static constexpr std::size_t DIRECT_TAPS = 32;
+        // DIRECT outputs per window slide
+        inline static constexpr std::size_t DIRECT_BLOCK = 256;
+
+    public:
+        FIR(const Complex<T>* taps, const std::size_t& count, const Mode& = Mode::AUTO);
+        FIR(const FIR<T>&) = default;
+        FIR(FIR<T>&&) noexcept = default;
+        ~FIR() noexcept = default;
+
+        FIR<T>& operator=(const FIR<T>&) = default;
+        FIR<T>& operator=(FIR<T>&&) noexcept = default;
+
+        // count filtered samples of the stream to out, out may be in
+        void process(const Complex<T>* in, Complex<T>* out, const std::size_t& count) noexcept;
+        // back to a silent history
+        void reset() noexcept;
+
+        inline Mode mode() const noexcept;
+        inline std::size_t taps() const noexcept;
+        // samples in per FFT block (0 for DIRECT)
+        inline std::size_t block() const noexcept;
+        // out[n] holds y[n - latency()]
+        inline std::size_t latency() const noexcept;
+
+    private:
+        void direct(const Complex<T>* in, Complex<T>* out, const std::size_t& count) noexcept;
+        void frequency(const Complex<T>* in, Complex<T>* out, const std::size_t& count) noexcept;
+
+        // the power of two N with (about) the fewest FFT operations per output
+        static std::size_t transformSize(const std::size_t& taps) noexcept;
+
+    private:
+        Mode mMode{ };
+        std::size_t mTaps{ };
+
+        // DIRECT: the taps reversed, then taps - 1 history and DIRECT_BLOCK new samples, split
+        std::vector<T> mTapReal;
+        std::vector<T> mTapImaginary;
+        std::vector<T> mReal;
+        std::vector<T> mImaginary;
+
+        // FREQUENCY: L new samples per block of N
+        const FFT<T>* mPlan{ };
+        std::size_t mBlock{ };
+        std::size_t mFill{ };
+        std::vector<Complex<T>> mResponse;
+        std::vector<Complex<T>> mInput;
+        std::vector<Complex<T>> mSpectrum;
+        std::vector<Complex<T>> mWork;
+        // the filtered previous block, handed out as the next one comes in
+        std::vector<Complex<T>> mOutput;
+};
+
+template <typename T>
+FIR<T>::FIR(const Complex<T>* taps, const std::size_t& count, const Mode& mode)
+    : mMode{mode}, mTaps{count} {
+    assert(taps != nullptr && count > 0);
+
+    if (mMode == Mode::AUTO)
+        mMode = (count <= DIRECT_TAPS) ? Mode::DIRECT : Mode::FREQUENCY;
+
+    if (mMode == Mode::DIRECT) {
+        mTapReal.resize(count);
+        mTapImaginary.resize(count);
+
+        for (std::size_t i = 0; i < count; ++i) {
+            mTapReal[i] = taps[count - 1 - i].real();
+            mTapImaginary[i] = taps[count - 1 - i].imaginary();
+        }
+
+        mReal.assign(count - 1 + DIRECT_BLOCK, T(0));
+        mImaginary.assign(count - 1 + DIRECT_BLOCK, T(0));
+
+        return;
+    }
+
+    const std::size_t n = transformSize(count);
+
+    mPlan = &FFT<T>::plan(n);
+    mBlock = n - count + 1;
+
+    mResponse.assign(n, Complex<T>{ });
+    for (std::size_t i = 0; i < count; ++i)
+        mResponse[i] = taps[i];
+
+    mWork.assign(mPlan->workSize(), Complex<T>{ });
+    mPlan->forward(mResponse.data(), mResponse.data(), 1, mWork.data());
+
+    mInput.assign(n, Complex<T>{ });
+    mSpectrum.assign(n, Complex<T>{ });
+    mOutput.assign(mBlock, Complex<T>{ });
+}
+
+template <typename T>
+void FIR<T>::process(const Complex<T>* in, Complex<T>* out, const std::size_t& count) noexcept {
+    if (mMode == Mode::DIRECT)
+        direct(in, out, count);
+    else
+        frequency(in, out, count);
+}
+
+template <typename T>
+void FIR<T>::reset() noexcept {
+    for (T& val: mReal)
+        val = T(0);
+    for (T& val: mImaginary)
+        val = T(0);
+
+    for (Complex<T>& val: mInput)
+        val = Complex<T>{ };
+    for (Complex<T>& val: mOutput)
+        val = Complex<T>{ };
+
+    mFill = 0;
+}
+
+template <typename T> inline typename FIR<T>::Mode FIR<T>::mode() const noexcept { return mMode; }
+template <typename T> inline std::size_t FIR<T>::taps() const noexcept { return mTaps; }
+template <typename T> inline std::size_t FIR<T>::block() const noexcept { return mBlock; }
+template <typename T> inline std::size_t FIR<T>::latency() const noexcept { return mBlock; }
+
+template <typename T>
+void FIR<T>::direct(const Complex<T>* in, Complex<T>* out, const std::size_t& count) noexcept {
+    const std::size_t history = mTaps - 1;
+
+    const T* hr = mTapReal.data();
+    const T* hi = mTapImaginary.data();
+    T* xr = mReal.data();
+    T* xi = mImaginary.data();
+
+    for (std::size_t i = 0; i < count; i += DIRECT_BLOCK) {
+        const std::size_t k = (count - i < DIRECT_BLOCK) ? count - i : DIRECT_BLOCK;
+
+        // every input of the slide is read before out (which may be in) is written
+        for (std::size_t j = 0; j < k; ++j) {
+            xr[history + j] = in[i + j].real();
+            xi[history + j] = in[i + j].imaginary();
+        }
+
+        for (std::size_t j = 0; j < k; ++j) {
+            const T real = SIMD::dotN(hr, xr + j, mTaps) - SIMD::dotN(hi, xi + j, mTaps);
+            const T imaginary = SIMD::dotN(hr, xi + j, mTaps) + SIMD::dotN(hi, xr + j, mTaps);
+
+            out[i + j] = Complex<T>(real, imaginary);
+        }
+
+        for (std::size_t j = 0; j < history; ++j) {
+            xr[j] = xr[k + j];
+            xi[j] = xi[k + j];
+        }
+    }
+}
+
+template <typename T>
+void FIR<T>::frequency(const Complex<T>* in, Complex<T>* out, const std::size_t& count) noexcept {
+    const std::size_t history = mTaps - 1;
+    const std::size_t n = mPlan->size();
+
+    for (std::size_t i = 0; i < count; ) {
+        const std::size_t k = (count - i < mBlock - mFill) ? count - i : mBlock - mFill;
+
+        for (std::size_t j = 0; j < k; ++j) {
+            mInput[history + mFill + j] = in[i + j];
+            out[i + j] = mOutput[mFill + j];
+        }
+
+        mFill += k;
+        i += k;
+
+        if (mFill < mBlock)
+            continue;
+
+        mPlan->forward(mInput.data(), mSpectrum.data(), 1, mWork.data());
+
+        T* spectrum = reinterpret_cast<T*>(mSpectrum.data());
+        SIMD::complexMulN(spectrum, reinterpret_cast<const T*>(mResponse.data()), spectrum, n);
+
+        mPlan->inverse(mSpectrum.data(), mSpectrum.data(), 1, mWork.data());
+
+        for (std::size_t j = 0; j < mBlock; ++j)
+            mOutput[j] = mSpectrum[history + j];
+
+        // the last taps - 1 inputs stay as the next block's history
+        for (std::size_t j = 0; j < history; ++j)
+            mInput[j] = mInput[mBlock + j];
+
+        mFill = 0;
+    }
+}
+
+template <typename T>
+std::size_t FIR<T>::transformSize(const std::size_t& taps) noexcept {
+    std::size_t n = 1;
+    std::size_t log = 0;
+
+    while (n < 2 * taps) {
+        n *= 2;
+        ++log;
+    }
+
+    // (log2 N + 1) N per N - taps + 1 outputs, a larger N costs memory and latency so it has to save 5%
+    std::size_t best = n;
+    double bestCost = static_cast<double>(n) * static_cast<double>(log + 1) / static_cast<double>(n - taps + 1);
+
+    for (n *= 2, ++log; n <= 64 * taps; n *= 2, ++log) {
+        const double cost = static_cast<double>(n) * static_cast<double>(log + 1) / static_cast<double>(n - taps + 1);
+
+        if (cost < 0.95 * bestCost) {
+            best = n;
+            bestCost = cost;
+        }
+    }
+
+    return best;
+}
\ No newline at end of file
@@ -0,0 +1,196 @@
+#pragma once
+
+#include "./complex.hpp"
+#include "./parallel.hpp"
+#include "./simd.hpp"
+#include "./typeHandler.hpp"
+
+#include <atomic>       // atomic
+#include <cassert>      // assert()
+#include <cstddef>      // size_t
+#include <vector>       // vector
+
+// Escape-time fractals on a width x height grid over [low, high], pixel (x, y) at low + (x dx, y dy).
+// counts[y * width + x] is how many iterations of z = z^2 + c the pixel ran with |z| <= 2 (at most
+// limit), the renders return their sum: total iterations, for iterations per second.
+//
+// SCALAR iterates one Complex<T> at a time with its operators, SIMD runs rows of a tile through
+// SIMD::escapeN (16 points per lane group, stopped once all of them left), THREADED hands the
+// tiles out one at a time from a shared counter, since the cost of a tile ranges from one
+// iteration per pixel to limit.
+template <typename T>
+class Fractal {
+    static_assert(isFloat<T>);
+
+    public:
+        enum class Mode: unsigned char { SCALAR, SIMD, THREADED };
+
+        // tile edge in pixels
+        inline static constexpr std::size_t TILE = 32;
+
+    public:
+        Fractal(const std::size_t& width, const std::size_t& height, const Complex<T>& low, const Complex<T>& high);
+        Fractal(const Fractal<T>&) = default;
+        Fractal(Fractal<T>&&) noexcept = default;
+        ~Fractal() noexcept = default;
+
+        Fractal<T>& operator=(const Fractal<T>&) = default;
+        Fractal<T>& operator=(Fractal<T>&&) noexcept = default;
+
+        // z = 0, c = the pixel
+        unsigned long long mandelbrot(unsigned int* counts, const unsigned int& limit, const Mode& = Mode::THREADED, const unsigned int& threads = 0) const;
+        // z = the pixel, c fixed
+        unsigned long long julia(const Complex<T>& c, unsigned int* counts, const unsigned int& limit, const Mode& = Mode::THREADED, const unsigned int& threads = 0) const;
+
+        inline std::size_t width() const noexcept;
+        inline std::size_t height() const noexcept;
+
+    private:
+        template <bool JULIA> unsigned long long render(const Complex<T>& c, unsigned int* counts, const unsigned int& limit, const Mode&, const unsigned int& threads) const;
+        // one tile, by Complex<T> or by SIMD::escapeN
+        template <bool JULIA> unsigned long long scalar(const Complex<T>& c, unsigned int* counts, const unsigned int& limit, const std::size_t& tile) const noexcept;
+        template <bool JULIA> unsigned long long lanes(const Complex<T>& c, unsigned int* counts, const unsigned int& limit, const std::size_t& tile) const noexcept;
+
+        inline Complex<T> point(const std::size_t& x, const std::size_t& y) const noexcept;
+
+    private:
+        std::size_t mWidth{ };
+        std::size_t mHeight{ };
+        // tiles per row
+        std::size_t mColumns{ };
+        std::size_t mTiles{ };
+
+        Complex<T> mLow;
+        T mStepX{ };
+        T mStepY{ };
+};
+
+template <typename T>
+Fractal<T>::Fractal(const std::size_t& width, const std::size_t& height, const Complex<T>& low, const Complex<T>& high)
+    : mWidth{width}, mHeight{height}, mLow{low} {
+    assert(width > 0 && height > 0);
+
+    mColumns = (width + TILE - 1) / TILE;
+    mTiles = mColumns * ((height + TILE - 1) / TILE);
+
+    mStepX = (high.real() - low.real()) / static_cast<T>(width);
+    mStepY = (high.imaginary() - low.imaginary()) / static_cast<T>(height);
+}
+
+template <typename T>
+unsigned long long Fractal<T>::mandelbrot(unsigned int* counts, const unsigned int& limit, const Mode& mode, const unsigned int& threads) const {
+    return render<false>(Complex<T>{ }, counts, limit, mode, threads);
+}
+template <typename T>
+unsigned long long Fractal<T>::julia(const Complex<T>& c, unsigned int* counts, const unsigned int& limit, const Mode& mode, const unsigned int& threads) const {
+    return render<true>(c, counts, limit, mode, threads);
+}
+
+template <typename T> inline std::size_t Fractal<T>::width() const noexcept { return mWidth; }
+template <typename T> inline std::size_t Fractal<T>::height() const noexcept { return mHeight; }
+
+template <typename T> template <bool JULIA>
+unsigned long long Fractal<T>::render(const Complex<T>& c, unsigned int* counts, const unsigned int& limit, const Mode& mode, const unsigned int& threads) const {
+    assert(counts != nullptr);
+    // the SIMD lanes count in T
+    assert((!isSame<T, float>) || limit <= (1u << 24));
+
+    unsigned long long total = 0;
+
+    if (mode == Mode::SCALAR) {
+        for (std::size_t tile = 0; tile < mTiles; ++tile)
+            total += scalar<JULIA>(c, counts, limit, tile);
+
+        return total;
+    }
+
+    const unsigned int workers = (mode == Mode::THREADED) ? Parallel::workers(threads, mTiles) : 1;
+
+    std::atomic<std::size_t> next{ 0 };
+    std::vector<unsigned long long> sums(workers, 0);
+
+    // summed locally, the neighbouring slots of sums share a cache line
+    const auto run = [&](const unsigned int& worker) {
+        unsigned long long sum = 0;
+
+        for (std::size_t tile = next++; tile < mTiles; tile = next++)
+            sum += lanes<JULIA>(c, counts, limit, tile);
+
+        sums[worker] = sum;
+    };
+
+    Parallel::run(workers, run);
+
+    for (const unsigned long long& sum: sums)
+        total += sum;
+
+    return total;
+}
+
+template <typename T> template <bool JULIA>
+unsigned long long Fractal<T>::scalar(const Complex<T>& c, unsigned int* counts, const unsigned int& limit, const std::size_t& tile) const noexcept {
+    const std::size_t x0 = tile % mColumns * TILE;
+    const std::size_t y0 = tile / mColumns * TILE;
+    const std::size_t x1 = (x0 + TILE < mWidth) ? x0 + TILE : mWidth;
+    const std::size_t y1 = (y0 + TILE < mHeight) ? y0 + TILE : mHeight;
+
+    unsigned long long total = 0;
+
+    for (std::size_t y = y0; y < y1; ++y) {
+        for (std::size_t x = x0; x < x1; ++x) {
+            const Complex<T> p = point(x, y);
+            const Complex<T> add = JULIA ? c : p;
+
+            Complex<T> z = JULIA ? p : Complex<T>{ };
+            unsigned int n = 0;
+
+            while (n < limit && z.magnitudeSquare() <= 4) {
+                z = z * z + add;
+                ++n;
+            }
+
+            counts[y * mWidth + x] = n;
+            total += n;
+        }
+    }
+
+    return total;
+}
+template <typename T> template <bool JULIA>
+unsigned long long Fractal<T>::lanes(const Complex<T>& c, unsigned int* counts, const unsigned int& limit, const std::size_t& tile) const noexcept {
+    const std::size_t x0 = tile % mColumns * TILE;
+    const std::size_t y0 = tile / mColumns * TILE;
+    const std::size_t x1 = (x0 + TILE < mWidth) ? x0 + TILE : mWidth;
+    const std::size_t y1 = (y0 + TILE < mHeight) ? y0 + TILE : mHeight;
+
+    // the whole tile in one call, a partial group only at its end (an edge tile fills the front)
+    T zr[TILE * TILE]{ }, zi[TILE * TILE]{ }, cr[TILE * TILE]{ }, ci[TILE * TILE]{ };
+    unsigned int tileCounts[TILE * TILE];
+
+    const std::size_t columns = x1 - x0;
+
+    for (std::size_t y = y0; y < y1; ++y) {
+        for (std::size_t x = x0; x < x1; ++x) {
+            const Complex<T> p = point(x, y);
+            const std::size_t i = (y - y0) * columns + (x - x0);
+
+            zr[i] = JULIA ? p.real() : static_cast<T>(0);
+            zi[i] = JULIA ? p.imaginary() : static_cast<T>(0);
+            cr[i] = JULIA ? c.real() : p.real();
+            ci[i] = JULIA ? c.imaginary() : p.imaginary();
+        }
+    }
+
+    const unsigned long long total = SIMD::escapeN(zr, zi, cr, ci, tileCounts, (y1 - y0) * columns, limit);
+
+    for (std::size_t y = y0; y < y1; ++y)
+        for (std::size_t x = x0; x < x1; ++x)
+            counts[y * mWidth + x] = tileCounts[(y - y0) * columns + (x - x0)];
+
+    return total;
+}
+
+template <typename T>
+inline Complex<T> Fractal<T>::point(const std::size_t& x, const std::size_t& y) const noexcept {
+    return Complex<T>(mLow.real() + static_cast<T>(x) * mStepX, mLow.imaginary() + static_cast<T>(y) * mStepY);
+}
\ No newline at end of file
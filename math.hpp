@@ -1,6 +1,12 @@
 #pragma once
 
 #include "base.hpp"
+#include "expr.hpp"
+#include "simd.hpp"
+
+#include <cmath>        // copysign(), signbit(), fabs(), sin(), cos(), atan(), atan2(), exp(), log()
+#include <cstddef>      // size_t
+#include <limits>       // numeric_limits
 
 class Math {
     Math() = delete;
@@ -41,19 +47,232 @@ class Math {
         // Interpolations
         template <typename T1, typename T2, unsigned int DIM>
         inline static constexpr Vec<float, DIM> lerpf(const Vec<T1, DIM>&, const Vec<T2, DIM>&, const float&) noexcept;
+
+    // Trigonometry on float / double radians: reduction by pi/2, then polynomials on [-pi/4, pi/4].
+    // Past RANGE (NaN / inf included) the reduction loses the angle, std::sin / std::cos take over,
+    // as they do for long double
+    public:
+        // PRECISE: within a few ulp of std::sin / std::cos for |x| <= 1e4 (float) / 1e9 (double)
+        // FAST: shorter polynomials, 1.3e-5 absolute error
+        enum class Accuracy: unsigned char { FAST, PRECISE };
+
+        template <Accuracy A = Accuracy::PRECISE, typename T, typename = enableIF<isFloat<T>>>
+        inline static constexpr T sin(const T&) noexcept;
+        template <Accuracy A = Accuracy::PRECISE, typename T, typename = enableIF<isFloat<T>>>
+        inline static constexpr T cos(const T&) noexcept;
+        template <Accuracy A = Accuracy::PRECISE, typename T, typename = enableIF<isFloat<T>>>
+        inline static constexpr T tan(const T&) noexcept;
+        // one reduction for both
+        template <Accuracy A = Accuracy::PRECISE, typename T, typename = enableIF<isFloat<T>>>
+        inline static constexpr void sincos(const T&, T& s, T& c) noexcept;
+
+        // count lanes (float: four per SSE register)
+        template <Accuracy A = Accuracy::PRECISE, typename T, typename = enableIF<isFloat<T>>>
+        inline static void sin(const T* in, T* out, const std::size_t& count) noexcept;
+        template <Accuracy A = Accuracy::PRECISE, typename T, typename = enableIF<isFloat<T>>>
+        inline static void cos(const T* in, T* out, const std::size_t& count) noexcept;
+        template <Accuracy A = Accuracy::PRECISE, typename T, typename = enableIF<isFloat<T>>>
+        inline static void tan(const T* in, T* out, const std::size_t& count) noexcept;
+        template <Accuracy A = Accuracy::PRECISE, typename T, typename = enableIF<isFloat<T>>>
+        inline static void sincos(const T* in, T* s, T* c, const std::size_t& count) noexcept;
+
+    // Arctangent on float / double: |y| / |x| (or its inverse) folded onto [0, 1], above SPLIT moved by
+    // pi/4 through (a - 1) / (a + 1), then a polynomial (float) / rational (double) fit, a few ulp.
+    // atan2(0, 0) and atan2(inf, inf) as std::atan2 (0 / pi/4 with its signs), NaN in NaN out. long double: std::atan / std::atan2
+    public:
+        template <typename T, typename = enableIF<isFloat<T>>>
+        inline static T atan(const T&) noexcept;
+        template <typename T, typename = enableIF<isFloat<T>>>
+        inline static T atan2(const T& y, const T& x) noexcept;
+
+        // count lanes (float: four per SSE register)
+        template <typename T, typename = enableIF<isFloat<T>>>
+        inline static void atan2(const T* y, const T* x, T* out, const std::size_t& count) noexcept;
+
+    // Exponential / logarithm on float / double without libm, a few ulp. exp: x = k ln2 + r, a polynomial
+    // (float) / Pade (double) fit of e^r, scaled by 2^k in two steps so denormal results survive, 0 / inf
+    // past the range of T. log: x = m 2^k, m in [sqrt(1/2), sqrt(2)), log(m) through s = (m - 1) / (m + 1),
+    // log(0) = -inf, log(< 0) = NaN. long double: std::exp / std::log
+    public:
+        template <typename T, typename = enableIF<isFloat<T>>>
+        inline static T exp(const T&) noexcept;
+        template <typename T, typename = enableIF<isFloat<T>>>
+        inline static T log(const T&) noexcept;
+        // sqrt(x^2 + y^2) without squaring past the range of T (overflows only if the result does), inf if x or y is,
+        // even against NaN, else NaN if either is (as std::hypot)
+        template <typename T, typename = enableIF<isFloat<T>>>
+        inline static T hypot(const T& x, const T& y) noexcept;
+
+        // count lanes (float: four per SSE register)
+        template <typename T, typename = enableIF<isFloat<T>>>
+        inline static void exp(const T* in, T* out, const std::size_t& count) noexcept;
+        template <typename T, typename = enableIF<isFloat<T>>>
+        inline static void log(const T* in, T* out, const std::size_t& count) noexcept;
+        template <typename T, typename = enableIF<isFloat<T>>>
+        inline static void hypot(const T* x, const T* y, T* out, const std::size_t& count) noexcept;
+
+    // Inversion of small matrices (Mat, Mat3x4, Mat4), on a copy of their N x N block
+    public:
+        // |det| negligible against the smaller product of the row or column lengths of m (Hadamard bound).
+        // inRange: the bound and EPSILON^2 times it are normal, so det^2 and the bound compare as the ratio they
+        // stand for. Otherwise det, the bound or the inverse may have over- or underflowed: balance m, try again
+        template <unsigned int N, typename T, typename = enableIF<isFloat<T>>>
+        inline static constexpr bool isSingular(const T (&m)[N][N], const T& det, bool& inRange) noexcept;
+        // m scaled to row[i] m[i][j] col[j]: the powers of two that bring the largest |entry| of every row, then
+        // of every column into [0.5, 1) (1 for a zero row / column). Exact, and always in range after, at any
+        // diagonal scale of m, inverse(m) = col inverse(row m col) row
+        template <unsigned int N, typename T, typename = enableIF<isFloat<T>>>
+        inline static constexpr void balance(T (&m)[N][N], T (&row)[N], T (&col)[N]) noexcept;
+        // out = inverse of m through inverse(m, out) -> det, false if isSingular. m is N x C: the columns past N are an
+        // affine part ([L | t], Mat3x4). Out of range, m is balanced and inverted again, out scaled back
+        template <typename T, unsigned int N, unsigned int C>
+        inline static constexpr bool invert(const Mat<T, N, C>& m, Mat<T, N, C>& out, T (*inverse)(const Mat<T, N, C>&, Mat<T, N, C>&)) noexcept;
+
+    private:
+        // sin(r) = r + r z SIN(z), cos(r) = 1 + z COS(z), z = r^2, coefficients highest degree first
+        // PIO2: pi/2 split so that k * PIO2[0] is exact (FAST drops the third part)
+        template <Accuracy A, typename T> struct Trig;
+
+        template <typename T, unsigned int N>
+        inline static constexpr T horner(const T&, const T (&)[N]) noexcept;
+
+        // x - k pi/2, with k mod 4 in quadrant, for |x| <= RANGE
+        template <Accuracy A, typename T>
+        inline static constexpr T reduce(const T& x, int& quadrant) noexcept;
+        template <typename T>
+        inline static constexpr T RANGE = isSame<T, float> ? static_cast<T>(1.0E+04) : static_cast<T>(1.0E+09);
+
+        // atan(r) = r + r z P(z) (float) / r + r z P(z) / Q(z) (double), z = r^2, |r| <= SPLIT
+        template <typename T> struct Atan;
+
+        // atan of a in [0, 1]
+        template <typename T>
+        inline static T atanUnit(const T& a) noexcept;
+
+        // exp(r) = 1 + r + r^2 P(r) (float) / 1 + 2 r P(z) / (Q(z) - r P(z)) (double), z = r^2, |r| <= ln2 / 2
+        // LN2: ln2 split so that k * LN2[0] is exact, MIN / MAX: the inputs clamped to (the results are 0 / inf)
+        template <typename T> struct Exp;
+        // log(m) = f - (f^2 / 2 - s (f^2 / 2 + z P(z))), f = m - 1, s = f / (2 + f), z = s^2
+        // SQRT_HALF: the bits of sqrt(1/2)
+        template <typename T> struct Log;
+
+        // 2^k for a normal exponent k
+        template <typename T>
+        inline static T pow2(const int& k) noexcept;
+        // the power of two p with a p in [0.5, 1) for a normal a > 0 (1 for 0, inf and NaN)
+        template <typename T>
+        inline static constexpr T unitScale(const T& a) noexcept;
+
+        #if defined(MATH_SIMD_SSE)
+            template <unsigned int N>
+            inline static __m128 horner(const __m128&, const float (&)[N]) noexcept;
+
+            template <Accuracy A>
+            inline static void sincos4(const __m128& x, __m128& s, __m128& c) noexcept;
+
+            inline static __m128 atan2x4(const __m128& y, const __m128& x) noexcept;
+
+            inline static __m128 exp4(const __m128& x) noexcept;
+            inline static __m128 log4(const __m128& x) noexcept;
+            inline static __m128 hypot4(const __m128& x, const __m128& y) noexcept;
+        #endif
+};
+
+template <typename T>
+struct Math::Trig<Math::Accuracy::FAST, T> {
+    inline static constexpr T SIN[]  = { static_cast<T>(8.163'279'140'668'299e-3), static_cast<T>(-1.666'339'025'342'456e-1) };
+    inline static constexpr T COS[]  = { static_cast<T>(4.048'891'635'561'762e-2), static_cast<T>(-4.997'762'984'838'056e-1) };
+    inline static constexpr T PIO2[] = { static_cast<T>(1.570'312'5), static_cast<T>(4.838'267'948'966'192e-4) };
+};
+template <>
+struct Math::Trig<Math::Accuracy::PRECISE, float> {
+    inline static constexpr float SIN[]  = { -1.951'529'589'1e-4f, 8.332'160'873'6e-3f, -1.666'665'461'1e-1f };
+    inline static constexpr float COS[]  = { 2.443'315'711'809'948e-5f, -1.388'731'625'493'765e-3f, 4.166'664'568'298'827e-2f, -0.5f };
+    inline static constexpr float PIO2[] = { 1.570'312'5f, 4.837'512'969'970'703'125e-4f, 7.549'789'954'891'882e-8f };
+};
+template <>
+struct Math::Trig<Math::Accuracy::PRECISE, double> {
+    inline static constexpr double SIN[] = {
+         1.589'623'015'765'465'680'60e-10, -2.505'074'776'285'780'728'66e-8,  2.755'731'362'138'572'452'13e-6,
+        -1.984'126'982'958'953'859'96e-4,   8.333'333'333'322'118'588'78e-3, -1.666'666'666'666'663'072'95e-1
+    };
+    inline static constexpr double COS[] = {
+        -1.135'853'652'138'768'173'00e-11,  2.087'570'084'197'473'167'78e-9, -2.755'731'417'929'673'881'12e-7,
+         2.480'158'728'885'170'453'48e-5,  -1.388'888'888'887'305'641'16e-3,  4.166'666'666'666'659'292'18e-2, -0.5
+    };
+    inline static constexpr double PIO2[] = { 1.570'796'251'296'997'070'31, 7.549'789'415'861'596'353'36e-8, 5.390'302'858'158'119'052'90e-15 };
+};
+
+template <>
+struct Math::Atan<float> {
+    inline static constexpr float SPLIT = 0.414'213'562'373'095f;
+    inline static constexpr float P[]   = { 8.053'744'495'38e-2f, -1.387'768'560'32e-1f, 1.997'771'064'78e-1f, -3.333'294'915'39e-1f };
+};
+template <>
+struct Math::Atan<double> {
+    inline static constexpr double SPLIT = 0.66;
+    inline static constexpr double P[]   = {
+        -8.750'608'600'031'904'122'785e-1, -1.615'753'718'733'365'076'637e1, -7.500'855'792'314'704'667'340e1,
+        -1.228'866'684'490'136'173'410e2,  -6.485'021'904'942'025'371'773e1
+    };
+    inline static constexpr double Q[]   = {
+         1.0,                               2.485'846'490'142'306'297'962e1,  1.650'270'098'316'988'542'046e2,
+         4.328'810'604'912'902'668'951e2,   4.853'903'996'359'136'964'868e2,  1.945'506'571'482'613'964'425e2
+    };
+};
+
+template <>
+struct Math::Exp<float> {
+    inline static constexpr float MIN   = -104.0f;
+    inline static constexpr float MAX   = 88.8f;
+    inline static constexpr float LN2[] = { 6.933'593'75e-1f, -2.121'944'40e-4f };
+    inline static constexpr float P[]   = {
+        1.987'569'150'0e-4f, 1.398'199'950'7e-3f, 8.333'451'907'3e-3f, 4.166'579'589'4e-2f, 1.666'666'545'9e-1f, 5.000'000'120'1e-1f
+    };
+};
+template <>
+struct Math::Exp<double> {
+    inline static constexpr double MIN   = -746.0;
+    inline static constexpr double MAX   = 710.0;
+    inline static constexpr double LN2[] = { 6.931'457'519'531'25e-1, 1.428'606'820'309'417'232'12e-6 };
+    inline static constexpr double P[]   = { 1.261'771'930'748'105'908'78e-4, 3.029'944'077'074'419'613'00e-2, 9.999'999'999'999'999'999'10e-1 };
+    inline static constexpr double Q[]   = {
+        3.001'985'051'386'644'550'42e-6, 2.524'483'403'496'841'041'92e-3, 2.272'655'482'081'550'287'66e-1, 2.000'000'000'000'000'000'09
+    };
+};
+
+template <>
+struct Math::Log<float> {
+    inline static constexpr unsigned int SQRT_HALF = 0x3F35'04F3;
+    inline static constexpr float LN2[] = { 6.931'381'225'6e-1f, 9.058'000'614'5e-6f };
+    inline static constexpr float P[]   = { 2.427'907'884'1e-1f, 2.849'878'668'8e-1f, 4.000'097'215'2e-1f, 6.666'666'269'3e-1f };
+};
+template <>
+struct Math::Log<double> {
+    inline static constexpr unsigned long long SQRT_HALF = 0x3FE6'A09E'667F'3BCD;
+    inline static constexpr double LN2[] = { 6.931'471'803'691'238'164'90e-1, 1.908'214'929'270'587'700'02e-10 };
+    inline static constexpr double P[]   = {
+        1.479'819'860'511'658'591e-1, 1.531'383'769'920'937'332e-1, 1.818'357'216'161'805'012e-1, 2.222'219'843'214'978'396e-1,
+        2.857'142'874'366'239'149e-1, 3.999'999'999'940'941'908e-1, 6.666'666'666'666'735'130e-1
+    };
 };
 
 template <typename T, typename>
 inline constexpr T Math::abs(const T& val) noexcept {
     if constexpr (isFloat<T>) {
+        if (isConstantEvaluated())
+            return (val < 0) ? -val : val;
+        // x87 extended: the sign bit is past the low 64 bits
+        if constexpr (isSame<T, long double>)
+            return std::fabs(val);
+
         using iType = IF<isSame<T, float>, unsigned int, unsigned long long>;
 
         union {
             T     f;
             iType i;
-        } conv;
+        } conv{ val };
 
-        conv.f  = val;
         conv.i &= (isSame<T, float>) ? 0x7FFF'FFFF : 0x7FFF'FFFF'FFFF'FFFF;
 
         return conv.f;
@@ -69,9 +288,20 @@ template <typename T, typename>
 inline constexpr T Math::square(const T& val) noexcept { return val * val; }
 
 template <typename T, typename>
-inline constexpr T Math::toRad(const T& deg) noexcept { return static_cast<T>((PI<double> / 180) * deg); }
+inline constexpr T Math::toRad(const T& deg) noexcept {
+    // float stays in float, integers go through double
+    if constexpr (isFloat<T>)
+        return (PI<T> / 180) * deg;
+
+    return static_cast<T>((PI<double> / 180) * deg);
+}
 template <typename T, typename>
-inline constexpr T Math::toDeg(const T& rad) noexcept { return static_cast<T>((180 / PI<double>) * rad); }
+inline constexpr T Math::toDeg(const T& rad) noexcept {
+    if constexpr (isFloat<T>)
+        return (180 / PI<T>) * rad;
+
+    return static_cast<T>((180 / PI<double>) * rad);
+}
 
 template <typename T, typename>
 inline constexpr bool Math::isZero(const T& val) noexcept {
@@ -90,4 +320,647 @@ inline constexpr bool Math::isZero(const Vec<T, DIM>& v) noexcept {
     return true;
 }
 template <typename T1, typename T2, unsigned int DIM>
-inline constexpr Vec<float, DIM> Math::lerpf(const Vec<T1, DIM>& v1, const Vec<T2, DIM>& v2, const float& t) noexcept { return { (v1 * (1.0f - t)) + (v2 * t) }; }
\ No newline at end of file
+inline constexpr Vec<float, DIM> Math::lerpf(const Vec<T1, DIM>& v1, const Vec<T2, DIM>& v2, const float& t) noexcept {
+    Vec<float, DIM> result{ };
+    result = lazy(v1) * (1.0f - t) + lazy(v2) * t;
+
+    return result;
+}
+
+template <Math::Accuracy A, typename T, typename>
+inline constexpr T Math::sin(const T& x) noexcept {
+    T s{ }, c{ };
+    sincos<A>(x, s, c);
+
+    return s;
+}
+template <Math::Accuracy A, typename T, typename>
+inline constexpr T Math::cos(const T& x) noexcept {
+    T s{ }, c{ };
+    sincos<A>(x, s, c);
+
+    return c;
+}
+template <Math::Accuracy A, typename T, typename>
+inline constexpr T Math::tan(const T& x) noexcept {
+    T s{ }, c{ };
+    sincos<A>(x, s, c);
+
+    return s / c;
+}
+template <Math::Accuracy A, typename T, typename>
+inline constexpr void Math::sincos(const T& x, T& s, T& c) noexcept {
+    if constexpr (!isSame<T, long double>) {
+        if (abs(x) <= RANGE<T>) {
+            int quadrant = 0;
+            const T r = reduce<A>(x, quadrant);
+            const T z = r * r;
+
+            const T sr = r + r * z * horner(z, Trig<A, T>::SIN);
+            const T cr = 1 + z * horner(z, Trig<A, T>::COS);
+
+            // sin(r + k pi/2), cos(r + k pi/2): odd quadrants swap, sin is negative in 2 and 3, cos in 1 and 2
+            // indexed and multiplied rather than branched on, random angles mispredict half the time
+            const T poly[2] = { sr, cr };
+            const int odd = quadrant & 1;
+
+            s = poly[odd]     * static_cast<T>(1 - (quadrant & 2));
+            c = poly[odd ^ 1] * static_cast<T>(1 - ((quadrant + 1) & 2));
+
+            return;
+        }
+    }
+
+    s = std::sin(x);
+    c = std::cos(x);
+}
+
+template <Math::Accuracy A, typename T, typename>
+inline void Math::sin(const T* in, T* out, const std::size_t& count) noexcept {
+    std::size_t i = 0;
+
+    #if defined(MATH_SIMD_SSE)
+        if constexpr (isSame<T, float>) {
+            for (; i < count / 4 * 4; i += 4) {
+                __m128 s, c;
+                sincos4<A>(SIMD::load(in + i), s, c);
+
+                SIMD::store(out + i, s);
+            }
+        }
+    #endif
+
+    for (; i < count; ++i)
+        out[i] = sin<A>(in[i]);
+}
+template <Math::Accuracy A, typename T, typename>
+inline void Math::cos(const T* in, T* out, const std::size_t& count) noexcept {
+    std::size_t i = 0;
+
+    #if defined(MATH_SIMD_SSE)
+        if constexpr (isSame<T, float>) {
+            for (; i < count / 4 * 4; i += 4) {
+                __m128 s, c;
+                sincos4<A>(SIMD::load(in + i), s, c);
+
+                SIMD::store(out + i, c);
+            }
+        }
+    #endif
+
+    for (; i < count; ++i)
+        out[i] = cos<A>(in[i]);
+}
+template <Math::Accuracy A, typename T, typename>
+inline void Math::tan(const T* in, T* out, const std::size_t& count) noexcept {
+    std::size_t i = 0;
+
+    #if defined(MATH_SIMD_SSE)
+        if constexpr (isSame<T, float>) {
+            for (; i < count / 4 * 4; i += 4) {
+                __m128 s, c;
+                sincos4<A>(SIMD::load(in + i), s, c);
+
+                SIMD::store(out + i, SIMD::div(s, c));
+            }
+        }
+    #endif
+
+    for (; i < count; ++i)
+        out[i] = tan<A>(in[i]);
+}
+template <Math::Accuracy A, typename T, typename>
+inline void Math::sincos(const T* in, T* s, T* c, const std::size_t& count) noexcept {
+    std::size_t i = 0;
+
+    #if defined(MATH_SIMD_SSE)
+        if constexpr (isSame<T, float>) {
+            for (; i < count / 4 * 4; i += 4) {
+                __m128 vs, vc;
+                sincos4<A>(SIMD::load(in + i), vs, vc);
+
+                SIMD::store(s + i, vs);
+                SIMD::store(c + i, vc);
+            }
+        }
+    #endif
+
+    for (; i < count; ++i)
+        sincos<A>(in[i], s[i], c[i]);
+}
+
+template <typename T, typename>
+inline T Math::atan(const T& x) noexcept {
+    if constexpr (isSame<T, long double>)
+        return std::atan(x);
+    else {
+        // atan(1 / a) = pi/2 - atan(a)
+        const T a = abs(x);
+        const T r = (a > 1) ? PI<T> / 2 - atanUnit(1 / a) : atanUnit(a);
+
+        return std::copysign(r, x);
+    }
+}
+template <typename T, typename>
+inline T Math::atan2(const T& y, const T& x) noexcept {
+    if constexpr (isSame<T, long double>)
+        return std::atan2(y, x);
+    else {
+        const T ax = abs(x);
+        const T ay = abs(y);
+
+        if (ax != ax || ay != ay)
+            return x + y;
+
+        const bool steep = ay > ax;
+        const T hi = steep ? ay : ax;
+        const T lo = steep ? ax : ay;
+
+        // inf / inf would be NaN, both infinite is the diagonal
+        const T a = (lo == std::numeric_limits<T>::infinity()) ? static_cast<T>(1) : ((hi > 0) ? lo / hi : static_cast<T>(0));
+
+        T r = atanUnit(a);
+        r = steep ? PI<T> / 2 - r : r;
+        r = std::signbit(x) ? PI<T> - r : r;
+
+        return std::copysign(r, y);
+    }
+}
+template <typename T, typename>
+inline void Math::atan2(const T* y, const T* x, T* out, const std::size_t& count) noexcept {
+    std::size_t i = 0;
+
+    #if defined(MATH_SIMD_SSE)
+        if constexpr (isSame<T, float>) {
+            for (; i < count / 4 * 4; i += 4)
+                SIMD::store(out + i, atan2x4(SIMD::load(y + i), SIMD::load(x + i)));
+        }
+    #endif
+
+    for (; i < count; ++i)
+        out[i] = atan2(y[i], x[i]);
+}
+
+template <typename T, typename>
+inline T Math::exp(const T& x) noexcept {
+    if constexpr (isSame<T, long double>)
+        return std::exp(x);
+    else {
+        using K = Exp<T>;
+
+        // 1.5 * 2^23 / 1.5 * 2^52, rounding to nearest as in reduce()
+        constexpr T ROUND = isSame<T, float> ? static_cast<T>(12'582'912.0) : static_cast<T>(6'755'399'441'055'744.0);
+
+        if (x != x)
+            return x;
+
+        const T c = (x < K::MIN) ? K::MIN : ((x > K::MAX) ? K::MAX : x);
+        const T kf = (c * static_cast<T>(1.442'695'040'888'963'4) + ROUND) - ROUND;
+        const T r = (c - kf * K::LN2[0]) - kf * K::LN2[1];
+
+        T y;
+        if constexpr (isSame<T, float>)
+            y = 1 + r + r * r * horner(r, K::P);
+        else {
+            const T p = r * horner(r * r, K::P);
+
+            y = 1 + 2 * p / (horner(r * r, K::Q) - p);
+        }
+
+        // k in [-1076, 1024] (double), each half a normal exponent
+        const int k = static_cast<int>(kf);
+
+        return y * pow2<T>(k / 2) * pow2<T>(k - k / 2);
+    }
+}
+template <typename T, typename>
+inline T Math::log(const T& x) noexcept {
+    if constexpr (isSame<T, long double>)
+        return std::log(x);
+    else {
+        using K = Log<T>;
+        using iType = IF<isSame<T, float>, unsigned int, unsigned long long>;
+
+        constexpr int BITS = isSame<T, float> ? 23 : 52;
+        constexpr int BIAS = isSame<T, float> ? 127 : 1023;
+        constexpr iType ONE = static_cast<iType>(BIAS) << BITS;
+
+        if (!(x > 0))
+            return (x == 0) ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::quiet_NaN();
+        if (!(x <= std::numeric_limits<T>::max()))
+            return x;
+
+        // denormals scaled into the normal range first
+        const bool tiny = x < std::numeric_limits<T>::min();
+
+        union {
+            T     f;
+            iType i;
+        } conv{ tiny ? x * pow2<T>(BITS) : x };
+
+        // the exponent moved by one where the mantissa is past sqrt(2)
+        const iType bits = conv.i + (ONE - K::SQRT_HALF);
+        conv.i = (bits & ((iType{ 1 } << BITS) - 1)) + K::SQRT_HALF;
+
+        const T k = static_cast<T>(static_cast<int>(bits >> BITS) - BIAS - (tiny ? BITS : 0));
+        const T f = conv.f - 1;
+        const T s = f / (2 + f);
+        const T z = s * s;
+        const T half = f * f / 2;
+
+        return k * K::LN2[0] - ((half - (s * (half + z * horner(z, K::P)) + k * K::LN2[1])) - f);
+    }
+}
+template <typename T, typename>
+inline T Math::hypot(const T& x, const T& y) noexcept {
+    const T ax = abs(x);
+    const T ay = abs(y);
+
+    // inf / inf would be NaN
+    if (ax == std::numeric_limits<T>::infinity() || ay == std::numeric_limits<T>::infinity())
+        return std::numeric_limits<T>::infinity();
+    // NaN on either side, not only where it lands in hi
+    if (ax != ax || ay != ay)
+        return ax + ay;
+
+    const T hi = (ay > ax) ? ay : ax;
+    const T lo = (ay > ax) ? ax : ay;
+    const T r = (hi > 0) ? lo / hi : static_cast<T>(0);
+
+    return hi * std::sqrt(1 + r * r);
+}
+template <typename T, typename>
+inline void Math::exp(const T* in, T* out, const std::size_t& count) noexcept {
+    std::size_t i = 0;
+
+    #if defined(MATH_SIMD_SSE)
+        if constexpr (isSame<T, float>) {
+            for (; i < count / 4 * 4; i += 4)
+                SIMD::store(out + i, exp4(SIMD::load(in + i)));
+        }
+    #endif
+
+    for (; i < count; ++i)
+        out[i] = exp(in[i]);
+}
+template <typename T, typename>
+inline void Math::log(const T* in, T* out, const std::size_t& count) noexcept {
+    std::size_t i = 0;
+
+    #if defined(MATH_SIMD_SSE)
+        if constexpr (isSame<T, float>) {
+            for (; i < count / 4 * 4; i += 4)
+                SIMD::store(out + i, log4(SIMD::load(in + i)));
+        }
+    #endif
+
+    for (; i < count; ++i)
+        out[i] = log(in[i]);
+}
+template <typename T, typename>
+inline void Math::hypot(const T* x, const T* y, T* out, const std::size_t& count) noexcept {
+    std::size_t i = 0;
+
+    #if defined(MATH_SIMD_SSE)
+        if constexpr (isSame<T, float>) {
+            for (; i < count / 4 * 4; i += 4)
+                SIMD::store(out + i, hypot4(SIMD::load(x + i), SIMD::load(y + i)));
+        }
+    #endif
+
+    for (; i < count; ++i)
+        out[i] = hypot(x[i], y[i]);
+}
+
+template <unsigned int N, typename T, typename>
+inline constexpr bool Math::isSingular(const T (&m)[N][N], const T& det, bool& inRange) noexcept {
+    // row by row, the column sums as N independent lanes
+    T row[N]{ }, col[N]{ };
+    for (unsigned int i = 0; i < N; ++i)
+        for (unsigned int j = 0; j < N; ++j) {
+            row[i] += square(m[i][j]);
+            col[j] += square(m[i][j]);
+        }
+
+    T rows = static_cast<T>(1);
+    T cols = static_cast<T>(1);
+    for (unsigned int i = 0; i < N; ++i) {
+        rows *= row[i];
+        cols *= col[i];
+    }
+
+    const T bound = (rows < cols) ? rows : cols;
+    const T tolerance = square(EPSILON<T>) * bound;
+
+    // NaN out of range too
+    inRange = tolerance >= std::numeric_limits<T>::min() && bound <= std::numeric_limits<T>::max();
+
+    return !(det * det > tolerance);
+}
+template <unsigned int N, typename T, typename>
+inline constexpr void Math::balance(T (&m)[N][N], T (&row)[N], T (&col)[N]) noexcept {
+    // the scales through locals, m aliases row and col as far as the compiler knows
+    for (unsigned int i = 0; i < N; ++i) {
+        T top = static_cast<T>(0);
+        for (unsigned int j = 0; j < N; ++j)
+            top = (abs(m[i][j]) > top) ? abs(m[i][j]) : top;
+
+        const T scale = unitScale(top);
+        for (unsigned int j = 0; j < N; ++j)
+            m[i][j] *= scale;
+
+        row[i] = scale;
+    }
+
+    T top[N]{ };
+    for (unsigned int i = 0; i < N; ++i)
+        for (unsigned int j = 0; j < N; ++j)
+            top[j] = (abs(m[i][j]) > top[j]) ? abs(m[i][j]) : top[j];
+
+    T scale[N]{ };
+    for (unsigned int j = 0; j < N; ++j)
+        scale[j] = unitScale(top[j]);
+
+    for (unsigned int i = 0; i < N; ++i)
+        for (unsigned int j = 0; j < N; ++j)
+            m[i][j] *= scale[j];
+
+    for (unsigned int j = 0; j < N; ++j)
+        col[j] = scale[j];
+}
+template <typename T, unsigned int N, unsigned int C>
+inline constexpr bool Math::invert(const Mat<T, N, C>& m, Mat<T, N, C>& out, T (*inverse)(const Mat<T, N, C>&, Mat<T, N, C>&)) noexcept {
+    T a[N][N]{ };
+    for (unsigned int i = 0; i < N; ++i)
+        for (unsigned int j = 0; j < N; ++j)
+            a[i][j] = m.mROW[i][j];
+
+    bool inRange = true;
+
+    // no over- / underflow allowed in a constant expression, balancing rules it out
+    if (!isConstantEvaluated()) {
+        const bool singular = isSingular(a, inverse(m, out), inRange);
+
+        if (inRange)
+            return !singular;
+    }
+
+    T row[N]{ }, col[N]{ };
+    balance(a, row, col);
+
+    // [R L C | R t]^-1 = [C^-1 L^-1 R^-1 | -C^-1 L^-1 t]: rows i of the result back by col[i], the N x N part also by row[j]
+    Mat<T, N, C> balanced = m;
+    for (unsigned int i = 0; i < N; ++i)
+        for (unsigned int j = 0; j < C; ++j)
+            balanced.mROW[i][j] = (j < N) ? a[i][j] : m.mROW[i][j] * row[i];
+
+    if (isSingular(a, inverse(balanced, out), inRange))
+        return false;
+
+    for (unsigned int i = 0; i < N; ++i)
+        for (unsigned int j = 0; j < C; ++j)
+            out.mROW[i][j] = (j < N) ? out.mROW[i][j] * col[i] * row[j] : out.mROW[i][j] * col[i];
+
+    return true;
+}
+
+template <typename T, unsigned int N>
+inline constexpr T Math::horner(const T& z, const T (&coef)[N]) noexcept {
+    T acc = coef[0];
+    for (unsigned int i = 1; i < N; ++i)
+        acc = acc * z + coef[i];
+
+    return acc;
+}
+template <Math::Accuracy A, typename T>
+inline constexpr T Math::reduce(const T& x, int& quadrant) noexcept {
+    static_assert(isSame<T, float> || isSame<T, double>);
+
+    // 1.5 * 2^23 / 1.5 * 2^52: adding it pushes the fraction out of the mantissa, rounding to nearest
+    // without a branch and still constexpr (|x| up to 6e6 / 7e15, far past where the reduction holds)
+    constexpr T ROUND = isSame<T, float> ? static_cast<T>(12'582'912.0) : static_cast<T>(6'755'399'441'055'744.0);
+
+    const T kf = (x * (2 / PI<T>) + ROUND) - ROUND;
+
+    quadrant = static_cast<int>(static_cast<long long>(kf) & 3);
+
+    // Cody-Waite: the leading part has few enough bits that kf * PIO2[0] is exact
+    T r = x - kf * Trig<A, T>::PIO2[0];
+    r -= kf * Trig<A, T>::PIO2[1];
+    if constexpr (A == Accuracy::PRECISE)
+        r -= kf * Trig<A, T>::PIO2[2];
+
+    return r;
+}
+
+template <typename T>
+inline T Math::pow2(const int& k) noexcept {
+    using iType = IF<isSame<T, float>, unsigned int, unsigned long long>;
+
+    union {
+        iType i;
+        T     f;
+    } conv{ static_cast<iType>(k + (isSame<T, float> ? 127 : 1023)) << (isSame<T, float> ? 23 : 52) };
+
+    return conv.f;
+}
+
+template <typename T>
+inline constexpr T Math::unitScale(const T& a) noexcept {
+    if (!(a > 0) || !(a <= std::numeric_limits<T>::max()))
+        return static_cast<T>(1);
+
+    if constexpr (!isSame<T, long double>) {
+        if (!isConstantEvaluated()) {
+            using iType = IF<isSame<T, float>, unsigned int, unsigned long long>;
+
+            union {
+                T     f;
+                iType i;
+            } conv{ a };
+
+            // a = m 2^e, m in [0.5, 1) (denormals read as the smallest exponent), 2^-e in two normal halves
+            const int e = static_cast<int>(conv.i >> (isSame<T, float> ? 23 : 52)) - (isSame<T, float> ? 126 : 1022);
+
+            return pow2<T>(-e / 2) * pow2<T>(-e - (-e / 2));
+        }
+    }
+
+    T p = static_cast<T>(1);
+    T v = a;
+    while (v >= 1) {
+        v /= 2;
+        p /= 2;
+    }
+    while (v < static_cast<T>(0.5) && p < std::numeric_limits<T>::max() / 2) {
+        v *= 2;
+        p *= 2;
+    }
+
+    return p;
+}
+
+template <typename T>
+inline T Math::atanUnit(const T& a) noexcept {
+    const bool moved = a > Atan<T>::SPLIT;
+
+    const T r = moved ? (a - 1) / (a + 1) : a;
+    const T z = r * r;
+
+    T poly;
+    if constexpr (isSame<T, float>)
+        poly = z * horner(z, Atan<T>::P);
+    else
+        poly = z * horner(z, Atan<T>::P) / horner(z, Atan<T>::Q);
+
+    return (moved ? PI<T> / 4 : static_cast<T>(0)) + (r + r * poly);
+}
+
+#if defined(MATH_SIMD_SSE)
+    template <unsigned int N>
+    inline __m128 Math::horner(const __m128& z, const float (&coef)[N]) noexcept {
+        __m128 acc = SIMD::broadcast(coef[0]);
+        for (unsigned int i = 1; i < N; ++i)
+            acc = SIMD::fmadd(acc, z, SIMD::broadcast(coef[i]));
+
+        return acc;
+    }
+
+    template <Math::Accuracy A>
+    inline void Math::sincos4(const __m128& x, __m128& s, __m128& c) noexcept {
+        using K = Trig<A, float>;
+
+        const __m128i quadrant = SIMD::roundInt(SIMD::mul(x, SIMD::broadcast(2 / PI<float>)));
+        const __m128 k = SIMD::toFloat(quadrant);
+
+        __m128 r = SIMD::sub(x, SIMD::mul(k, SIMD::broadcast(K::PIO2[0])));
+        r = SIMD::sub(r, SIMD::mul(k, SIMD::broadcast(K::PIO2[1])));
+        if constexpr (A == Accuracy::PRECISE)
+            r = SIMD::sub(r, SIMD::mul(k, SIMD::broadcast(K::PIO2[2])));
+
+        const __m128 z = SIMD::mul(r, r);
+
+        const __m128 sp = SIMD::fmadd(SIMD::mul(r, z), horner(z, K::SIN), r);
+        const __m128 cp = SIMD::fmadd(z, horner(z, K::COS), SIMD::broadcast(1.0f));
+
+        // odd quadrants swap sin and cos, sin is negative in 2 and 3, cos in 1 and 2
+        const __m128 swap = SIMD::bitMask<0>(quadrant);
+        s = SIMD::flipSign(SIMD::select(swap, cp, sp), SIMD::bitSign<1>(quadrant));
+        c = SIMD::flipSign(SIMD::flipSign(SIMD::select(swap, sp, cp), SIMD::bitSign<0>(quadrant)), SIMD::bitSign<1>(quadrant));
+
+        // lanes past RANGE (NaN / inf included) redone by std::sin / std::cos
+        if (SIMD::maskBits(SIMD::lessEqual(SIMD::abs(x), SIMD::broadcast(RANGE<float>))) != 0xF) {
+            float in[4], vs[4], vc[4];
+            SIMD::store(in, x);
+            SIMD::store(vs, s);
+            SIMD::store(vc, c);
+
+            for (unsigned int i = 0; i < 4; ++i) {
+                if (!(abs(in[i]) <= RANGE<float>)) {
+                    vs[i] = std::sin(in[i]);
+                    vc[i] = std::cos(in[i]);
+                }
+            }
+
+            s = SIMD::load(vs);
+            c = SIMD::load(vc);
+        }
+    }
+
+    inline __m128 Math::atan2x4(const __m128& y, const __m128& x) noexcept {
+        const __m128 zero = SIMD::broadcast(0.0f);
+        const __m128 one  = SIMD::broadcast(1.0f);
+
+        const __m128 ax = SIMD::abs(x);
+        const __m128 ay = SIMD::abs(y);
+
+        const __m128 steep = SIMD::greater(ay, ax);
+        const __m128 hi = SIMD::select(steep, ay, ax);
+        const __m128 lo = SIMD::select(steep, ax, ay);
+
+        // inf / inf would be NaN, both infinite is the diagonal
+        const __m128 inf = SIMD::broadcast(std::numeric_limits<float>::infinity());
+        __m128 a = SIMD::select(SIMD::greater(hi, zero), SIMD::div(lo, hi), zero);
+        a = SIMD::select(SIMD::lessEqual(inf, lo), one, a);
+
+        const __m128 moved = SIMD::greater(a, SIMD::broadcast(Atan<float>::SPLIT));
+        const __m128 r = SIMD::select(moved, SIMD::div(SIMD::sub(a, one), SIMD::add(a, one)), a);
+        const __m128 z = SIMD::mul(r, r);
+
+        __m128 t = SIMD::fmadd(SIMD::mul(r, z), horner(z, Atan<float>::P), r);
+        t = SIMD::add(t, SIMD::select(moved, SIMD::broadcast(PI<float> / 4), zero));
+
+        t = SIMD::select(steep, SIMD::sub(SIMD::broadcast(PI<float> / 2), t), t);
+        t = SIMD::select(SIMD::signMask(x), SIMD::sub(SIMD::broadcast(PI<float>), t), t);
+        t = SIMD::flipSign(t, SIMD::signBit(y));
+
+        // NaN lanes: NaN, the selects above would have dropped it when it landed in lo
+        return SIMD::select(SIMD::maskAnd(SIMD::lessEqual(ax, inf), SIMD::lessEqual(ay, inf)), t, SIMD::add(x, y));
+    }
+
+    inline __m128 Math::exp4(const __m128& x) noexcept {
+        using K = Exp<float>;
+
+        // NaN lanes stay NaN through the clamps
+        __m128 c = SIMD::select(SIMD::greater(x, SIMD::broadcast(K::MAX)), SIMD::broadcast(K::MAX), x);
+        c = SIMD::select(SIMD::greater(SIMD::broadcast(K::MIN), c), SIMD::broadcast(K::MIN), c);
+
+        const __m128i k = SIMD::roundInt(SIMD::mul(c, SIMD::broadcast(1.442'695'040'888'963'4f)));
+        const __m128 kf = SIMD::toFloat(k);
+
+        __m128 r = SIMD::sub(c, SIMD::mul(kf, SIMD::broadcast(K::LN2[0])));
+        r = SIMD::sub(r, SIMD::mul(kf, SIMD::broadcast(K::LN2[1])));
+
+        const __m128 y = SIMD::fmadd(SIMD::mul(r, r), horner(r, K::P), SIMD::add(r, SIMD::broadcast(1.0f)));
+
+        return SIMD::mulPow2(y, k);
+    }
+
+    inline __m128 Math::log4(const __m128& x) noexcept {
+        using K = Log<float>;
+
+        const __m128 zero = SIMD::broadcast(0.0f);
+
+        // denormals scaled into the normal range first
+        const __m128 tiny = SIMD::greater(SIMD::broadcast(std::numeric_limits<float>::min()), x);
+
+        __m128 k;
+        const __m128 m = SIMD::splitExponent(SIMD::select(tiny, SIMD::mul(x, SIMD::broadcast(8'388'608.0f)), x), K::SQRT_HALF, k);
+        k = SIMD::sub(k, SIMD::select(tiny, SIMD::broadcast(23.0f), zero));
+
+        const __m128 f = SIMD::sub(m, SIMD::broadcast(1.0f));
+        const __m128 s = SIMD::div(f, SIMD::add(f, SIMD::broadcast(2.0f)));
+        const __m128 z = SIMD::mul(s, s);
+        const __m128 half = SIMD::mul(SIMD::mul(f, f), SIMD::broadcast(0.5f));
+
+        const __m128 t = SIMD::fmadd(s, SIMD::fmadd(z, horner(z, K::P), half), SIMD::mul(k, SIMD::broadcast(K::LN2[1])));
+        __m128 r = SIMD::fmadd(k, SIMD::broadcast(K::LN2[0]), SIMD::sub(f, SIMD::sub(half, t)));
+
+        // inf and NaN pass through, log(0) = -inf, log(< 0) = NaN
+        r = SIMD::select(SIMD::lessEqual(x, SIMD::broadcast(std::numeric_limits<float>::max())), r, x);
+        r = SIMD::select(SIMD::lessEqual(x, zero), SIMD::broadcast(-std::numeric_limits<float>::infinity()), r);
+
+        return SIMD::select(SIMD::greater(zero, x), SIMD::broadcast(std::numeric_limits<float>::quiet_NaN()), r);
+    }
+
+    inline __m128 Math::hypot4(const __m128& x, const __m128& y) noexcept {
+        const __m128 ax = SIMD::abs(x);
+        const __m128 ay = SIMD::abs(y);
+
+        const __m128 steep = SIMD::greater(ay, ax);
+        const __m128 hi = SIMD::select(steep, ay, ax);
+        const __m128 lo = SIMD::select(steep, ax, ay);
+
+        const __m128 zero = SIMD::broadcast(0.0f);
+        const __m128 r = SIMD::select(SIMD::greater(hi, zero), SIMD::div(lo, hi), zero);
+
+        // inf in either lane wins over inf / inf and NaN, otherwise NaN on either side is NaN
+        const __m128 inf = SIMD::broadcast(std::numeric_limits<float>::infinity());
+        const __m128 big = SIMD::maskOr(SIMD::lessEqual(inf, ax), SIMD::lessEqual(inf, ay));
+        const __m128 ordered = SIMD::maskAnd(SIMD::lessEqual(ax, inf), SIMD::lessEqual(ay, inf));
+
+        const __m128 h = SIMD::select(ordered, SIMD::mul(hi, SIMD::sqrt(SIMD::fmadd(r, r, SIMD::broadcast(1.0f)))), SIMD::add(ax, ay));
+
+        return SIMD::select(big, inf, h);
+    }
+#endif
\ No newline at end of file
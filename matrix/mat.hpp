@@ -0,0 +1,498 @@
+#pragma once
+
+#include "../base.hpp"
+#include "../math.hpp"
+#include "../parallel.hpp"
+#include "../simd.hpp"
+#include "../typeHandler.hpp"
+#include "../vector/vec2.hpp"
+#include "../vector/vec3.hpp"
+#include "../vector/vec4.hpp"
+#include "../vector/vecN.hpp"
+#include "mat3x4.hpp"
+#include "mat4.hpp"
+
+#include <cassert>      // assert()
+#include <cstddef>      // size_t
+#include <utility>      // integer_sequence, make_integer_sequence
+
+// Dense ROW x COL matrix of every other shape (Mat2, Mat3, 4x3, 2x6 ...): ROW rows of Vec<T, COL>.
+// Each kernel is unrolled over the compile-time shape; Mat<T, 4, 4> and the affine Mat<T, 3, 4>
+// keep their own specializations and mix with this one in products.
+template <typename T, unsigned int ROW, unsigned int COL>
+class Mat<T, ROW, COL> {
+    static_assert(ROW > 1 && COL > 1);
+
+    public:
+        constexpr Mat() noexcept = default;
+        constexpr Mat(const Mat<T, ROW, COL>&) noexcept = default;
+        constexpr Mat(Mat<T, ROW, COL>&&) noexcept = default;
+        ~Mat() noexcept = default;
+
+        template <typename U>
+        constexpr Mat(const Mat<U, ROW, COL>&) noexcept;
+
+        template <typename... U, typename = enableIF<sizeof...(U) == ROW>>
+        constexpr Mat(const Vec<U, COL>&...) noexcept;
+
+        constexpr Mat<T, ROW, COL>& operator=(const Mat<T, ROW, COL>&) noexcept = default;
+        constexpr Mat<T, ROW, COL>& operator=(Mat<T, ROW, COL>&&) noexcept = default;
+
+        template <typename U>
+        constexpr Mat<T, ROW, COL>& operator=(const Mat<U, ROW, COL>&) noexcept;
+        template <typename E>
+        constexpr Mat<T, ROW, COL>& operator=(const Expr<E>&) noexcept;
+
+        template <typename... U, typename = enableIF<sizeof...(U) == ROW>>
+        constexpr Mat<T, ROW, COL>& operator()(const Vec<U, COL>&...) noexcept;
+
+        constexpr Vec<T, COL>& operator[](const unsigned int& idx);
+        constexpr const Vec<T, COL>& operator[](const unsigned int& idx) const;
+
+        template <typename U> constexpr Mat<T, ROW, COL>& operator+=(const Mat<U, ROW, COL>&) noexcept;
+        template <typename U> constexpr Mat<T, ROW, COL>& operator-=(const Mat<U, ROW, COL>&) noexcept;
+        template <typename U> constexpr Mat<T, ROW, COL>& operator*=(const Mat<U, COL, COL>&) noexcept;
+        template <typename U> constexpr Mat<T, ROW, COL>& operator+=(const U&) noexcept;
+        template <typename U> constexpr Mat<T, ROW, COL>& operator-=(const U&) noexcept;
+        template <typename U> constexpr Mat<T, ROW, COL>& operator*=(const U&) noexcept;
+        template <typename U> constexpr Mat<T, ROW, COL>& operator/=(const U&);
+
+        template <typename U> inline constexpr Mat<T, ROW, COL> operator+(const Mat<U, ROW, COL>&) const noexcept;
+        template <typename U> inline constexpr Mat<T, ROW, COL> operator-(const Mat<U, ROW, COL>&) const noexcept;
+        // (ROW x COL) * (R x C), R must equal COL
+        template <typename U, unsigned int R, unsigned int C>
+        inline constexpr Mat<T, ROW, C> operator*(const Mat<U, R, C>&) const noexcept;
+        template <typename U> inline constexpr Vec<T, ROW> operator*(const Vec<U, COL>&) const noexcept;
+        template <typename U> inline constexpr Mat<T, ROW, COL> operator+(const U&) const noexcept;
+        template <typename U> inline constexpr Mat<T, ROW, COL> operator-(const U&) const noexcept;
+        template <typename U> inline constexpr Mat<T, ROW, COL> operator*(const U&) const noexcept;
+        template <typename U> inline constexpr Mat<T, ROW, COL> operator/(const U&) const;
+
+        inline constexpr Mat<T, COL, ROW> transpose() const noexcept;
+
+        // square only, determinant / inverse for 2x2 and 3x3
+        inline constexpr T trace() const noexcept;
+        inline constexpr T determinant() const noexcept;
+        inline constexpr Mat<T, ROW, COL> inverse() const;
+        // false (out untouched) if the matrix is singular
+        inline constexpr bool tryInverse(Mat<T, ROW, COL>&) const noexcept;
+
+        static inline constexpr Mat<T, COL, ROW> transpose(const Mat<T, ROW, COL>&) noexcept;
+        static inline constexpr T trace(const Mat<T, ROW, COL>&) noexcept;
+        static inline constexpr T determinant(const Mat<T, ROW, COL>&) noexcept;
+        static inline constexpr Mat<T, ROW, COL> inverse(const Mat<T, ROW, COL>&);
+        static inline constexpr Mat<T, ROW, COL> identity() noexcept;
+
+        // Mat3: inverse transpose of the upper-left 3x3 (transforms the normals of m)
+        static inline constexpr Mat<T, ROW, COL> normal(const Mat<T, 4, 4>& m);
+
+        // square: x[i] = inverse(a[i]) * b[i] over whole arrays, returns how many a[i] were singular (their x[i] is zero)
+        static inline std::size_t solve(const Mat<T, ROW, COL>* a, const Vec<T, ROW>* b, Vec<T, ROW>* x, const std::size_t&) noexcept;
+        // the same for symmetric positive definite a[i] (only the lower triangles are read), returns how many were not
+        static inline std::size_t solveCholesky(const Mat<T, ROW, COL>* a, const Vec<T, ROW>* b, Vec<T, ROW>* x, const std::size_t&) noexcept;
+
+        // symmetric Mat3 (the upper triangle is read): values descending, one unit eigenvector per row of vectors
+        inline void eigen(Vec<T, ROW>& values, Mat<T, ROW, COL>& vectors) const noexcept;
+        static inline void eigen(const Mat<T, ROW, COL>* m, Vec<T, ROW>* values, Mat<T, ROW, COL>* vectors, const std::size_t&) noexcept;
+
+        // Mat3: covariance of count points (divided by count), their mean into mean if given (both zero for no points)
+        static inline Mat<T, ROW, COL> covariance(const Vec3<T>* points, const std::size_t& count, Vec3<T>* mean = nullptr) noexcept;
+        // out[i] = covariance of points[offsets[i], offsets[i + 1]), the spans split across threads (0 = every hardware thread)
+        static void covariance(const Vec3<T>* points, const std::size_t* offsets, const std::size_t& spans, Mat<T, ROW, COL>* out, const unsigned int& threads = 0);
+
+    private:
+        template <unsigned int N>
+        using Index = std::make_integer_sequence<unsigned int, N>;
+
+        // f(0), f(1), ... f(N - 1) without a loop
+        template <typename F, unsigned int... I>
+        static inline constexpr void unroll(const F&, std::integer_sequence<unsigned int, I...>) noexcept;
+        // f(0) + f(1) + ... + f(N - 1)
+        template <typename F, unsigned int... I>
+        static inline constexpr T sum(const F&, std::integer_sequence<unsigned int, I...>) noexcept;
+
+        // out = adj(m) / det(m), returns det(m)
+        static inline constexpr T invert(const Mat<T, ROW, COL>&, Mat<T, ROW, COL>&) noexcept;
+
+    public:
+        Vec<T, COL> mROW[ROW];
+};
+template <typename T> using Mat2 = Mat<T, 2, 2>;
+template <typename T> using Mat3 = Mat<T, 3, 3>;
+template <typename T> using Mat4x3 = Mat<T, 4, 3>;
+
+template <typename T, unsigned int ROW, unsigned int COL> template <typename U>
+constexpr Mat<T, ROW, COL>::Mat(const Mat<U, ROW, COL>& other) noexcept { *this = other; }
+template <typename T, unsigned int ROW, unsigned int COL> template <typename... U, typename>
+constexpr Mat<T, ROW, COL>::Mat(const Vec<U, COL>&... rows) noexcept { (*this)(rows...); }
+
+template <typename T, unsigned int ROW, unsigned int COL> template <typename U>
+constexpr Mat<T, ROW, COL>& Mat<T, ROW, COL>::operator=(const Mat<U, ROW, COL>& other) noexcept {
+    unroll([&](const unsigned int& row) { mROW[row] = static_cast<Vec<T, COL>>(other.mROW[row]); }, Index<ROW>{ });
+
+    return *this;
+}
+template <typename T, unsigned int ROW, unsigned int COL> template <typename E>
+constexpr Mat<T, ROW, COL>& Mat<T, ROW, COL>::operator=(const Expr<E>& e) noexcept {
+    static_assert((E::ROWS == ROW) && (E::COLS == COL));
+
+    Vec<T, COL> rows[ROW]{ };
+    for (unsigned int row = 0; row < ROW; ++row) {
+        for (unsigned int col = 0; col < COL; ++col)
+            rows[row][col] = static_cast<T>(e[row * COL + col]);
+    }
+
+    for (unsigned int row = 0; row < ROW; ++row)
+        mROW[row] = rows[row];
+
+    return *this;
+}
+
+template <typename T, unsigned int ROW, unsigned int COL> template <typename... U, typename>
+constexpr Mat<T, ROW, COL>& Mat<T, ROW, COL>::operator()(const Vec<U, COL>&... rows) noexcept {
+    unsigned int row = 0;
+    ((mROW[row++] = static_cast<Vec<T, COL>>(rows)), ...);
+
+    return *this;
+}
+
+template <typename T, unsigned int ROW, unsigned int COL> constexpr Vec<T, COL>& Mat<T, ROW, COL>::operator[](const unsigned int& idx) {
+    assert(idx < ROW);
+
+    return mROW[idx];
+}
+template <typename T, unsigned int ROW, unsigned int COL> constexpr const Vec<T, COL>& Mat<T, ROW, COL>::operator[](const unsigned int& idx) const {
+    assert(idx < ROW);
+
+    return mROW[idx];
+}
+
+template <typename T, unsigned int ROW, unsigned int COL> template <typename U>
+constexpr Mat<T, ROW, COL>& Mat<T, ROW, COL>::operator+=(const Mat<U, ROW, COL>& other) noexcept {
+    unroll([&](const unsigned int& row) { mROW[row] += other.mROW[row]; }, Index<ROW>{ });
+
+    return *this;
+}
+template <typename T, unsigned int ROW, unsigned int COL> template <typename U>
+constexpr Mat<T, ROW, COL>& Mat<T, ROW, COL>::operator-=(const Mat<U, ROW, COL>& other) noexcept {
+    unroll([&](const unsigned int& row) { mROW[row] -= other.mROW[row]; }, Index<ROW>{ });
+
+    return *this;
+}
+template <typename T, unsigned int ROW, unsigned int COL> template <typename U>
+constexpr Mat<T, ROW, COL>& Mat<T, ROW, COL>::operator*=(const Mat<U, COL, COL>& other) noexcept { return (*this = ((*this) * other)); }
+template <typename T, unsigned int ROW, unsigned int COL> template <typename U>
+constexpr Mat<T, ROW, COL>& Mat<T, ROW, COL>::operator+=(const U& val) noexcept {
+    unroll([&](const unsigned int& row) { mROW[row] += val; }, Index<ROW>{ });
+
+    return *this;
+}
+template <typename T, unsigned int ROW, unsigned int COL> template <typename U>
+constexpr Mat<T, ROW, COL>& Mat<T, ROW, COL>::operator-=(const U& val) noexcept {
+    unroll([&](const unsigned int& row) { mROW[row] -= val; }, Index<ROW>{ });
+
+    return *this;
+}
+template <typename T, unsigned int ROW, unsigned int COL> template <typename U>
+constexpr Mat<T, ROW, COL>& Mat<T, ROW, COL>::operator*=(const U& val) noexcept {
+    unroll([&](const unsigned int& row) { mROW[row] *= val; }, Index<ROW>{ });
+
+    return *this;
+}
+template <typename T, unsigned int ROW, unsigned int COL> template <typename U>
+constexpr Mat<T, ROW, COL>& Mat<T, ROW, COL>::operator/=(const U& val) {
+    unroll([&](const unsigned int& row) { mROW[row] /= val; }, Index<ROW>{ });
+
+    return *this;
+}
+
+template <typename T, unsigned int ROW, unsigned int COL> template <typename U>
+inline constexpr Mat<T, ROW, COL> Mat<T, ROW, COL>::operator+(const Mat<U, ROW, COL>& other) const noexcept {
+    Mat<T, ROW, COL> result{ };
+    unroll([&](const unsigned int& row) { result.mROW[row] = mROW[row] + other.mROW[row]; }, Index<ROW>{ });
+
+    return result;
+}
+template <typename T, unsigned int ROW, unsigned int COL> template <typename U>
+inline constexpr Mat<T, ROW, COL> Mat<T, ROW, COL>::operator-(const Mat<U, ROW, COL>& other) const noexcept {
+    Mat<T, ROW, COL> result{ };
+    unroll([&](const unsigned int& row) { result.mROW[row] = mROW[row] - other.mROW[row]; }, Index<ROW>{ });
+
+    return result;
+}
+template <typename T, unsigned int ROW, unsigned int COL> template <typename U, unsigned int R, unsigned int C>
+inline constexpr Mat<T, ROW, C> Mat<T, ROW, COL>::operator*(const Mat<U, R, C>& other) const noexcept {
+    // the inner dimensions of a product must agree
+    static_assert(R == COL);
+
+    // result[row][col] = sum(mROW[row][k] * other[k][col]), ROW * C * COL multiplies
+    Mat<T, ROW, C> result{ };
+    unroll([&](const unsigned int& row) {
+        unroll([&](const unsigned int& col) {
+            result[row][col] = sum([&](const unsigned int& k) { return static_cast<T>(mROW[row][k] * other[k][col]); }, Index<COL>{ });
+        }, Index<C>{ });
+    }, Index<ROW>{ });
+
+    return result;
+}
+template <typename T, unsigned int ROW, unsigned int COL> template <typename U>
+inline constexpr Vec<T, ROW> Mat<T, ROW, COL>::operator*(const Vec<U, COL>& v) const noexcept {
+    Vec<T, ROW> result{ };
+    unroll([&](const unsigned int& row) {
+        result[row] = sum([&](const unsigned int& k) { return static_cast<T>(mROW[row][k] * v[k]); }, Index<COL>{ });
+    }, Index<ROW>{ });
+
+    return result;
+}
+template <typename T, unsigned int ROW, unsigned int COL> template <typename U>
+inline constexpr Mat<T, ROW, COL> Mat<T, ROW, COL>::operator+(const U& val) const noexcept {
+    Mat<T, ROW, COL> result{ };
+    unroll([&](const unsigned int& row) { result.mROW[row] = mROW[row] + val; }, Index<ROW>{ });
+
+    return result;
+}
+template <typename T, unsigned int ROW, unsigned int COL> template <typename U>
+inline constexpr Mat<T, ROW, COL> Mat<T, ROW, COL>::operator-(const U& val) const noexcept {
+    Mat<T, ROW, COL> result{ };
+    unroll([&](const unsigned int& row) { result.mROW[row] = mROW[row] - val; }, Index<ROW>{ });
+
+    return result;
+}
+template <typename T, unsigned int ROW, unsigned int COL> template <typename U>
+inline constexpr Mat<T, ROW, COL> Mat<T, ROW, COL>::operator*(const U& val) const noexcept {
+    Mat<T, ROW, COL> result{ };
+    unroll([&](const unsigned int& row) { result.mROW[row] = mROW[row] * val; }, Index<ROW>{ });
+
+    return result;
+}
+template <typename T, unsigned int ROW, unsigned int COL> template <typename U>
+inline constexpr Mat<T, ROW, COL> Mat<T, ROW, COL>::operator/(const U& val) const {
+    Mat<T, ROW, COL> result{ };
+    unroll([&](const unsigned int& row) { result.mROW[row] = mROW[row] / val; }, Index<ROW>{ });
+
+    return result;
+}
+
+template <typename T, unsigned int ROW, unsigned int COL>
+inline constexpr Mat<T, COL, ROW> Mat<T, ROW, COL>::transpose() const noexcept {
+    Mat<T, COL, ROW> result{ };
+    unroll([&](const unsigned int& row) {
+        unroll([&](const unsigned int& col) { result[col][row] = mROW[row][col]; }, Index<COL>{ });
+    }, Index<ROW>{ });
+
+    return result;
+}
+
+template <typename T, unsigned int ROW, unsigned int COL>
+inline constexpr T Mat<T, ROW, COL>::trace() const noexcept {
+    static_assert(ROW == COL);
+
+    return sum([&](const unsigned int& i) { return mROW[i][i]; }, Index<ROW>{ });
+}
+template <typename T, unsigned int ROW, unsigned int COL>
+inline constexpr T Mat<T, ROW, COL>::determinant() const noexcept {
+    static_assert(ROW == COL && ROW <= 3);
+
+    const Vec<T, COL>* r = mROW;
+
+    if constexpr (ROW == 2)
+        return static_cast<T>(r[0][0] * r[1][1] - r[0][1] * r[1][0]);
+    else {
+        return static_cast<T>(
+            r[0][0] * (r[1][1] * r[2][2] - r[1][2] * r[2][1]) -
+            r[0][1] * (r[1][0] * r[2][2] - r[1][2] * r[2][0]) +
+            r[0][2] * (r[1][0] * r[2][1] - r[1][1] * r[2][0])
+        );
+    }
+}
+template <typename T, unsigned int ROW, unsigned int COL>
+inline constexpr Mat<T, ROW, COL> Mat<T, ROW, COL>::inverse() const {
+    Mat<T, ROW, COL> result{ };
+    const bool invertible = Math::invert(*this, result, &invert);
+
+    assert(invertible);
+    (void)invertible;
+
+    return result;
+}
+template <typename T, unsigned int ROW, unsigned int COL>
+inline constexpr bool Mat<T, ROW, COL>::tryInverse(Mat<T, ROW, COL>& out) const noexcept {
+    Mat<T, ROW, COL> result{ };
+
+    if (!Math::invert(*this, result, &invert))
+        return false;
+
+    out = result;
+
+    return true;
+}
+
+template <typename T, unsigned int ROW, unsigned int COL>
+inline constexpr Mat<T, COL, ROW> Mat<T, ROW, COL>::transpose(const Mat<T, ROW, COL>& m) noexcept { return m.transpose(); }
+template <typename T, unsigned int ROW, unsigned int COL>
+inline constexpr T Mat<T, ROW, COL>::trace(const Mat<T, ROW, COL>& m) noexcept { return m.trace(); }
+template <typename T, unsigned int ROW, unsigned int COL>
+inline constexpr T Mat<T, ROW, COL>::determinant(const Mat<T, ROW, COL>& m) noexcept { return m.determinant(); }
+template <typename T, unsigned int ROW, unsigned int COL>
+inline constexpr Mat<T, ROW, COL> Mat<T, ROW, COL>::inverse(const Mat<T, ROW, COL>& m) { return m.inverse(); }
+template <typename T, unsigned int ROW, unsigned int COL>
+inline constexpr Mat<T, ROW, COL> Mat<T, ROW, COL>::identity() noexcept {
+    static_assert(ROW == COL);
+
+    Mat<T, ROW, COL> result{ };
+    unroll([&](const unsigned int& i) { result.mROW[i][i] = static_cast<T>(1); }, Index<ROW>{ });
+
+    return result;
+}
+
+template <typename T, unsigned int ROW, unsigned int COL>
+inline constexpr Mat<T, ROW, COL> Mat<T, ROW, COL>::normal(const Mat<T, 4, 4>& m) {
+    static_assert(ROW == 3 && COL == 3);
+
+    const Mat<T, 3, 3> linear{
+        Vec3<T>{ m[0].x, m[0].y, m[0].z },
+        Vec3<T>{ m[1].x, m[1].y, m[1].z },
+        Vec3<T>{ m[2].x, m[2].y, m[2].z }
+    };
+
+    return linear.inverse().transpose();
+}
+
+template <typename T, unsigned int ROW, unsigned int COL>
+inline std::size_t Mat<T, ROW, COL>::solve(const Mat<T, ROW, COL>* a, const Vec<T, ROW>* b, Vec<T, ROW>* x, const std::size_t& count) noexcept {
+    static_assert(ROW == COL);
+    // copied as ROW * COL and ROW lanes
+    static_assert(sizeof(Mat<T, ROW, COL>) == ROW * COL * sizeof(T) && sizeof(Vec<T, ROW>) == ROW * sizeof(T));
+
+    std::size_t singular = 0;
+    SIMD::blocks<T>(count, [&singular](const T* lanesA, const T* lanesB, T* lanesX, const std::size_t& n) { singular += SIMD::solveLU<ROW>(lanesA, lanesB, lanesX, n); }, a, b, x);
+
+    return singular;
+}
+template <typename T, unsigned int ROW, unsigned int COL>
+inline std::size_t Mat<T, ROW, COL>::solveCholesky(const Mat<T, ROW, COL>* a, const Vec<T, ROW>* b, Vec<T, ROW>* x, const std::size_t& count) noexcept {
+    static_assert(ROW == COL);
+    static_assert(sizeof(Mat<T, ROW, COL>) == ROW * COL * sizeof(T) && sizeof(Vec<T, ROW>) == ROW * sizeof(T));
+
+    std::size_t singular = 0;
+    SIMD::blocks<T>(count, [&singular](const T* lanesA, const T* lanesB, T* lanesX, const std::size_t& n) { singular += SIMD::solveCholesky<ROW>(lanesA, lanesB, lanesX, n); }, a, b, x);
+
+    return singular;
+}
+
+template <typename T, unsigned int ROW, unsigned int COL>
+inline void Mat<T, ROW, COL>::eigen(Vec<T, ROW>& values, Mat<T, ROW, COL>& vectors) const noexcept { eigen(this, &values, &vectors, 1); }
+template <typename T, unsigned int ROW, unsigned int COL>
+inline void Mat<T, ROW, COL>::eigen(const Mat<T, ROW, COL>* m, Vec<T, ROW>* values, Mat<T, ROW, COL>* vectors, const std::size_t& count) noexcept {
+    static_assert(ROW == 3 && COL == 3);
+    static_assert(sizeof(Mat<T, ROW, COL>) == 9 * sizeof(T) && sizeof(Vec<T, ROW>) == 3 * sizeof(T));
+
+    SIMD::blocks<T>(count, [](const T* lanesM, T* lanesValues, T* lanesVectors, const std::size_t& n) { SIMD::eigen3(lanesM, lanesValues, lanesVectors, n); }, m, values, vectors);
+}
+
+template <typename T, unsigned int ROW, unsigned int COL>
+inline Mat<T, ROW, COL> Mat<T, ROW, COL>::covariance(const Vec3<T>* points, const std::size_t& count, Vec3<T>* mean) noexcept {
+    static_assert(ROW == 3 && COL == 3 && isFloat<T>);
+
+    // no points: zero, so an empty span of the batched overload is defined in every build
+    if (count == 0) {
+        if (mean != nullptr)
+            *mean = Vec3<T>{ };
+
+        return Mat<T, ROW, COL>{ };
+    }
+
+    // one pass, shifted by the first point so the raw sums do not cancel
+    const Vec3<T> origin = points[0];
+
+    T x{ }, y{ }, z{ }, xx{ }, yy{ }, zz{ }, xy{ }, xz{ }, yz{ };
+    for (std::size_t i = 0; i < count; ++i) {
+        const T dx = points[i].x - origin.x;
+        const T dy = points[i].y - origin.y;
+        const T dz = points[i].z - origin.z;
+
+        x  += dx;
+        y  += dy;
+        z  += dz;
+        xx += dx * dx;
+        yy += dy * dy;
+        zz += dz * dz;
+        xy += dx * dy;
+        xz += dx * dz;
+        yz += dy * dz;
+    }
+
+    const T inv = static_cast<T>(1) / static_cast<T>(count);
+
+    x *= inv;
+    y *= inv;
+    z *= inv;
+
+    if (mean != nullptr)
+        *mean = Vec3<T>{ origin.x + x, origin.y + y, origin.z + z };
+
+    const T cxy = xy * inv - x * y;
+    const T cxz = xz * inv - x * z;
+    const T cyz = yz * inv - y * z;
+
+    return {
+        Vec3<T>{ xx * inv - x * x,  cxy, cxz },
+        Vec3<T>{ cxy, yy * inv - y * y,  cyz },
+        Vec3<T>{ cxz, cyz, zz * inv - z * z  }
+    };
+}
+template <typename T, unsigned int ROW, unsigned int COL>
+void Mat<T, ROW, COL>::covariance(const Vec3<T>* points, const std::size_t* offsets, const std::size_t& spans, Mat<T, ROW, COL>* out, const unsigned int& threads) {
+    // smallest share of points a thread sums
+    constexpr std::size_t MIN_PER_THREAD = 65'536;
+
+    const auto run = [&](const std::size_t& begin, const std::size_t& end) {
+        for (std::size_t i = begin; i < end; ++i)
+            out[i] = covariance(points + offsets[i], offsets[i + 1] - offsets[i]);
+    };
+
+    // whole spans per worker
+    const std::size_t total = (spans == 0) ? 0 : offsets[spans] - offsets[0];
+    const unsigned int workers = Parallel::workers(threads, total, MIN_PER_THREAD, spans);
+
+    Parallel::run(workers, [&](const unsigned int& t) { run(spans * t / workers, spans * (t + 1) / workers); });
+}
+
+template <typename T, unsigned int ROW, unsigned int COL> template <typename F, unsigned int... I>
+inline constexpr void Mat<T, ROW, COL>::unroll(const F& f, std::integer_sequence<unsigned int, I...>) noexcept { (f(I), ...); }
+template <typename T, unsigned int ROW, unsigned int COL> template <typename F, unsigned int... I>
+inline constexpr T Mat<T, ROW, COL>::sum(const F& f, std::integer_sequence<unsigned int, I...>) noexcept { return static_cast<T>((f(I) + ...)); }
+
+template <typename T, unsigned int ROW, unsigned int COL>
+inline constexpr T Mat<T, ROW, COL>::invert(const Mat<T, ROW, COL>& m, Mat<T, ROW, COL>& out) noexcept {
+    static_assert(ROW == COL && ROW <= 3 && isFloat<T>);
+
+    const Vec<T, COL>* r = m.mROW;
+    const T det = m.determinant();
+    const T inv = static_cast<T>(1) / det;
+
+    if constexpr (ROW == 2) {
+        out[0][0] =  r[1][1] * inv;
+        out[0][1] = -r[0][1] * inv;
+        out[1][0] = -r[1][0] * inv;
+        out[1][1] =  r[0][0] * inv;
+    }
+    else {
+        // transposed cofactors
+        out[0][0] = (r[1][1] * r[2][2] - r[1][2] * r[2][1]) * inv;
+        out[0][1] = (r[0][2] * r[2][1] - r[0][1] * r[2][2]) * inv;
+        out[0][2] = (r[0][1] * r[1][2] - r[0][2] * r[1][1]) * inv;
+        out[1][0] = (r[1][2] * r[2][0] - r[1][0] * r[2][2]) * inv;
+        out[1][1] = (r[0][0] * r[2][2] - r[0][2] * r[2][0]) * inv;
+        out[1][2] = (r[0][2] * r[1][0] - r[0][0] * r[1][2]) * inv;
+        out[2][0] = (r[1][0] * r[2][1] - r[1][1] * r[2][0]) * inv;
+        out[2][1] = (r[0][1] * r[2][0] - r[0][0] * r[2][1]) * inv;
+        out[2][2] = (r[0][0] * r[1][1] - r[0][1] * r[1][0]) * inv;
+    }
+
+    return det;
+}
+
+static_assert(isTriviallyCopyable<Mat3<float>>  && isStandardLayout<Mat3<float>>);
+static_assert(isTriviallyCopyable<Mat3<double>> && isStandardLayout<Mat3<double>>);
+static_assert(sizeof(Mat3<float>) == 9 * sizeof(float) && sizeof(Mat2<float>) == 4 * sizeof(float));
\ No newline at end of file
@@ -0,0 +1,397 @@
+#pragma once
+
+#include "../base.hpp"
+#include "../math.hpp"
+#include "../simd.hpp"
+#include "../typeHandler.hpp"
+#include "../vector/vec3.hpp"
+#include "../vector/vec4.hpp"
+#include "mat4.hpp"
+
+#include <cassert>      // assert()
+
+// Affine transform: the top three rows of a Mat4 whose bottom row is (0, 0, 0, 1)
+template <typename T>
+class Mat<T, 3, 4> {
+    public:
+        constexpr Mat() noexcept = default;
+        constexpr Mat(const Mat<T, 3, 4>&) noexcept = default;
+        constexpr Mat(Mat<T, 3, 4>&&) noexcept = default;
+        ~Mat() noexcept = default;
+
+        template <typename U>
+        constexpr Mat(const Mat<U, 3, 4>&) noexcept;
+
+        template <typename U1, typename U2, typename U3>
+        constexpr Mat(const Vec4<U1>&, const Vec4<U2>&, const Vec4<U3>&) noexcept;
+
+        // the bottom row of the Mat4 must be (0, 0, 0, 1)
+        explicit constexpr Mat(const Mat<T, 4, 4>&);
+
+        constexpr Mat<T, 3, 4>& operator=(const Mat<T, 3, 4>&) noexcept = default;
+        constexpr Mat<T, 3, 4>& operator=(Mat<T, 3, 4>&&) noexcept = default;
+
+        template <typename U>
+        constexpr Mat<T, 3, 4>& operator=(const Mat<U, 3, 4>&) noexcept;
+        template <typename E>
+        constexpr Mat<T, 3, 4>& operator=(const Expr<E>&) noexcept;
+
+        template <typename U1, typename U2, typename U3>
+        constexpr Mat<T, 3, 4>& operator()(const Vec4<U1>&, const Vec4<U2>&, const Vec4<U3>&) noexcept;
+
+        constexpr Vec4<T>& operator[](const unsigned int& idx);
+        constexpr const Vec4<T>& operator[](const unsigned int& idx) const;
+
+        template <typename U> constexpr Mat<T, 3, 4>& operator*=(const Mat<U, 3, 4>&) noexcept;
+
+        template <typename U> inline constexpr Mat<T, 3, 4> operator*(const Mat<U, 3, 4>&) const noexcept;
+        template <typename U> inline constexpr Vec4<T> operator*(const Vec4<U>&) const noexcept;
+
+        template <typename U> inline constexpr Vec3<T> transformPoint(const Vec3<U>&) const noexcept;
+        template <typename U> inline constexpr Vec3<T> transformDirection(const Vec3<U>&) const noexcept;
+
+        inline constexpr T determinant() const noexcept;
+        inline constexpr Mat<T, 3, 4> inverse() const;
+        // false (out untouched) if the linear part is singular
+        inline constexpr bool tryInverse(Mat<T, 3, 4>&) const noexcept;
+        // linear part must be orthonormal (rotation + translation only)
+        inline constexpr Mat<T, 3, 4> inverseRigid() const noexcept;
+
+        inline constexpr Mat<T, 4, 4> toMat4() const noexcept;
+
+        static inline constexpr T determinant(const Mat<T, 3, 4>&) noexcept;
+        static inline constexpr Mat<T, 3, 4> inverse(const Mat<T, 3, 4>&);
+        static inline constexpr Mat<T, 3, 4> inverseRigid(const Mat<T, 3, 4>&) noexcept;
+        static inline constexpr Mat<T, 3, 4> identity() noexcept;
+
+        static inline constexpr Mat<T, 3, 4> translate(const Vec3<T>&) noexcept;
+        static inline constexpr Mat<T, 3, 4> scale(const Vec3<T>&) noexcept;
+        template <typename U> static inline Mat<T, 3, 4> rotateX(const U&) noexcept;
+        template <typename U> static inline Mat<T, 3, 4> rotateY(const U&) noexcept;
+        template <typename U> static inline Mat<T, 3, 4> rotateZ(const U&) noexcept;
+
+        template <typename U1, typename U2, typename U3>
+        static inline constexpr Mat<T, 3, 4> translate(const U1&, const U2&, const U3&) noexcept;
+        template <typename U>
+        static inline constexpr Mat<T, 3, 4> scale(const U&) noexcept;
+
+    // the twelve lanes as one array for the SIMD kernels (as Mat4::lanes)
+    private:
+        struct Lanes { T at[12]; };
+
+        inline Lanes lanes() const noexcept;
+
+        // out = inverse of the linear part scaled by det, returns det
+        static inline constexpr T invert(const Mat<T, 3, 4>&, Mat<T, 3, 4>&) noexcept;
+        // SIMD::mul3x4 of a and b, into lanes nothing zeroes first (not constexpr, as Mat4::product)
+        static inline Mat<T, 3, 4> product(const Lanes& a, const Lanes& b) noexcept;
+
+    public:
+        Vec4<T> mROW[3];
+};
+template <typename T> using Mat3x4 = Mat<T, 3, 4>;
+
+template <typename T> template <typename U>
+constexpr Mat<T, 3, 4>::Mat(const Mat<U, 3, 4>& other) noexcept { *this = other; }
+
+template <typename T> template <typename U1, typename U2, typename U3>
+constexpr Mat<T, 3, 4>::Mat(const Vec4<U1>& v1, const Vec4<U2>& v2, const Vec4<U3>& v3) noexcept { (*this)(v1, v2, v3); }
+
+template <typename T>
+constexpr Mat<T, 3, 4>::Mat(const Mat<T, 4, 4>& m) {
+    assert(m.mROW[3].x == 0 && m.mROW[3].y == 0 && m.mROW[3].z == 0 && m.mROW[3].w == 1);
+
+    (*this)(m.mROW[0], m.mROW[1], m.mROW[2]);
+}
+
+template <typename T> template <typename U>
+constexpr Mat<T, 3, 4>& Mat<T, 3, 4>::operator=(const Mat<U, 3, 4>& other) noexcept {
+    mROW[0] = static_cast<Vec4<T>>(other.mROW[0]);
+    mROW[1] = static_cast<Vec4<T>>(other.mROW[1]);
+    mROW[2] = static_cast<Vec4<T>>(other.mROW[2]);
+
+    return *this;
+}
+template <typename T> template <typename E>
+constexpr Mat<T, 3, 4>& Mat<T, 3, 4>::operator=(const Expr<E>& e) noexcept {
+    static_assert((E::ROWS == 3) && (E::COLS == 4));
+
+    const Vec4<T> r0{ e[0], e[1], e[2],  e[3]  };
+    const Vec4<T> r1{ e[4], e[5], e[6],  e[7]  };
+    const Vec4<T> r2{ e[8], e[9], e[10], e[11] };
+
+    mROW[0] = r0;
+    mROW[1] = r1;
+    mROW[2] = r2;
+
+    return *this;
+}
+
+template <typename T> template <typename U1, typename U2, typename U3>
+constexpr Mat<T, 3, 4>& Mat<T, 3, 4>::operator()(const Vec4<U1>& v1, const Vec4<U2>& v2, const Vec4<U3>& v3) noexcept {
+    mROW[0] = v1;
+    mROW[1] = v2;
+    mROW[2] = v3;
+
+    return *this;
+}
+
+template <typename T> constexpr Vec4<T>& Mat<T, 3, 4>::operator[](const unsigned int& idx) {
+    assert(idx < 3);
+
+    return mROW[idx];
+}
+template <typename T> constexpr const Vec4<T>& Mat<T, 3, 4>::operator[](const unsigned int& idx) const {
+    assert(idx < 3);
+
+    return mROW[idx];
+}
+
+template <typename T> template <typename U>
+constexpr Mat<T, 3, 4>& Mat<T, 3, 4>::operator*=(const Mat<U, 3, 4>& other) noexcept { return (*this = ((*this) * other)); }
+
+// 36 multiplies (48 lane-wise for float): the implicit (0, 0, 0, 1) rows only carry the translation through
+template <typename T> template <typename U>
+inline constexpr Mat<T, 3, 4> Mat<T, 3, 4>::operator*(const Mat<U, 3, 4>& other) const noexcept {
+    if constexpr (SIMD::packed4<T, U>) {
+        if (!isConstantEvaluated())
+            return product(lanes(), other.lanes());
+    }
+
+    const Vec4<U>& b0 = other.mROW[0];
+    const Vec4<U>& b1 = other.mROW[1];
+    const Vec4<U>& b2 = other.mROW[2];
+
+    const auto row = [&](const Vec4<T>& a) {
+        // float: the Mat4 sums with the implicit (0, 0, 0, 1) row spelled out, the same in every lane, so that the
+        // compiler keeps a row in one register (bit-identical to toMat4() * other.toMat4()). Two-lane double is faster without
+        if constexpr (isSame<T, float> && isSame<U, float>) {
+            return Vec4<T>{
+                a.x * b0.x + a.y * b1.x + a.z * b2.x + a.w * static_cast<T>(0),
+                a.x * b0.y + a.y * b1.y + a.z * b2.y + a.w * static_cast<T>(0),
+                a.x * b0.z + a.y * b1.z + a.z * b2.z + a.w * static_cast<T>(0),
+                a.x * b0.w + a.y * b1.w + a.z * b2.w + a.w * static_cast<T>(1)
+            };
+        }
+        else {
+            return Vec4<T>{
+                static_cast<T>(a.x * b0.x + a.y * b1.x + a.z * b2.x),
+                static_cast<T>(a.x * b0.y + a.y * b1.y + a.z * b2.y),
+                static_cast<T>(a.x * b0.z + a.y * b1.z + a.z * b2.z),
+                static_cast<T>(a.x * b0.w + a.y * b1.w + a.z * b2.w + a.w)
+            };
+        }
+    };
+
+    return { row(mROW[0]), row(mROW[1]), row(mROW[2]) };
+}
+template <typename T> template <typename U>
+inline constexpr Vec4<T> Mat<T, 3, 4>::operator*(const Vec4<U>& v) const noexcept {
+    return {
+        mROW[0].dot(v),
+        mROW[1].dot(v),
+        mROW[2].dot(v),
+        static_cast<T>(v.w)
+    };
+}
+
+template <typename T> template <typename U>
+inline constexpr Vec3<T> Mat<T, 3, 4>::transformPoint(const Vec3<U>& p) const noexcept {
+    return {
+        static_cast<T>(mROW[0].x * p.x + mROW[0].y * p.y + mROW[0].z * p.z + mROW[0].w),
+        static_cast<T>(mROW[1].x * p.x + mROW[1].y * p.y + mROW[1].z * p.z + mROW[1].w),
+        static_cast<T>(mROW[2].x * p.x + mROW[2].y * p.y + mROW[2].z * p.z + mROW[2].w)
+    };
+}
+template <typename T> template <typename U>
+inline constexpr Vec3<T> Mat<T, 3, 4>::transformDirection(const Vec3<U>& d) const noexcept {
+    return {
+        static_cast<T>(mROW[0].x * d.x + mROW[0].y * d.y + mROW[0].z * d.z),
+        static_cast<T>(mROW[1].x * d.x + mROW[1].y * d.y + mROW[1].z * d.z),
+        static_cast<T>(mROW[2].x * d.x + mROW[2].y * d.y + mROW[2].z * d.z)
+    };
+}
+
+template <typename T> inline constexpr T Mat<T, 3, 4>::determinant() const noexcept {
+    const Vec3<T> a{ mROW[0].x, mROW[0].y, mROW[0].z };
+    const Vec3<T> b{ mROW[1].x, mROW[1].y, mROW[1].z };
+    const Vec3<T> c{ mROW[2].x, mROW[2].y, mROW[2].z };
+
+    return a.dot(b.cross(c));
+}
+template <typename T> inline constexpr Mat<T, 3, 4> Mat<T, 3, 4>::inverse() const {
+    Mat<T, 3, 4> result{ };
+    const bool invertible = Math::invert(*this, result, &invert);
+
+    assert(invertible);
+    (void)invertible;
+
+    return result;
+}
+template <typename T> inline constexpr bool Mat<T, 3, 4>::tryInverse(Mat<T, 3, 4>& out) const noexcept {
+    Mat<T, 3, 4> result{ };
+
+    if (!Math::invert(*this, result, &invert))
+        return false;
+
+    out = result;
+
+    return true;
+}
+// R^-1 = R^T, t' = -R^T t
+template <typename T> inline constexpr Mat<T, 3, 4> Mat<T, 3, 4>::inverseRigid() const noexcept {
+    const Vec4<T>& r0 = mROW[0];
+    const Vec4<T>& r1 = mROW[1];
+    const Vec4<T>& r2 = mROW[2];
+
+    return {
+        Vec4<T>{ r0.x, r1.x, r2.x, -(r0.x * r0.w + r1.x * r1.w + r2.x * r2.w) },
+        Vec4<T>{ r0.y, r1.y, r2.y, -(r0.y * r0.w + r1.y * r1.w + r2.y * r2.w) },
+        Vec4<T>{ r0.z, r1.z, r2.z, -(r0.z * r0.w + r1.z * r1.w + r2.z * r2.w) }
+    };
+}
+
+template <typename T> inline constexpr Mat<T, 4, 4> Mat<T, 3, 4>::toMat4() const noexcept {
+    constexpr T zero = static_cast<T>(0);
+    constexpr T one  = static_cast<T>(1);
+
+    return { mROW[0], mROW[1], mROW[2], Vec4<T>{ zero, zero, zero, one } };
+}
+
+template <typename T> inline constexpr T Mat<T, 3, 4>::determinant(const Mat<T, 3, 4>& m) noexcept { return m.determinant(); }
+template <typename T> inline constexpr Mat<T, 3, 4> Mat<T, 3, 4>::inverse(const Mat<T, 3, 4>& m) { return m.inverse(); }
+template <typename T> inline constexpr Mat<T, 3, 4> Mat<T, 3, 4>::inverseRigid(const Mat<T, 3, 4>& m) noexcept { return m.inverseRigid(); }
+template <typename T> inline constexpr Mat<T, 3, 4> Mat<T, 3, 4>::identity() noexcept {
+    constexpr T zero = static_cast<T>(0);
+    constexpr T one  = static_cast<T>(1);
+
+    return {
+        Vec4<T>{  one, zero, zero, zero },
+        Vec4<T>{ zero,  one, zero, zero },
+        Vec4<T>{ zero, zero,  one, zero }
+    };
+}
+
+template <typename T> inline constexpr Mat<T, 3, 4> Mat<T, 3, 4>::translate(const Vec3<T>& v) noexcept {
+    constexpr T zero = static_cast<T>(0);
+    constexpr T one  = static_cast<T>(1);
+
+    return {
+        Vec4<T>{  one, zero, zero,  v.x },
+        Vec4<T>{ zero,  one, zero,  v.y },
+        Vec4<T>{ zero, zero,  one,  v.z }
+    };
+}
+template <typename T> inline constexpr Mat<T, 3, 4> Mat<T, 3, 4>::scale(const Vec3<T>& v) noexcept {
+    constexpr T zero = static_cast<T>(0);
+
+    return {
+        Vec4<T>{  v.x, zero, zero, zero },
+        Vec4<T>{ zero,  v.y, zero, zero },
+        Vec4<T>{ zero, zero,  v.z, zero }
+    };
+}
+template <typename T> template <typename U> inline Mat<T, 3, 4> Mat<T, 3, 4>::rotateX(const U& val) noexcept {
+    Mat<T, 3, 4> Rx;
+
+    using F = IF<isFloat<T>, T, double>;
+
+    F sf{ }, cf{ };
+    Math::sincos(Math::toRad(static_cast<F>(val)), sf, cf);
+
+    const T s = static_cast<T>(sf);
+    const T c = static_cast<T>(cf);
+
+    Rx.mROW[0].x = static_cast<T>(1);
+    Rx.mROW[1](static_cast<T>(0), c, -s);
+    Rx.mROW[2](static_cast<T>(0), s,  c);
+
+    return Rx;
+}
+template <typename T> template <typename U> inline Mat<T, 3, 4> Mat<T, 3, 4>::rotateY(const U& val) noexcept {
+    Mat<T, 3, 4> Ry;
+
+    using F = IF<isFloat<T>, T, double>;
+
+    F sf{ }, cf{ };
+    Math::sincos(Math::toRad(static_cast<F>(val)), sf, cf);
+
+    const T s = static_cast<T>(sf);
+    const T c = static_cast<T>(cf);
+
+    Ry.mROW[0]( c, static_cast<T>(0), s);
+    Ry.mROW[1].y = static_cast<T>(1);
+    Ry.mROW[2](-s, static_cast<T>(0), c);
+
+    return Ry;
+}
+template <typename T> template <typename U> inline Mat<T, 3, 4> Mat<T, 3, 4>::rotateZ(const U& val) noexcept {
+    Mat<T, 3, 4> Rz;
+
+    using F = IF<isFloat<T>, T, double>;
+
+    F sf{ }, cf{ };
+    Math::sincos(Math::toRad(static_cast<F>(val)), sf, cf);
+
+    const T s = static_cast<T>(sf);
+    const T c = static_cast<T>(cf);
+
+    Rz.mROW[0](c, -s);
+    Rz.mROW[1](s,  c);
+    Rz.mROW[2].z = static_cast<T>(1);
+
+    return Rz;
+}
+
+template <typename T> template <typename U1, typename U2, typename U3>
+inline constexpr Mat<T, 3, 4> Mat<T, 3, 4>::translate(const U1& x, const U2& y, const U3& z) noexcept { return Mat<T, 3, 4>::translate({x, y, z}); }
+template <typename T> template <typename U>
+inline constexpr Mat<T, 3, 4> Mat<T, 3, 4>::scale(const U& val) noexcept { return Mat<T, 3, 4>::scale({val, val, val}); }
+
+// rows a, b, c: L^-1 has columns (b x c, c x a, a x b) / det, t' = -L^-1 t
+template <typename T>
+inline constexpr T Mat<T, 3, 4>::invert(const Mat<T, 3, 4>& m, Mat<T, 3, 4>& out) noexcept {
+    static_assert(isFloat<T>);
+
+    const Vec3<T> a{ m.mROW[0].x, m.mROW[0].y, m.mROW[0].z };
+    const Vec3<T> b{ m.mROW[1].x, m.mROW[1].y, m.mROW[1].z };
+    const Vec3<T> c{ m.mROW[2].x, m.mROW[2].y, m.mROW[2].z };
+
+    const Vec3<T> bc = b.cross(c);
+    const Vec3<T> ca = c.cross(a);
+    const Vec3<T> ab = a.cross(b);
+
+    const T det = a.dot(bc);
+    const T inv = static_cast<T>(1) / det;
+
+    const Vec3<T> t{ m.mROW[0].w, m.mROW[1].w, m.mROW[2].w };
+
+    out.mROW[0] = Vec4<T>{ bc.x * inv, ca.x * inv, ab.x * inv, -(bc.x * t.x + ca.x * t.y + ab.x * t.z) * inv };
+    out.mROW[1] = Vec4<T>{ bc.y * inv, ca.y * inv, ab.y * inv, -(bc.y * t.x + ca.y * t.y + ab.y * t.z) * inv };
+    out.mROW[2] = Vec4<T>{ bc.z * inv, ca.z * inv, ab.z * inv, -(bc.z * t.x + ca.z * t.y + ab.z * t.z) * inv };
+
+    return det;
+}
+template <typename T>
+inline Mat<T, 3, 4> Mat<T, 3, 4>::product(const Lanes& a, const Lanes& b) noexcept {
+    T out[12];
+    SIMD::mul3x4(a.at, b.at, out);
+
+    return {
+        Vec4<T>{ out[0], out[1], out[2],  out[3]  },
+        Vec4<T>{ out[4], out[5], out[6],  out[7]  },
+        Vec4<T>{ out[8], out[9], out[10], out[11] }
+    };
+}
+template <typename T>
+inline typename Mat<T, 3, 4>::Lanes Mat<T, 3, 4>::lanes() const noexcept {
+    return { {
+        mROW[0].x, mROW[0].y, mROW[0].z, mROW[0].w,
+        mROW[1].x, mROW[1].y, mROW[1].z, mROW[1].w,
+        mROW[2].x, mROW[2].y, mROW[2].z, mROW[2].w
+    } };
+}
+
+static_assert(isTriviallyCopyable<Mat3x4<float>>  && isStandardLayout<Mat3x4<float>>);
+static_assert(isTriviallyCopyable<Mat3x4<double>> && isStandardLayout<Mat3x4<double>>);
+static_assert(sizeof(Mat3x4<float>) == 3 * sizeof(Vec4<float>));
\ No newline at end of file
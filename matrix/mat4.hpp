@@ -2,68 +2,75 @@
 
 #include "../base.hpp"
 #include "../math.hpp"
+#include "../simd.hpp"
 #include "../typeHandler.hpp"
 #include "../vector/vec3.hpp"
 #include "../vector/vec4.hpp"
 
 #include <cassert>      // assert()
-#include <cmath>        // sin(), cos()
+#include <cmath>        // asin(), atan2()
+#include <cstddef>      // size_t
 
 template <typename T>
 class Mat<T, 4, 4> {
     public:
-        Mat() noexcept;
-        Mat(const Mat<T, 4, 4>&) noexcept;
-        Mat(Mat<T, 4, 4>&&) noexcept;
-        ~Mat() noexcept;
+        constexpr Mat() noexcept = default;
+        constexpr Mat(const Mat<T, 4, 4>&) noexcept = default;
+        constexpr Mat(Mat<T, 4, 4>&&) noexcept = default;
+        ~Mat() noexcept = default;
 
         template <typename U>
-        Mat(const Mat<U, 4, 4>&) noexcept;
-        template <typename U>
-        Mat(Mat<U, 4, 4>&&) noexcept;
+        constexpr Mat(const Mat<U, 4, 4>&) noexcept;
 
         template <typename U1, typename U2, typename U3, typename U4>
-        Mat(const Vec4<U1>&, const Vec4<U2>&, const Vec4<U3>&, const Vec4<U4>&) noexcept;
+        constexpr Mat(const Vec4<U1>&, const Vec4<U2>&, const Vec4<U3>&, const Vec4<U4>&) noexcept;
 
-        Mat<T, 4, 4>& operator=(const Mat<T, 4, 4>&) noexcept;
-        Mat<T, 4, 4>& operator=(Mat<T, 4, 4>&&) noexcept;
+        constexpr Mat<T, 4, 4>& operator=(const Mat<T, 4, 4>&) noexcept = default;
+        constexpr Mat<T, 4, 4>& operator=(Mat<T, 4, 4>&&) noexcept = default;
 
         template <typename U>
-        Mat<T, 4, 4>& operator=(const Mat<U, 4, 4>&) noexcept;
-        template <typename U>
-        Mat<T, 4, 4>& operator=(Mat<U, 4, 4>&&) noexcept;
+        constexpr Mat<T, 4, 4>& operator=(const Mat<U, 4, 4>&) noexcept;
+        template <typename E>
+        constexpr Mat<T, 4, 4>& operator=(const Expr<E>&) noexcept;
 
         template <typename U1, typename U2, typename U3, typename U4>
-        Mat<T, 4, 4>& operator()(const Vec4<U1>&, const Vec4<U2>&, const Vec4<U3>&, const Vec4<U4>&) noexcept;
-
-        Vec4<T>& operator[](const unsigned int& idx);
-        const Vec4<T>& operator[](const unsigned int& idx) const;
-
-        template <typename U> Mat<T, 4, 4>& operator+=(const Mat<U, 4, 4>&) noexcept;
-        template <typename U> Mat<T, 4, 4>& operator-=(const Mat<U, 4, 4>&) noexcept;
-        template <typename U> Mat<T, 4, 4>& operator*=(const Mat<U, 4, 4>&) noexcept;
-        template <typename U> Mat<T, 4, 4>& operator+=(const U&) noexcept;
-        template <typename U> Mat<T, 4, 4>& operator-=(const U&) noexcept;
-        template <typename U> Mat<T, 4, 4>& operator*=(const U&) noexcept;
-        template <typename U> Mat<T, 4, 4>& operator/=(const U&);
-
-        template <typename U> inline Mat<T, 4, 4> operator+(const Mat<U, 4, 4>&) const noexcept;
-        template <typename U> inline Mat<T, 4, 4> operator-(const Mat<U, 4, 4>&) const noexcept;
-        template <typename U> inline Mat<T, 4, 4> operator*(const Mat<U, 4, 4>&) const noexcept;
-        template <typename U> inline Mat<T, 4, 4> operator+(const U&) const noexcept;
-        template <typename U> inline Mat<T, 4, 4> operator-(const U&) const noexcept;
-        template <typename U> inline Mat<T, 4, 4> operator*(const U&) const noexcept;
-        template <typename U> inline Mat<T, 4, 4> operator/(const U&) const;
+        constexpr Mat<T, 4, 4>& operator()(const Vec4<U1>&, const Vec4<U2>&, const Vec4<U3>&, const Vec4<U4>&) noexcept;
+
+        constexpr Vec4<T>& operator[](const unsigned int& idx);
+        constexpr const Vec4<T>& operator[](const unsigned int& idx) const;
+
+        template <typename U> constexpr Mat<T, 4, 4>& operator+=(const Mat<U, 4, 4>&) noexcept;
+        template <typename U> constexpr Mat<T, 4, 4>& operator-=(const Mat<U, 4, 4>&) noexcept;
+        template <typename U> constexpr Mat<T, 4, 4>& operator*=(const Mat<U, 4, 4>&) noexcept;
+        template <typename U> constexpr Mat<T, 4, 4>& operator+=(const U&) noexcept;
+        template <typename U> constexpr Mat<T, 4, 4>& operator-=(const U&) noexcept;
+        template <typename U> constexpr Mat<T, 4, 4>& operator*=(const U&) noexcept;
+        template <typename U> constexpr Mat<T, 4, 4>& operator/=(const U&);
+
+        template <typename U> inline constexpr Mat<T, 4, 4> operator+(const Mat<U, 4, 4>&) const noexcept;
+        template <typename U> inline constexpr Mat<T, 4, 4> operator-(const Mat<U, 4, 4>&) const noexcept;
+        template <typename U> inline constexpr Mat<T, 4, 4> operator*(const Mat<U, 4, 4>&) const noexcept;
+        template <typename U> inline constexpr Vec4<T> operator*(const Vec4<U>&) const noexcept;
+        template <typename U> inline constexpr Mat<T, 4, 4> operator+(const U&) const noexcept;
+        template <typename U> inline constexpr Mat<T, 4, 4> operator-(const U&) const noexcept;
+        template <typename U> inline constexpr Mat<T, 4, 4> operator*(const U&) const noexcept;
+        template <typename U> inline constexpr Mat<T, 4, 4> operator/(const U&) const;
 
         inline constexpr T trace() const noexcept;
-        inline Mat<T, 4, 4> transpose() const noexcept;
+        inline constexpr T determinant() const noexcept;
+        inline constexpr Mat<T, 4, 4> transpose() const noexcept;
+        inline constexpr Mat<T, 4, 4> inverse() const;
+        // false (out untouched) if the matrix is singular
+        inline constexpr bool tryInverse(Mat<T, 4, 4>&) const noexcept;
 
         static inline constexpr T trace(const Mat<T, 4, 4>&) noexcept;
-        static inline Mat<T, 4, 4> transpose(const Mat<T, 4, 4>&) noexcept;
-        static inline Mat<T, 4, 4> identity() noexcept;
+        static inline constexpr T determinant(const Mat<T, 4, 4>&) noexcept;
+        static inline constexpr Mat<T, 4, 4> transpose(const Mat<T, 4, 4>&) noexcept;
+        static inline constexpr Mat<T, 4, 4> inverse(const Mat<T, 4, 4>&);
+        static inline constexpr Mat<T, 4, 4> identity() noexcept;
 
-        static inline Mat<T, 4, 4> translate(const Vec3<T>&) noexcept;
-        static inline Mat<T, 4, 4> scale(const Vec3<T>&) noexcept;
+        static inline constexpr Mat<T, 4, 4> translate(const Vec3<T>&) noexcept;
+        static inline constexpr Mat<T, 4, 4> scale(const Vec3<T>&) noexcept;
         template <typename U> static inline Mat<T, 4, 4> rotateX(const U&) noexcept;
         template <typename U> static inline Mat<T, 4, 4> rotateY(const U&) noexcept;
         template <typename U> static inline Mat<T, 4, 4> rotateZ(const U&) noexcept;
@@ -73,52 +80,59 @@ class Mat<T, 4, 4> {
         static inline Mat<T, 4, 4> projection(const U1&, const U2&, const U3&, const U4&) noexcept;
 
         template <typename U1, typename U2, typename U3>
-        static inline Mat<T, 4, 4> translate(const U1&, const U2&, const U3&) noexcept;
+        static inline constexpr Mat<T, 4, 4> translate(const U1&, const U2&, const U3&) noexcept;
         template <typename U>
-        static inline Mat<T, 4, 4> scale(const U&) noexcept;
+        static inline constexpr Mat<T, 4, 4> scale(const U&) noexcept;
+
+        // translate(t) * rotateZ(r.z) * rotateY(r.y) * rotateX(r.x) * scale(s), built in one pass
+        static inline Mat<T, 4, 4> fromTRS(const Vec3<T>& t, const Vec3<T>& r, const Vec3<T>& s) noexcept;
+        static inline void fromTRS(const Vec3<T>* t, const Vec3<T>* r, const Vec3<T>* s, Mat<T, 4, 4>* dst, const std::size_t&) noexcept;
+        // inverse of fromTRS for affine matrices without shear (a reflection goes into s.x)
+        static inline void decomposeTRS(const Mat<T, 4, 4>&, Vec3<T>& t, Vec3<T>& r, Vec3<T>& s) noexcept;
+
+        // dst[i] = m * src[i] over whole arrays (dst may equal src)
+        static inline void transformPoints(const Mat<T, 4, 4>&, const Vec3<T>*, Vec3<T>*, const std::size_t&) noexcept;
+        static inline void transformDirections(const Mat<T, 4, 4>&, const Vec3<T>*, Vec3<T>*, const std::size_t&) noexcept;
+        static inline void transformHomogeneous(const Mat<T, 4, 4>&, const Vec4<T>*, Vec4<T>*, const std::size_t&) noexcept;
+
+        static inline void transformPoints(const Mat<T, 4, 4>&, Vec3<T>*, const std::size_t&) noexcept;
+        static inline void transformDirections(const Mat<T, 4, 4>&, Vec3<T>*, const std::size_t&) noexcept;
+        static inline void transformHomogeneous(const Mat<T, 4, 4>&, Vec4<T>*, const std::size_t&) noexcept;
+
+        // x[i] = inverse(a[i]) * b[i] over whole arrays, returns how many a[i] were singular (their x[i] is zero)
+        static inline std::size_t solve(const Mat<T, 4, 4>* a, const Vec4<T>* b, Vec4<T>* x, const std::size_t&) noexcept;
+        // the same for symmetric positive definite a[i] (only the lower triangles are read), returns how many were not
+        static inline std::size_t solveCholesky(const Mat<T, 4, 4>* a, const Vec4<T>* b, Vec4<T>* x, const std::size_t&) noexcept;
+
+    // the sixteen lanes as one array for the SIMD kernels (as Vec4::lanes, the rows are separate objects)
+    private:
+        struct Lanes { T at[16]; };
+
+        inline Lanes lanes() const noexcept;
+        inline void lanes(const Lanes&) noexcept;
+
+        // out = adj(m) / det(m), returns det(m)
+        static inline constexpr T invert(const Mat<T, 4, 4>&, Mat<T, 4, 4>&) noexcept;
+        // SIMD::mul4x4 of a and b, into lanes nothing zeroes first (not constexpr: C++17 wants every local set there).
+        // Takes the lanes: copied in operator*, GCC still inlines it into large callers
+        static inline Mat<T, 4, 4> product(const Lanes& a, const Lanes& b) noexcept;
+        // fromTRS from the sines / cosines of r.x, r.y, r.z
+        template <typename F>
+        static inline Mat<T, 4, 4> compose(const Vec3<T>& t, const F* sin, const F* cos, const Vec3<T>& s) noexcept;
 
     public:
         Vec4<T> mROW[4];
 };
 template <typename T> using Mat4 = Mat<T, 4, 4>;
 
-template <typename T> Mat<T, 4, 4>::Mat() noexcept { }
-template <typename T> Mat<T, 4, 4>::Mat(const Mat<T, 4, 4>& other) noexcept { *this = other; }
-template <typename T> Mat<T, 4, 4>::Mat(Mat<T, 4, 4>&& other) noexcept { *this = move(other); }
-template <typename T> Mat<T, 4, 4>::~Mat() noexcept { }
-
 template <typename T> template <typename U>
-Mat<T, 4, 4>::Mat(const Mat<U, 4, 4>& other) noexcept { *this = other; }
-template <typename T> template <typename U>
-Mat<T, 4, 4>::Mat(Mat<U, 4, 4>&& other) noexcept { *this = move(other); }
+constexpr Mat<T, 4, 4>::Mat(const Mat<U, 4, 4>& other) noexcept { *this = other; }
 
 template <typename T> template <typename U1, typename U2, typename U3, typename U4>
-Mat<T, 4, 4>::Mat(const Vec4<U1>& v1, const Vec4<U2>& v2, const Vec4<U3>& v3, const Vec4<U4>& v4) noexcept { (*this)(v1, v2, v3, v4); }
-
-template <typename T> Mat<T, 4, 4>& Mat<T, 4, 4>::operator=(const Mat<T, 4, 4>& other) noexcept {
-    mROW[0] = other.mROW[0];
-    mROW[1] = other.mROW[1];
-    mROW[2] = other.mROW[2];
-    mROW[3] = other.mROW[3];
-
-    return *this;
-}
-template <typename T> Mat<T, 4, 4>& Mat<T, 4, 4>::operator=(Mat<T, 4, 4>&& other) noexcept {
-    mROW[0] = other.mROW[0];
-    mROW[1] = other.mROW[1];
-    mROW[2] = other.mROW[2];
-    mROW[3] = other.mROW[3];
-
-    other.mROW[0] = { };
-    other.mROW[1] = { };
-    other.mROW[2] = { };
-    other.mROW[3] = { };
-
-    return *this;
-}
+constexpr Mat<T, 4, 4>::Mat(const Vec4<U1>& v1, const Vec4<U2>& v2, const Vec4<U3>& v3, const Vec4<U4>& v4) noexcept { (*this)(v1, v2, v3, v4); }
 
 template <typename T> template <typename U>
-Mat<T, 4, 4>& Mat<T, 4, 4>::operator=(const Mat<U, 4, 4>& other) noexcept {
+constexpr Mat<T, 4, 4>& Mat<T, 4, 4>::operator=(const Mat<U, 4, 4>& other) noexcept {
     mROW[0] = static_cast<Vec4<T>>(other.mROW[0]);
     mROW[1] = static_cast<Vec4<T>>(other.mROW[1]);
     mROW[2] = static_cast<Vec4<T>>(other.mROW[2]);
@@ -126,23 +140,25 @@ Mat<T, 4, 4>& Mat<T, 4, 4>::operator=(const Mat<U, 4, 4>& other) noexcept {
 
     return *this;
 }
-template <typename T> template <typename U>
-Mat<T, 4, 4>& Mat<T, 4, 4>::operator=(Mat<U, 4, 4>&& other) noexcept {
-    mROW[0] = static_cast<Vec4<T>>(other.mROW[0]);
-    mROW[1] = static_cast<Vec4<T>>(other.mROW[1]);
-    mROW[2] = static_cast<Vec4<T>>(other.mROW[2]);
-    mROW[3] = static_cast<Vec4<T>>(other.mROW[3]);
+template <typename T> template <typename E>
+constexpr Mat<T, 4, 4>& Mat<T, 4, 4>::operator=(const Expr<E>& e) noexcept {
+    static_assert((E::ROWS == 4) && (E::COLS == 4));
+
+    const Vec4<T> r0{ e[0],  e[1],  e[2],  e[3]  };
+    const Vec4<T> r1{ e[4],  e[5],  e[6],  e[7]  };
+    const Vec4<T> r2{ e[8],  e[9],  e[10], e[11] };
+    const Vec4<T> r3{ e[12], e[13], e[14], e[15] };
 
-    other.mROW[0] = { };
-    other.mROW[1] = { };
-    other.mROW[2] = { };
-    other.mROW[3] = { };
+    mROW[0] = r0;
+    mROW[1] = r1;
+    mROW[2] = r2;
+    mROW[3] = r3;
 
     return *this;
 }
 
 template <typename T> template <typename U1, typename U2, typename U3, typename U4>
-Mat<T, 4, 4>& Mat<T, 4, 4>::operator()(const Vec4<U1>& v1, const Vec4<U2>& v2, const Vec4<U3>& v3, const Vec4<U4>& v4) noexcept {
+constexpr Mat<T, 4, 4>& Mat<T, 4, 4>::operator()(const Vec4<U1>& v1, const Vec4<U2>& v2, const Vec4<U3>& v3, const Vec4<U4>& v4) noexcept {
     mROW[0] = v1;
     mROW[1] = v2;
     mROW[2] = v3;
@@ -151,19 +167,19 @@ Mat<T, 4, 4>& Mat<T, 4, 4>::operator()(const Vec4<U1>& v1, const Vec4<U2>& v2, c
     return *this;
 }
 
-template <typename T> Vec4<T>& Mat<T, 4, 4>::operator[](const unsigned int& idx) {
+template <typename T> constexpr Vec4<T>& Mat<T, 4, 4>::operator[](const unsigned int& idx) {
     assert(idx < 4);
 
     return mROW[idx];
 }
-template <typename T> const Vec4<T>& Mat<T, 4, 4>::operator[](const unsigned int& idx) const {
+template <typename T> constexpr const Vec4<T>& Mat<T, 4, 4>::operator[](const unsigned int& idx) const {
     assert(idx < 4);
 
     return mROW[idx];
 }
 
 template <typename T> template <typename U>
-Mat<T, 4, 4>& Mat<T, 4, 4>::operator+=(const Mat<U, 4, 4>& other) noexcept {
+constexpr Mat<T, 4, 4>& Mat<T, 4, 4>::operator+=(const Mat<U, 4, 4>& other) noexcept {
     mROW[0] += other.mROW[0];
     mROW[1] += other.mROW[1];
     mROW[2] += other.mROW[2];
@@ -172,7 +188,7 @@ Mat<T, 4, 4>& Mat<T, 4, 4>::operator+=(const Mat<U, 4, 4>& other) noexcept {
     return *this;
 }
 template <typename T> template <typename U>
-Mat<T, 4, 4>& Mat<T, 4, 4>::operator-=(const Mat<U, 4, 4>& other) noexcept {
+constexpr Mat<T, 4, 4>& Mat<T, 4, 4>::operator-=(const Mat<U, 4, 4>& other) noexcept {
     mROW[0] -= other.mROW[0];
     mROW[1] -= other.mROW[1];
     mROW[2] -= other.mROW[2];
@@ -181,9 +197,9 @@ Mat<T, 4, 4>& Mat<T, 4, 4>::operator-=(const Mat<U, 4, 4>& other) noexcept {
     return *this;
 }
 template <typename T> template <typename U>
-Mat<T, 4, 4>& Mat<T, 4, 4>::operator*=(const Mat<U, 4, 4>& other) noexcept { return (*this = ((*this) * other)); }
+constexpr Mat<T, 4, 4>& Mat<T, 4, 4>::operator*=(const Mat<U, 4, 4>& other) noexcept { return (*this = ((*this) * other)); }
 template <typename T> template <typename U>
-Mat<T, 4, 4>& Mat<T, 4, 4>::operator+=(const U& val) noexcept {
+constexpr Mat<T, 4, 4>& Mat<T, 4, 4>::operator+=(const U& val) noexcept {
     mROW[0] += val;
     mROW[1] += val;
     mROW[2] += val;
@@ -192,7 +208,7 @@ Mat<T, 4, 4>& Mat<T, 4, 4>::operator+=(const U& val) noexcept {
     return *this;
 }
 template <typename T> template <typename U>
-Mat<T, 4, 4>& Mat<T, 4, 4>::operator-=(const U& val) noexcept {
+constexpr Mat<T, 4, 4>& Mat<T, 4, 4>::operator-=(const U& val) noexcept {
     mROW[0] -= val;
     mROW[1] -= val;
     mROW[2] -= val;
@@ -201,7 +217,7 @@ Mat<T, 4, 4>& Mat<T, 4, 4>::operator-=(const U& val) noexcept {
     return *this;
 }
 template <typename T> template <typename U>
-Mat<T, 4, 4>& Mat<T, 4, 4>::operator*=(const U& val) noexcept {
+constexpr Mat<T, 4, 4>& Mat<T, 4, 4>::operator*=(const U& val) noexcept {
     mROW[0] *= val;
     mROW[1] *= val;
     mROW[2] *= val;
@@ -210,7 +226,7 @@ Mat<T, 4, 4>& Mat<T, 4, 4>::operator*=(const U& val) noexcept {
     return *this;
 }
 template <typename T> template <typename U>
-Mat<T, 4, 4>& Mat<T, 4, 4>::operator/=(const U& val) {
+constexpr Mat<T, 4, 4>& Mat<T, 4, 4>::operator/=(const U& val) {
     mROW[0] /= val;
     mROW[1] /= val;
     mROW[2] /= val;
@@ -220,7 +236,7 @@ Mat<T, 4, 4>& Mat<T, 4, 4>::operator/=(const U& val) {
 }
 
 template <typename T> template <typename U>
-inline Mat<T, 4, 4> Mat<T, 4, 4>::operator+(const Mat<U, 4, 4>& other) const noexcept {
+inline constexpr Mat<T, 4, 4> Mat<T, 4, 4>::operator+(const Mat<U, 4, 4>& other) const noexcept {
     return {
         (mROW[0] + other.mROW[0]),
         (mROW[1] + other.mROW[1]),
@@ -229,7 +245,7 @@ inline Mat<T, 4, 4> Mat<T, 4, 4>::operator+(const Mat<U, 4, 4>& other) const noe
     };
 }
 template <typename T> template <typename U>
-inline Mat<T, 4, 4> Mat<T, 4, 4>::operator-(const Mat<U, 4, 4>& other) const noexcept {
+inline constexpr Mat<T, 4, 4> Mat<T, 4, 4>::operator-(const Mat<U, 4, 4>& other) const noexcept {
     return {
         (mROW[0] - other.mROW[0]),
         (mROW[1] - other.mROW[1]),
@@ -238,24 +254,35 @@ inline Mat<T, 4, 4> Mat<T, 4, 4>::operator-(const Mat<U, 4, 4>& other) const noe
     };
 }
 template <typename T> template <typename U>
-inline Mat<T, 4, 4> Mat<T, 4, 4>::operator*(const Mat<U, 4, 4>& other) const noexcept {
-    Mat<T, 4, 4> result;
-
-    T sum{ };
-    for (unsigned int row = 0; row < 4; ++row) {
-        for (unsigned int col = 0; col < 4; ++col) {
-            for (unsigned int k = 0; k < 4; ++k)
-                sum += static_cast<T>(mROW[row][k] * other.mROW[k][col]);
-
-            result[row][col] = sum;
-            sum = { };
-        }
+inline constexpr Mat<T, 4, 4> Mat<T, 4, 4>::operator*(const Mat<U, 4, 4>& other) const noexcept {
+    if constexpr (SIMD::packed4<T, U>) {
+        if (!isConstantEvaluated())
+            return product(lanes(), other.lanes());
     }
 
-    return result;
+    // result[row] = sum(mROW[row][k] * other[k]) from +0, one output row at a time (SIMD::mul4x4 sums in the same order)
+    const auto row = [&other](const Vec4<T>& a) {
+        return Vec4<T>{
+            static_cast<T>(0) + static_cast<T>(a.x * other.mROW[0].x) + static_cast<T>(a.y * other.mROW[1].x) + static_cast<T>(a.z * other.mROW[2].x) + static_cast<T>(a.w * other.mROW[3].x),
+            static_cast<T>(0) + static_cast<T>(a.x * other.mROW[0].y) + static_cast<T>(a.y * other.mROW[1].y) + static_cast<T>(a.z * other.mROW[2].y) + static_cast<T>(a.w * other.mROW[3].y),
+            static_cast<T>(0) + static_cast<T>(a.x * other.mROW[0].z) + static_cast<T>(a.y * other.mROW[1].z) + static_cast<T>(a.z * other.mROW[2].z) + static_cast<T>(a.w * other.mROW[3].z),
+            static_cast<T>(0) + static_cast<T>(a.x * other.mROW[0].w) + static_cast<T>(a.y * other.mROW[1].w) + static_cast<T>(a.z * other.mROW[2].w) + static_cast<T>(a.w * other.mROW[3].w)
+        };
+    };
+
+    return { row(mROW[0]), row(mROW[1]), row(mROW[2]), row(mROW[3]) };
+}
+template <typename T> template <typename U>
+inline constexpr Vec4<T> Mat<T, 4, 4>::operator*(const Vec4<U>& v) const noexcept {
+    return {
+        mROW[0].dot(v),
+        mROW[1].dot(v),
+        mROW[2].dot(v),
+        mROW[3].dot(v)
+    };
 }
 template <typename T> template <typename U>
-inline Mat<T, 4, 4> Mat<T, 4, 4>::operator+(const U& val) const noexcept {
+inline constexpr Mat<T, 4, 4> Mat<T, 4, 4>::operator+(const U& val) const noexcept {
     return {
         (mROW[0] + val),
         (mROW[1] + val),
@@ -264,7 +291,7 @@ inline Mat<T, 4, 4> Mat<T, 4, 4>::operator+(const U& val) const noexcept {
     };
 }
 template <typename T> template <typename U>
-inline Mat<T, 4, 4> Mat<T, 4, 4>::operator-(const U& val) const noexcept {
+inline constexpr Mat<T, 4, 4> Mat<T, 4, 4>::operator-(const U& val) const noexcept {
     return {
         (mROW[0] - val),
         (mROW[1] - val),
@@ -273,7 +300,7 @@ inline Mat<T, 4, 4> Mat<T, 4, 4>::operator-(const U& val) const noexcept {
     };
 }
 template <typename T> template <typename U>
-inline Mat<T, 4, 4> Mat<T, 4, 4>::operator*(const U& val) const noexcept {
+inline constexpr Mat<T, 4, 4> Mat<T, 4, 4>::operator*(const U& val) const noexcept {
     return {
         (mROW[0] * val),
         (mROW[1] * val),
@@ -282,7 +309,7 @@ inline Mat<T, 4, 4> Mat<T, 4, 4>::operator*(const U& val) const noexcept {
     };
 }
 template <typename T> template <typename U>
-inline Mat<T, 4, 4> Mat<T, 4, 4>::operator/(const U& val) const {
+inline constexpr Mat<T, 4, 4> Mat<T, 4, 4>::operator/(const U& val) const {
     return {
         (mROW[0] / val),
         (mROW[1] / val),
@@ -299,64 +326,106 @@ template <typename T> inline constexpr T Mat<T, 4, 4>::trace() const noexcept {
         mROW[3].w
     );
 }
-template <typename T> inline Mat<T, 4, 4> Mat<T, 4, 4>::transpose() const noexcept {
-    Mat<T, 4, 4> m;
+template <typename T> inline constexpr T Mat<T, 4, 4>::determinant() const noexcept {
+    const Vec4<T>& r0 = mROW[0];
+    const Vec4<T>& r1 = mROW[1];
+    const Vec4<T>& r2 = mROW[2];
+    const Vec4<T>& r3 = mROW[3];
+
+    // 2x2 minors of the upper and lower row pairs
+    const T s0 = r0.x * r1.y - r0.y * r1.x;
+    const T s1 = r0.x * r1.z - r0.z * r1.x;
+    const T s2 = r0.x * r1.w - r0.w * r1.x;
+    const T s3 = r0.y * r1.z - r0.z * r1.y;
+    const T s4 = r0.y * r1.w - r0.w * r1.y;
+    const T s5 = r0.z * r1.w - r0.w * r1.z;
+
+    const T c0 = r2.x * r3.y - r2.y * r3.x;
+    const T c1 = r2.x * r3.z - r2.z * r3.x;
+    const T c2 = r2.x * r3.w - r2.w * r3.x;
+    const T c3 = r2.y * r3.z - r2.z * r3.y;
+    const T c4 = r2.y * r3.w - r2.w * r3.y;
+    const T c5 = r2.z * r3.w - r2.w * r3.z;
+
+    return static_cast<T>(s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0);
+}
+template <typename T> inline constexpr Mat<T, 4, 4> Mat<T, 4, 4>::transpose() const noexcept {
+    return {
+        Vec4<T>{ mROW[0].x, mROW[1].x, mROW[2].x, mROW[3].x },
+        Vec4<T>{ mROW[0].y, mROW[1].y, mROW[2].y, mROW[3].y },
+        Vec4<T>{ mROW[0].z, mROW[1].z, mROW[2].z, mROW[3].z },
+        Vec4<T>{ mROW[0].w, mROW[1].w, mROW[2].w, mROW[3].w }
+    };
+}
 
-    for (unsigned int row = 0; row < 4; ++row) {
-        for (unsigned int col = 0; col < 4; ++col)
-            m[row][col] = mROW[col][row];
-    }
+template <typename T> inline constexpr Mat<T, 4, 4> Mat<T, 4, 4>::inverse() const {
+    Mat<T, 4, 4> result{ };
+    const bool invertible = Math::invert(*this, result, &invert);
+
+    assert(invertible);
+    (void)invertible;
+
+    return result;
+}
+template <typename T> inline constexpr bool Mat<T, 4, 4>::tryInverse(Mat<T, 4, 4>& out) const noexcept {
+    Mat<T, 4, 4> result{ };
+
+    if (!Math::invert(*this, result, &invert))
+        return false;
+
+    out = result;
 
-    return m;
+    return true;
 }
 
 template <typename T> inline constexpr T Mat<T, 4, 4>::trace(const Mat<T, 4, 4>& m) noexcept { return m.trace(); }
-template <typename T> inline Mat<T, 4, 4> Mat<T, 4, 4>::transpose(const Mat<T, 4, 4>& m) noexcept { return m.transpose(); }
-template <typename T> inline Mat<T, 4, 4> Mat<T, 4, 4>::identity() noexcept {
-    static constexpr T zero = static_cast<T>(0);
-    static constexpr T one  = static_cast<T>(1);
+template <typename T> inline constexpr T Mat<T, 4, 4>::determinant(const Mat<T, 4, 4>& m) noexcept { return m.determinant(); }
+template <typename T> inline constexpr Mat<T, 4, 4> Mat<T, 4, 4>::transpose(const Mat<T, 4, 4>& m) noexcept { return m.transpose(); }
+template <typename T> inline constexpr Mat<T, 4, 4> Mat<T, 4, 4>::inverse(const Mat<T, 4, 4>& m) { return m.inverse(); }
+template <typename T> inline constexpr Mat<T, 4, 4> Mat<T, 4, 4>::identity() noexcept {
+    constexpr T zero = static_cast<T>(0);
+    constexpr T one  = static_cast<T>(1);
 
-    static const Mat4<T> i (
+    return {
         Vec4<T>{  one, zero, zero, zero },
         Vec4<T>{ zero,  one, zero, zero },
         Vec4<T>{ zero, zero,  one, zero },
         Vec4<T>{ zero, zero, zero,  one }
-    );
-
-    return i;
+    };
 }
 
-template <typename T> inline Mat<T, 4, 4> Mat<T, 4, 4>::translate(const Vec3<T>& v) noexcept {
-    Mat<T, 4, 4> t;
-
-    t[0].x = static_cast<T>(1);
-    t[0].w = v.x;
-
-    t[1].y = static_cast<T>(1);
-    t[1].w = v.y;
-
-    t[2].z = static_cast<T>(1);
-    t[2].w = v.z;
-
-    t[3].w = static_cast<T>(1);
+template <typename T> inline constexpr Mat<T, 4, 4> Mat<T, 4, 4>::translate(const Vec3<T>& v) noexcept {
+    constexpr T zero = static_cast<T>(0);
+    constexpr T one  = static_cast<T>(1);
 
-    return t;
+    return {
+        Vec4<T>{  one, zero, zero,  v.x },
+        Vec4<T>{ zero,  one, zero,  v.y },
+        Vec4<T>{ zero, zero,  one,  v.z },
+        Vec4<T>{ zero, zero, zero,  one }
+    };
 }
-template <typename T> inline Mat<T, 4, 4> Mat<T, 4, 4>::scale(const Vec3<T>& v) noexcept {
-    Mat<T, 4, 4> s;
+template <typename T> inline constexpr Mat<T, 4, 4> Mat<T, 4, 4>::scale(const Vec3<T>& v) noexcept {
+    constexpr T zero = static_cast<T>(0);
+    constexpr T one  = static_cast<T>(1);
 
-    v[0].x = v.x;
-    v[1].y = v.y;
-    v[2].z = v.z;
-    v[3].w = static_cast<T>(1);
-
-    return s;
+    return {
+        Vec4<T>{  v.x, zero, zero, zero },
+        Vec4<T>{ zero,  v.y, zero, zero },
+        Vec4<T>{ zero, zero,  v.z, zero },
+        Vec4<T>{ zero, zero, zero,  one }
+    };
 }
 template <typename T> template <typename U> inline Mat<T, 4, 4> Mat<T, 4, 4>::rotateX(const U& val) noexcept {
     Mat<T, 4, 4> Rx;
 
-    const T s = static_cast<T>(std::sin(Math::toRad(val)));
-    const T c = static_cast<T>(std::cos(Math::toRad(val)));
+    using F = IF<isFloat<T>, T, double>;
+
+    F sf{ }, cf{ };
+    Math::sincos(Math::toRad(static_cast<F>(val)), sf, cf);
+
+    const T s = static_cast<T>(sf);
+    const T c = static_cast<T>(cf);
 
     Rx.mROW[0].x = static_cast<T>(1);
     Rx.mROW[1](static_cast<T>(0), c, -s);
@@ -368,8 +437,13 @@ template <typename T> template <typename U> inline Mat<T, 4, 4> Mat<T, 4, 4>::ro
 template <typename T> template <typename U> inline Mat<T, 4, 4> Mat<T, 4, 4>::rotateY(const U& val) noexcept {
     Mat<T, 4, 4> Ry;
 
-    const T s = static_cast<T>(std::sin(Math::toRad(val)));
-    const T c = static_cast<T>(std::cos(Math::toRad(val)));
+    using F = IF<isFloat<T>, T, double>;
+
+    F sf{ }, cf{ };
+    Math::sincos(Math::toRad(static_cast<F>(val)), sf, cf);
+
+    const T s = static_cast<T>(sf);
+    const T c = static_cast<T>(cf);
 
     Ry.mROW[0]( c, static_cast<T>(0), s);
     Ry.mROW[1].y = static_cast<T>(1);
@@ -381,8 +455,13 @@ template <typename T> template <typename U> inline Mat<T, 4, 4> Mat<T, 4, 4>::ro
 template <typename T> template <typename U> inline Mat<T, 4, 4> Mat<T, 4, 4>::rotateZ(const U& val) noexcept {
     Mat<T, 4, 4> Rz;
 
-    const T s = static_cast<T>(std::sin(Math::toRad(val)));
-    const T c = static_cast<T>(std::cos(Math::toRad(val)));
+    using F = IF<isFloat<T>, T, double>;
+
+    F sf{ }, cf{ };
+    Math::sincos(Math::toRad(static_cast<F>(val)), sf, cf);
+
+    const T s = static_cast<T>(sf);
+    const T c = static_cast<T>(cf);
 
     Rz.mROW[0](c, -s);
     Rz.mROW[1](s,  c);
@@ -411,7 +490,9 @@ template <typename T> template <typename U1, typename U2, typename U3, typename
 inline Mat<T, 4, 4> Mat<T, 4, 4>::projection(const U1& near, const U2& far, const U3& fovY, const U4& aspect) noexcept {
     Mat<T, 4, 4> p;
 
-    const T focalLength = static_cast<T>(1 / std::tan(fovY / 2.0));
+    using F = IF<isFloat<T>, T, double>;
+
+    const T focalLength = static_cast<T>(1 / Math::tan(static_cast<F>(fovY) / 2));
     const T nfDIFF = static_cast<T>(near - far);
 
     p.mROW[0].x = static_cast<T>(focalLength / aspect);
@@ -424,6 +505,299 @@ inline Mat<T, 4, 4> Mat<T, 4, 4>::projection(const U1& near, const U2& far, cons
 }
 
 template <typename T> template <typename U1, typename U2, typename U3>
-inline Mat<T, 4, 4> Mat<T, 4, 4>::translate(const U1& x, const U2& y, const U3& z) noexcept { return Mat<T, 4, 4>::translate({x, y, z}); }
+inline constexpr Mat<T, 4, 4> Mat<T, 4, 4>::translate(const U1& x, const U2& y, const U3& z) noexcept { return Mat<T, 4, 4>::translate({x, y, z}); }
 template <typename T> template <typename U>
-inline Mat<T, 4, 4> Mat<T, 4, 4>::scale(const U& val) noexcept { return Mat<T, 4, 4>::scale({val, val, val}); }
\ No newline at end of file
+inline constexpr Mat<T, 4, 4> Mat<T, 4, 4>::scale(const U& val) noexcept { return Mat<T, 4, 4>::scale({val, val, val}); }
+
+template <typename T>
+inline Mat<T, 4, 4> Mat<T, 4, 4>::fromTRS(const Vec3<T>& t, const Vec3<T>& r, const Vec3<T>& s) noexcept {
+    using F = IF<isFloat<T>, T, double>;
+
+    F sin[3]{ }, cos[3]{ };
+    Math::sincos(Math::toRad(static_cast<F>(r.x)), sin[0], cos[0]);
+    Math::sincos(Math::toRad(static_cast<F>(r.y)), sin[1], cos[1]);
+    Math::sincos(Math::toRad(static_cast<F>(r.z)), sin[2], cos[2]);
+
+    return compose(t, sin, cos, s);
+}
+template <typename T>
+inline void Mat<T, 4, 4>::fromTRS(const Vec3<T>* t, const Vec3<T>* r, const Vec3<T>* s, Mat<T, 4, 4>* dst, const std::size_t& count) noexcept {
+    if constexpr (isFloat<T>) {
+        // angles of a whole block through one array sincos, r[i].x / y / z are contiguous
+        constexpr std::size_t BLOCK = 64;
+        T rad[3 * BLOCK], sin[3 * BLOCK], cos[3 * BLOCK];
+
+        for (std::size_t base = 0; base < count; base += BLOCK) {
+            const std::size_t size = (count - base < BLOCK) ? count - base : BLOCK;
+            const T* deg = &r[base].x;
+
+            for (std::size_t i = 0; i < 3 * size; ++i)
+                rad[i] = Math::toRad(deg[i]);
+            Math::sincos(rad, sin, cos, 3 * size);
+
+            for (std::size_t i = 0; i < size; ++i)
+                dst[base + i] = compose(t[base + i], sin + 3 * i, cos + 3 * i, s[base + i]);
+        }
+    }
+    else {
+        for (std::size_t i = 0; i < count; ++i)
+            dst[i] = fromTRS(t[i], r[i], s[i]);
+    }
+}
+template <typename T> template <typename F>
+inline Mat<T, 4, 4> Mat<T, 4, 4>::compose(const Vec3<T>& t, const F* sin, const F* cos, const Vec3<T>& s) noexcept {
+    constexpr T zero = static_cast<T>(0);
+    constexpr T one  = static_cast<T>(1);
+
+    const T sx = static_cast<T>(sin[0]), cx = static_cast<T>(cos[0]);
+    const T sy = static_cast<T>(sin[1]), cy = static_cast<T>(cos[1]);
+    const T sz = static_cast<T>(sin[2]), cz = static_cast<T>(cos[2]);
+
+    // Rz * Ry * Rx, column j scaled by s[j]
+    return {
+        Vec4<T>{ cz * cy * s.x, (cz * sy * sx - sz * cx) * s.y, (cz * sy * cx + sz * sx) * s.z, t.x },
+        Vec4<T>{ sz * cy * s.x, (sz * sy * sx + cz * cx) * s.y, (sz * sy * cx - cz * sx) * s.z, t.y },
+        Vec4<T>{     -sy * s.x,                 cy * sx * s.y,                  cy * cx * s.z, t.z },
+        Vec4<T>{      zero    ,                  zero        ,                   zero        , one }
+    };
+}
+template <typename T>
+inline void Mat<T, 4, 4>::decomposeTRS(const Mat<T, 4, 4>& m, Vec3<T>& t, Vec3<T>& r, Vec3<T>& s) noexcept {
+    static_assert(isFloat<T>);
+
+    const Vec4<T>& r0 = m.mROW[0];
+    const Vec4<T>& r1 = m.mROW[1];
+    const Vec4<T>& r2 = m.mROW[2];
+
+    t(r0.w, r1.w, r2.w);
+
+    const Vec3<T> c0{ r0.x, r1.x, r2.x };
+    const Vec3<T> c1{ r0.y, r1.y, r2.y };
+    const Vec3<T> c2{ r0.z, r1.z, r2.z };
+
+    s(c0.length(), c1.length(), c2.length());
+    if (c0.dot(c1.cross(c2)) < 0)
+        s.x = -s.x;
+
+    assert(!Math::isZero(s.x) && !Math::isZero(s.y) && !Math::isZero(s.z));
+
+    // rotation entries of Rz * Ry * Rx
+    const T R00 = c0.x / s.x, R10 = c0.y / s.x, R20 = c0.z / s.x;
+    const T R01 = c1.x / s.y, R11 = c1.y / s.y;
+    const T R21 = c1.z / s.y, R22 = c2.z / s.z;
+
+    const T sy = (R20 < -1) ? static_cast<T>(1) : (R20 > 1) ? static_cast<T>(-1) : -R20;
+
+    if (Math::abs(sy) < static_cast<T>(1) - Math::EPSILON<T>) {
+        r(
+            std::atan2(R21, R22),
+            std::asin(sy),
+            std::atan2(R10, R00)
+        );
+    }
+    // gimbal lock: only x +- z is defined, keep z = 0
+    else {
+        r(
+            std::atan2(sy * R01, R11),
+            std::asin(sy),
+            static_cast<T>(0)
+        );
+    }
+
+    r(Math::toDeg(r.x), Math::toDeg(r.y), Math::toDeg(r.z));
+}
+
+// points get w = 1 and are divided by the resulting w unless the bottom row is (0, 0, 0, 1) within EPSILON
+template <typename T>
+inline void Mat<T, 4, 4>::transformPoints(const Mat<T, 4, 4>& m, const Vec3<T>* src, Vec3<T>* dst, const std::size_t& count) noexcept {
+    if (count == 0)
+        return;
+
+    const Vec4<T>& r3 = m.mROW[3];
+    const bool project = !(Math::isZero(r3.x) && Math::isZero(r3.y) && Math::isZero(r3.z) && Math::isZero(r3.w - static_cast<T>(1)));
+
+    if constexpr (SIMD::has4<T>) {
+        const Lanes lanes = m.lanes();
+        SIMD::blocks<T>(count, [&](const T* in, T* out, const std::size_t& n) { SIMD::transform3(lanes.at, in, out, n, static_cast<T>(1), project); }, src, dst);
+
+        return;
+    }
+
+    const Vec4<T>& r0 = m.mROW[0];
+    const Vec4<T>& r1 = m.mROW[1];
+    const Vec4<T>& r2 = m.mROW[2];
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const Vec3<T> p = src[i];
+
+        T x = static_cast<T>(r0.x * p.x + r0.y * p.y + r0.z * p.z + r0.w);
+        T y = static_cast<T>(r1.x * p.x + r1.y * p.y + r1.z * p.z + r1.w);
+        T z = static_cast<T>(r2.x * p.x + r2.y * p.y + r2.z * p.z + r2.w);
+
+        if (project) {
+            const T w = static_cast<T>(r3.x * p.x + r3.y * p.y + r3.z * p.z + r3.w);
+
+            x = static_cast<T>(x / w);
+            y = static_cast<T>(y / w);
+            z = static_cast<T>(z / w);
+        }
+
+        dst[i](x, y, z);
+    }
+}
+template <typename T>
+inline void Mat<T, 4, 4>::transformDirections(const Mat<T, 4, 4>& m, const Vec3<T>* src, Vec3<T>* dst, const std::size_t& count) noexcept {
+    if (count == 0)
+        return;
+
+    if constexpr (SIMD::has4<T>) {
+        const Lanes lanes = m.lanes();
+        SIMD::blocks<T>(count, [&](const T* in, T* out, const std::size_t& n) { SIMD::transform3(lanes.at, in, out, n, static_cast<T>(0), false); }, src, dst);
+
+        return;
+    }
+
+    const Vec4<T>& r0 = m.mROW[0];
+    const Vec4<T>& r1 = m.mROW[1];
+    const Vec4<T>& r2 = m.mROW[2];
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const Vec3<T> d = src[i];
+
+        dst[i](
+            static_cast<T>(r0.x * d.x + r0.y * d.y + r0.z * d.z),
+            static_cast<T>(r1.x * d.x + r1.y * d.y + r1.z * d.z),
+            static_cast<T>(r2.x * d.x + r2.y * d.y + r2.z * d.z)
+        );
+    }
+}
+template <typename T>
+inline void Mat<T, 4, 4>::transformHomogeneous(const Mat<T, 4, 4>& m, const Vec4<T>* src, Vec4<T>* dst, const std::size_t& count) noexcept {
+    if (count == 0)
+        return;
+
+    if constexpr (SIMD::has4<T>) {
+        const Lanes lanes = m.lanes();
+        SIMD::blocks<T>(count, [&](const T* in, T* out, const std::size_t& n) { SIMD::transform4(lanes.at, in, out, n); }, src, dst);
+
+        return;
+    }
+
+    for (std::size_t i = 0; i < count; ++i)
+        dst[i] = m * Vec4<T>{ src[i] };
+}
+
+template <typename T>
+inline void Mat<T, 4, 4>::transformPoints(const Mat<T, 4, 4>& m, Vec3<T>* v, const std::size_t& count) noexcept { transformPoints(m, v, v, count); }
+template <typename T>
+inline void Mat<T, 4, 4>::transformDirections(const Mat<T, 4, 4>& m, Vec3<T>* v, const std::size_t& count) noexcept { transformDirections(m, v, v, count); }
+template <typename T>
+inline void Mat<T, 4, 4>::transformHomogeneous(const Mat<T, 4, 4>& m, Vec4<T>* v, const std::size_t& count) noexcept { transformHomogeneous(m, v, v, count); }
+
+template <typename T>
+inline std::size_t Mat<T, 4, 4>::solve(const Mat<T, 4, 4>* a, const Vec4<T>* b, Vec4<T>* x, const std::size_t& count) noexcept {
+    std::size_t singular = 0;
+    SIMD::blocks<T>(count, [&singular](const T* lanesA, const T* lanesB, T* lanesX, const std::size_t& n) { singular += SIMD::solveLU<4>(lanesA, lanesB, lanesX, n); }, a, b, x);
+
+    return singular;
+}
+template <typename T>
+inline std::size_t Mat<T, 4, 4>::solveCholesky(const Mat<T, 4, 4>* a, const Vec4<T>* b, Vec4<T>* x, const std::size_t& count) noexcept {
+    std::size_t singular = 0;
+    SIMD::blocks<T>(count, [&singular](const T* lanesA, const T* lanesB, T* lanesX, const std::size_t& n) { singular += SIMD::solveCholesky<4>(lanesA, lanesB, lanesX, n); }, a, b, x);
+
+    return singular;
+}
+
+template <typename T>
+inline constexpr T Mat<T, 4, 4>::invert(const Mat<T, 4, 4>& m, Mat<T, 4, 4>& out) noexcept {
+    static_assert(isFloat<T>);
+
+    if constexpr (SIMD::has4<T>) {
+        if (!isConstantEvaluated()) {
+            Lanes l = m.lanes();
+            const T det = SIMD::inverse4x4(l.at, l.at);
+            out.lanes(l);
+
+            return det;
+        }
+    }
+
+    const Vec4<T>& r0 = m.mROW[0];
+    const Vec4<T>& r1 = m.mROW[1];
+    const Vec4<T>& r2 = m.mROW[2];
+    const Vec4<T>& r3 = m.mROW[3];
+
+    const T s0 = r0.x * r1.y - r0.y * r1.x;
+    const T s1 = r0.x * r1.z - r0.z * r1.x;
+    const T s2 = r0.x * r1.w - r0.w * r1.x;
+    const T s3 = r0.y * r1.z - r0.z * r1.y;
+    const T s4 = r0.y * r1.w - r0.w * r1.y;
+    const T s5 = r0.z * r1.w - r0.w * r1.z;
+
+    const T c0 = r2.x * r3.y - r2.y * r3.x;
+    const T c1 = r2.x * r3.z - r2.z * r3.x;
+    const T c2 = r2.x * r3.w - r2.w * r3.x;
+    const T c3 = r2.y * r3.z - r2.z * r3.y;
+    const T c4 = r2.y * r3.w - r2.w * r3.y;
+    const T c5 = r2.z * r3.w - r2.w * r3.z;
+
+    const T det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+    const T inv = static_cast<T>(1) / det;
+
+    out.mROW[0] = Vec4<T>{
+        ( r1.y * c5 - r1.z * c4 + r1.w * c3) * inv,
+        (-r0.y * c5 + r0.z * c4 - r0.w * c3) * inv,
+        ( r3.y * s5 - r3.z * s4 + r3.w * s3) * inv,
+        (-r2.y * s5 + r2.z * s4 - r2.w * s3) * inv
+    };
+    out.mROW[1] = Vec4<T>{
+        (-r1.x * c5 + r1.z * c2 - r1.w * c1) * inv,
+        ( r0.x * c5 - r0.z * c2 + r0.w * c1) * inv,
+        (-r3.x * s5 + r3.z * s2 - r3.w * s1) * inv,
+        ( r2.x * s5 - r2.z * s2 + r2.w * s1) * inv
+    };
+    out.mROW[2] = Vec4<T>{
+        ( r1.x * c4 - r1.y * c2 + r1.w * c0) * inv,
+        (-r0.x * c4 + r0.y * c2 - r0.w * c0) * inv,
+        ( r3.x * s4 - r3.y * s2 + r3.w * s0) * inv,
+        (-r2.x * s4 + r2.y * s2 - r2.w * s0) * inv
+    };
+    out.mROW[3] = Vec4<T>{
+        (-r1.x * c3 + r1.y * c1 - r1.z * c0) * inv,
+        ( r0.x * c3 - r0.y * c1 + r0.z * c0) * inv,
+        (-r3.x * s3 + r3.y * s1 - r3.z * s0) * inv,
+        ( r2.x * s3 - r2.y * s1 + r2.z * s0) * inv
+    };
+
+    return det;
+}
+template <typename T>
+inline Mat<T, 4, 4> Mat<T, 4, 4>::product(const Lanes& a, const Lanes& b) noexcept {
+    T out[16];
+    SIMD::mul4x4(a.at, b.at, out);
+
+    return {
+        Vec4<T>{ out[0],  out[1],  out[2],  out[3]  },
+        Vec4<T>{ out[4],  out[5],  out[6],  out[7]  },
+        Vec4<T>{ out[8],  out[9],  out[10], out[11] },
+        Vec4<T>{ out[12], out[13], out[14], out[15] }
+    };
+}
+template <typename T>
+inline typename Mat<T, 4, 4>::Lanes Mat<T, 4, 4>::lanes() const noexcept {
+    return { {
+        mROW[0].x, mROW[0].y, mROW[0].z, mROW[0].w,
+        mROW[1].x, mROW[1].y, mROW[1].z, mROW[1].w,
+        mROW[2].x, mROW[2].y, mROW[2].z, mROW[2].w,
+        mROW[3].x, mROW[3].y, mROW[3].z, mROW[3].w
+    } };
+}
+template <typename T>
+inline void Mat<T, 4, 4>::lanes(const Lanes& l) noexcept {
+    for (unsigned int row = 0; row < 4; ++row)
+        mROW[row](l.at[row * 4], l.at[row * 4 + 1], l.at[row * 4 + 2], l.at[row * 4 + 3]);
+}
+
+static_assert(isTriviallyCopyable<Mat4<float>>  && isStandardLayout<Mat4<float>>);
+static_assert(isTriviallyCopyable<Mat4<double>> && isStandardLayout<Mat4<double>>);
\ No newline at end of file
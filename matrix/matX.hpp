@@ -0,0 +1,443 @@
+#pragma once
+
+#include "../aligned.hpp"
+#include "../base.hpp"
+#include "../math.hpp"
+#include "../parallel.hpp"
+#include "../simd.hpp"
+#include "../typeHandler.hpp"
+
+#include <cassert>      // assert()
+#include <cstddef>      // size_t
+
+// Row-major matrix sized at run time (least squares, large systems): one 64-byte aligned
+// block, rows back to back. Products run a packed, cache-blocked GEMM around the
+// SIMD::gemm micro-kernel: the right operand is packed once up front, then the rows of
+// the result are split across threads that all read it.
+template <typename T>
+class MatX {
+    static_assert(isArithmetic<T>);
+
+    public:
+        inline static constexpr std::size_t ALIGNMENT = Aligned::ALIGNMENT;
+
+        // product blocking: a KC x GEMM_NR sliver of the right operand stays in L1, an MC x KC
+        // block of the left operand in L2 and a KC x NC panel of the right operand in L3
+        inline static constexpr std::size_t KC = 256;
+        inline static constexpr std::size_t MC = 16 * SIMD::GEMM_MR<T>;
+        inline static constexpr std::size_t NC = 4096;
+        // transpose tile (TILE x TILE)
+        inline static constexpr std::size_t TILE = 32;
+        // smallest share of multiply-adds a product thread runs
+        inline static constexpr std::size_t MIN_PER_THREAD = 1 << 22;
+
+    public:
+        MatX() noexcept;
+        MatX(const MatX<T>&);
+        MatX(MatX<T>&&) noexcept;
+        ~MatX() noexcept;
+
+        // zero
+        MatX(const std::size_t& rows, const std::size_t& cols);
+        // rows * cols row-major lanes
+        MatX(const std::size_t& rows, const std::size_t& cols, const T* src);
+
+        MatX<T>& operator=(const MatX<T>&);
+        MatX<T>& operator=(MatX<T>&&) noexcept;
+
+        // lanes of one row
+        inline T* operator[](const std::size_t& row);
+        inline const T* operator[](const std::size_t& row) const;
+
+        // every lane zero afterwards, the block is reused when large enough
+        void resize(const std::size_t& rows, const std::size_t& cols);
+
+        inline std::size_t rows() const noexcept;
+        inline std::size_t cols() const noexcept;
+        inline T* data() noexcept;
+        inline const T* data() const noexcept;
+
+        MatX<T>& operator+=(const MatX<T>&) noexcept;
+        MatX<T>& operator-=(const MatX<T>&) noexcept;
+        MatX<T>& operator*=(const MatX<T>&);
+        template <typename U> MatX<T>& operator+=(const U&) noexcept;
+        template <typename U> MatX<T>& operator-=(const U&) noexcept;
+        template <typename U> MatX<T>& operator*=(const U&) noexcept;
+        template <typename U> MatX<T>& operator/=(const U&);
+
+        inline MatX<T> operator+(const MatX<T>&) const;
+        inline MatX<T> operator-(const MatX<T>&) const;
+        inline MatX<T> operator*(const MatX<T>&) const;
+        template <typename U> inline MatX<T> operator+(const U&) const;
+        template <typename U> inline MatX<T> operator-(const U&) const;
+        template <typename U> inline MatX<T> operator*(const U&) const;
+        template <typename U> inline MatX<T> operator/(const U&) const;
+
+        inline T trace() const noexcept;
+        inline MatX<T> transpose() const;
+
+        static inline T trace(const MatX<T>&) noexcept;
+        static inline MatX<T> transpose(const MatX<T>&);
+        static inline MatX<T> identity(const std::size_t&);
+
+        // out = a * b (out must not be a or b), threads = 0 uses every hardware thread
+        static void multiply(const MatX<T>& a, const MatX<T>& b, MatX<T>& out, const unsigned int& threads = 0);
+        // out = transpose(m) in TILE x TILE blocks (out must not be m)
+        static void transpose(const MatX<T>& m, MatX<T>& out);
+
+    private:
+        // rows [begin, end) of out += a * b, b packed whole: each KC-row block of it by packB
+        // over every column, the block at row pc starting at pc * (columns rounded up to GEMM_NR)
+        static void multiplyRows(const MatX<T>& a, const T* packedB, MatX<T>& out, const std::size_t& begin, const std::size_t& end);
+        // GEMM_MR-row panels of an mc x kc block, column by column, zero past mc
+        static inline void packA(const T* a, const std::size_t& lda, const std::size_t& mc, const std::size_t& kc, T* dst) noexcept;
+        // GEMM_NR-column panels of a kc x nc block, row by row, zero past nc
+        static inline void packB(const T* b, const std::size_t& ldb, const std::size_t& kc, const std::size_t& nc, T* dst) noexcept;
+
+        void allocate(const std::size_t& count);
+        void release() noexcept;
+
+    private:
+        T* mData{ };
+        std::size_t mRows{ };
+        std::size_t mCols{ };
+        std::size_t mCapacity{ };
+};
+
+template <typename T> MatX<T>::MatX() noexcept { }
+template <typename T> MatX<T>::MatX(const MatX<T>& other) { *this = other; }
+template <typename T> MatX<T>::MatX(MatX<T>&& other) noexcept { *this = move(other); }
+template <typename T> MatX<T>::~MatX() noexcept { release(); }
+
+template <typename T>
+MatX<T>::MatX(const std::size_t& rows, const std::size_t& cols) { resize(rows, cols); }
+template <typename T>
+MatX<T>::MatX(const std::size_t& rows, const std::size_t& cols, const T* src) {
+    resize(rows, cols);
+
+    for (std::size_t i = 0; i < rows * cols; ++i)
+        mData[i] = src[i];
+}
+
+template <typename T>
+MatX<T>& MatX<T>::operator=(const MatX<T>& other) {
+    if (this == &other)
+        return *this;
+
+    resize(other.mRows, other.mCols);
+
+    for (std::size_t i = 0; i < mRows * mCols; ++i)
+        mData[i] = other.mData[i];
+
+    return *this;
+}
+template <typename T>
+MatX<T>& MatX<T>::operator=(MatX<T>&& other) noexcept {
+    if (this == &other)
+        return *this;
+
+    release();
+
+    mData     = other.mData;
+    mRows     = other.mRows;
+    mCols     = other.mCols;
+    mCapacity = other.mCapacity;
+
+    other.mData     = nullptr;
+    other.mRows     = 0;
+    other.mCols     = 0;
+    other.mCapacity = 0;
+
+    return *this;
+}
+
+template <typename T>
+inline T* MatX<T>::operator[](const std::size_t& row) {
+    assert(row < mRows);
+
+    return mData + row * mCols;
+}
+template <typename T>
+inline const T* MatX<T>::operator[](const std::size_t& row) const {
+    assert(row < mRows);
+
+    return mData + row * mCols;
+}
+
+template <typename T>
+void MatX<T>::resize(const std::size_t& rows, const std::size_t& cols) {
+    if (rows * cols > mCapacity)
+        allocate(rows * cols);
+
+    mRows = rows;
+    mCols = cols;
+
+    for (std::size_t i = 0; i < rows * cols; ++i)
+        mData[i] = { };
+}
+
+template <typename T>
+inline std::size_t MatX<T>::rows() const noexcept { return mRows; }
+template <typename T>
+inline std::size_t MatX<T>::cols() const noexcept { return mCols; }
+template <typename T>
+inline T* MatX<T>::data() noexcept { return mData; }
+template <typename T>
+inline const T* MatX<T>::data() const noexcept { return mData; }
+
+// same shape, same layout: one contiguous pass, nothing to block
+template <typename T>
+MatX<T>& MatX<T>::operator+=(const MatX<T>& other) noexcept {
+    assert(mRows == other.mRows && mCols == other.mCols);
+
+    SIMD::addN(mData, other.mData, mData, mRows * mCols);
+
+    return *this;
+}
+template <typename T>
+MatX<T>& MatX<T>::operator-=(const MatX<T>& other) noexcept {
+    assert(mRows == other.mRows && mCols == other.mCols);
+
+    SIMD::subN(mData, other.mData, mData, mRows * mCols);
+
+    return *this;
+}
+template <typename T>
+MatX<T>& MatX<T>::operator*=(const MatX<T>& other) { return (*this = ((*this) * other)); }
+template <typename T> template <typename U>
+MatX<T>& MatX<T>::operator+=(const U& val) noexcept {
+    SIMD::addN(mData, static_cast<T>(val), mData, mRows * mCols);
+
+    return *this;
+}
+template <typename T> template <typename U>
+MatX<T>& MatX<T>::operator-=(const U& val) noexcept {
+    SIMD::subN(mData, static_cast<T>(val), mData, mRows * mCols);
+
+    return *this;
+}
+template <typename T> template <typename U>
+MatX<T>& MatX<T>::operator*=(const U& val) noexcept {
+    SIMD::mulN(mData, static_cast<T>(val), mData, mRows * mCols);
+
+    return *this;
+}
+template <typename T> template <typename U>
+MatX<T>& MatX<T>::operator/=(const U& val) {
+    assert(!Math::isZero(val));
+
+    SIMD::divN(mData, static_cast<T>(val), mData, mRows * mCols);
+
+    return *this;
+}
+
+template <typename T>
+inline MatX<T> MatX<T>::operator+(const MatX<T>& other) const { return (MatX<T>{ *this } += other); }
+template <typename T>
+inline MatX<T> MatX<T>::operator-(const MatX<T>& other) const { return (MatX<T>{ *this } -= other); }
+template <typename T>
+inline MatX<T> MatX<T>::operator*(const MatX<T>& other) const {
+    MatX<T> result;
+    multiply(*this, other, result);
+
+    return result;
+}
+template <typename T> template <typename U>
+inline MatX<T> MatX<T>::operator+(const U& val) const { return (MatX<T>{ *this } += val); }
+template <typename T> template <typename U>
+inline MatX<T> MatX<T>::operator-(const U& val) const { return (MatX<T>{ *this } -= val); }
+template <typename T> template <typename U>
+inline MatX<T> MatX<T>::operator*(const U& val) const { return (MatX<T>{ *this } *= val); }
+template <typename T> template <typename U>
+inline MatX<T> MatX<T>::operator/(const U& val) const { return (MatX<T>{ *this } /= val); }
+
+template <typename T>
+inline T MatX<T>::trace() const noexcept {
+    assert(mRows == mCols);
+
+    T sum = static_cast<T>(0);
+    for (std::size_t i = 0; i < mRows; ++i)
+        sum += mData[i * mCols + i];
+
+    return sum;
+}
+template <typename T>
+inline MatX<T> MatX<T>::transpose() const {
+    MatX<T> result;
+    transpose(*this, result);
+
+    return result;
+}
+
+template <typename T>
+inline T MatX<T>::trace(const MatX<T>& m) noexcept { return m.trace(); }
+template <typename T>
+inline MatX<T> MatX<T>::transpose(const MatX<T>& m) { return m.transpose(); }
+template <typename T>
+inline MatX<T> MatX<T>::identity(const std::size_t& n) {
+    MatX<T> result{ n, n };
+    for (std::size_t i = 0; i < n; ++i)
+        result.mData[i * n + i] = static_cast<T>(1);
+
+    return result;
+}
+
+template <typename T>
+void MatX<T>::multiply(const MatX<T>& a, const MatX<T>& b, MatX<T>& out, const unsigned int& threads) {
+    assert(a.mCols == b.mRows);
+    assert(&out != &a && &out != &b);
+
+    constexpr std::size_t MR = SIMD::GEMM_MR<T>;
+    constexpr std::size_t NR = SIMD::GEMM_NR<T>;
+
+    out.resize(a.mRows, b.mCols);
+
+    if (a.mRows == 0 || b.mCols == 0 || a.mCols == 0)
+        return;
+
+    // at least one MR-row panel per worker
+    const std::size_t panels = (a.mRows + MR - 1) / MR;
+    const unsigned int workers = Parallel::workers(threads, a.mRows * a.mCols * b.mCols, MIN_PER_THREAD, panels);
+
+    // the right operand is packed once, every worker reads the same panels
+    const std::size_t n = b.mCols;
+    const std::size_t k = b.mRows;
+    const std::size_t width = (n + NR - 1) / NR * NR;
+
+    T* packedB = Aligned::allocate<T>(k * width);
+    for (std::size_t pc = 0; pc < k; pc += KC)
+        packB(b.mData + pc * n, n, (pc + KC < k) ? KC : k - pc, n, packedB + pc * width);
+
+    // shards start on a panel boundary, so only the last one has a partial panel
+    const auto split = [&](const unsigned int& t) {
+        const std::size_t row = panels * t / workers * MR;
+
+        return (row < a.mRows) ? row : a.mRows;
+    };
+
+    Parallel::run(workers, [&](const unsigned int& t) { multiplyRows(a, packedB, out, split(t), split(t + 1)); });
+
+    Aligned::release(packedB);
+}
+template <typename T>
+void MatX<T>::transpose(const MatX<T>& m, MatX<T>& out) {
+    assert(&out != &m);
+
+    out.resize(m.mCols, m.mRows);
+
+    // both sides of a tile stay in L1, instead of one of them striding a whole column
+    for (std::size_t row0 = 0; row0 < m.mRows; row0 += TILE) {
+        const std::size_t rowEnd = (row0 + TILE < m.mRows) ? row0 + TILE : m.mRows;
+
+        for (std::size_t col0 = 0; col0 < m.mCols; col0 += TILE) {
+            const std::size_t colEnd = (col0 + TILE < m.mCols) ? col0 + TILE : m.mCols;
+
+            for (std::size_t row = row0; row < rowEnd; ++row) {
+                for (std::size_t col = col0; col < colEnd; ++col)
+                    out.mData[col * m.mRows + row] = m.mData[row * m.mCols + col];
+            }
+        }
+    }
+}
+
+template <typename T>
+void MatX<T>::multiplyRows(const MatX<T>& a, const T* packedB, MatX<T>& out, const std::size_t& begin, const std::size_t& end) {
+    constexpr std::size_t MR = SIMD::GEMM_MR<T>;
+    constexpr std::size_t NR = SIMD::GEMM_NR<T>;
+    static_assert(NC % NR == 0);
+
+    const std::size_t n = out.mCols;
+    const std::size_t k = a.mCols;
+    const std::size_t width = (n + NR - 1) / NR * NR;
+
+    T* packedA = Aligned::allocate<T>(MC * KC);
+
+    for (std::size_t jc = 0; jc < n; jc += NC) {
+        const std::size_t nc = (jc + NC < n) ? NC : n - jc;
+
+        for (std::size_t pc = 0; pc < k; pc += KC) {
+            const std::size_t kc = (pc + KC < k) ? KC : k - pc;
+            // the KC x NC panel at (pc, jc), jc / NR slivers into the block of row pc
+            const T* panel = packedB + pc * width + jc * kc;
+
+            for (std::size_t ic = begin; ic < end; ic += MC) {
+                const std::size_t mc = (ic + MC < end) ? MC : end - ic;
+
+                packA(a.mData + ic * k + pc, k, mc, kc, packedA);
+
+                // one B sliver against every A panel of the block
+                for (std::size_t jr = 0; jr < nc; jr += NR) {
+                    for (std::size_t ir = 0; ir < mc; ir += MR) {
+                        T* c = out.mData + (ic + ir) * n + jc + jr;
+
+                        if (ir + MR <= mc && jr + NR <= nc) {
+                            SIMD::gemm(kc, packedA + ir * kc, panel + jr * kc, c, n);
+                            continue;
+                        }
+
+                        // edge tile: full kernel into a scratch tile, only the valid part is added
+                        T tile[MR * NR]{ };
+                        SIMD::gemm(kc, packedA + ir * kc, panel + jr * kc, tile, NR);
+
+                        const std::size_t rows = (ir + MR <= mc) ? MR : mc - ir;
+                        const std::size_t cols = (jr + NR <= nc) ? NR : nc - jr;
+                        for (std::size_t r = 0; r < rows; ++r) {
+                            for (std::size_t j = 0; j < cols; ++j)
+                                c[r * n + j] += tile[r * NR + j];
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    Aligned::release(packedA);
+}
+template <typename T>
+inline void MatX<T>::packA(const T* a, const std::size_t& lda, const std::size_t& mc, const std::size_t& kc, T* dst) noexcept {
+    constexpr std::size_t MR = SIMD::GEMM_MR<T>;
+
+    for (std::size_t ir = 0; ir < mc; ir += MR) {
+        const std::size_t rows = (ir + MR <= mc) ? MR : mc - ir;
+
+        for (std::size_t p = 0; p < kc; ++p) {
+            for (std::size_t r = 0; r < MR; ++r)
+                *dst++ = (r < rows) ? a[(ir + r) * lda + p] : static_cast<T>(0);
+        }
+    }
+}
+template <typename T>
+inline void MatX<T>::packB(const T* b, const std::size_t& ldb, const std::size_t& kc, const std::size_t& nc, T* dst) noexcept {
+    constexpr std::size_t NR = SIMD::GEMM_NR<T>;
+
+    for (std::size_t jr = 0; jr < nc; jr += NR) {
+        const std::size_t cols = (jr + NR <= nc) ? NR : nc - jr;
+
+        for (std::size_t p = 0; p < kc; ++p) {
+            const T* row = b + p * ldb + jr;
+
+            for (std::size_t j = 0; j < NR; ++j)
+                *dst++ = (j < cols) ? row[j] : static_cast<T>(0);
+        }
+    }
+}
+
+template <typename T>
+void MatX<T>::allocate(const std::size_t& count) {
+    release();
+
+    if (count == 0)
+        return;
+
+    mData     = Aligned::allocate<T>(count);
+    mCapacity = count;
+}
+template <typename T>
+void MatX<T>::release() noexcept {
+    Aligned::release(mData);
+
+    mData     = nullptr;
+    mRows     = 0;
+    mCols     = 0;
+    mCapacity = 0;
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>      // size_t
+#include <thread>       // thread, hardware_concurrency()
+#include <vector>       // vector
+
+// Fan-out of one job over worker threads (VecIndex, MatX, Mat covariance, FFT, Fractal). Each
+// caller names its own unit of work and how many units make a thread worth starting; workers()
+// turns that into a thread count, run() starts them, keeps part 0 on the calling thread and
+// joins before it returns.
+class Parallel {
+    Parallel() = delete;
+    Parallel(const Parallel&) = delete;
+    Parallel(Parallel&&) noexcept = delete;
+    ~Parallel() noexcept = delete;
+
+    Parallel& operator=(const Parallel&) = delete;
+    Parallel& operator=(Parallel&&) noexcept = delete;
+
+    public:
+        // std::thread::hardware_concurrency(), at least 1. Queried once: it reads the system's
+        // CPU list on every call, microseconds next to a small job
+        static inline unsigned int hardware() noexcept;
+
+        // requested threads (0: hardware()), at most one per `minimum` units of work and one per
+        // part the job splits into, at least 1
+        static inline unsigned int workers(const unsigned int& requested, const std::size_t& work,
+                                           const std::size_t& minimum = 1, const std::size_t& parts = static_cast<std::size_t>(-1)) noexcept;
+
+        // f(part) for every part in [0, count), part 0 on the calling thread
+        template <typename F>
+        static void run(const unsigned int& count, const F& f);
+};
+
+inline unsigned int Parallel::hardware() noexcept {
+    static const unsigned int count = std::thread::hardware_concurrency();
+
+    return (count == 0) ? 1 : count;
+}
+inline unsigned int Parallel::workers(const unsigned int& requested, const std::size_t& work, const std::size_t& minimum, const std::size_t& parts) noexcept {
+    std::size_t count = (requested == 0) ? hardware() : requested;
+
+    const std::size_t useful = work / minimum;
+    if (useful < count)
+        count = useful;
+    if (parts < count)
+        count = parts;
+
+    return (count == 0) ? 1 : static_cast<unsigned int>(count);
+}
+template <typename F>
+void Parallel::run(const unsigned int& count, const F& f) {
+    if (count <= 1) {
+        f(0u);
+
+        return;
+    }
+
+    std::vector<std::thread> pool;
+    pool.reserve(count - 1);
+
+    for (unsigned int part = 1; part < count; ++part)
+        pool.emplace_back([&f, part]() { f(part); });
+
+    f(0u);
+
+    for (std::thread& thread: pool)
+        thread.join();
+}
\ No newline at end of file
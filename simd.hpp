@@ -0,0 +1,2142 @@
+#pragma once
+
+#include "typeHandler.hpp"
+
+#include <cmath>        // sqrt(), abs()
+#include <cstddef>      // size_t
+#include <cstdint>      // uintptr_t
+#include <cstring>      // memcpy()
+#include <utility>      // index_sequence, index_sequence_for
+
+// Opt-in: define MATH_ENABLE_SIMD before including any header of this library
+// and build with the matching instruction set flags (-msse3 / -mavx / -mfma).
+#if defined(MATH_ENABLE_SIMD)
+    #if defined(__SSE3__) || defined(__AVX__)
+        #define MATH_SIMD_SSE
+    #endif
+    #if defined(__AVX__)
+        #define MATH_SIMD_AVX
+    #endif
+    #if defined(__FMA__)
+        #define MATH_SIMD_FMA
+    #endif
+#endif
+
+#if defined(MATH_SIMD_SSE)
+    #include <immintrin.h>
+#endif
+
+// math.hpp includes this file, it is included at the end of this one for Math::EPSILON
+class Math;
+
+class SIMD {
+    SIMD() = delete;
+    SIMD(const SIMD&) = delete;
+    SIMD(SIMD&&) noexcept = delete;
+    ~SIMD() noexcept = delete;
+
+    SIMD& operator=(const SIMD&) = delete;
+    SIMD& operator=(SIMD&&) noexcept = delete;
+
+    // the trigonometric array kernels share the register wrappers
+    friend class Math;
+
+    // Availability
+    public:
+        #if defined(MATH_SIMD_SSE)
+            inline static constexpr bool SSE = true;
+        #else
+            inline static constexpr bool SSE = false;
+        #endif
+        #if defined(MATH_SIMD_AVX)
+            inline static constexpr bool AVX = true;
+        #else
+            inline static constexpr bool AVX = false;
+        #endif
+
+        // T lanes fit one register (float -> __m128, double -> __m256d)
+        template <typename T>
+        inline static constexpr bool has4 = (isSame<T, float> && SSE) || (isSame<T, double> && AVX);
+
+        // Vec<T, 4> op Vec<U, 4>
+        template <typename T, typename U>
+        inline static constexpr bool packed4 = has4<T> && isSame<T, U>;
+        // Vec<T, 4> op U (integers convert to T exactly as the scalar path does)
+        template <typename T, typename U>
+        inline static constexpr bool packed4Scalar = has4<T> && (isSame<T, U> || isInteger<U>);
+
+    // Four contiguous lanes (unaligned)
+    public:
+        template <typename T> inline static void add4(const T*, const T*, T*) noexcept;
+        template <typename T> inline static void sub4(const T*, const T*, T*) noexcept;
+
+        template <typename T> inline static void add4(const T*, const T&, T*) noexcept;
+        template <typename T> inline static void sub4(const T*, const T&, T*) noexcept;
+        template <typename T> inline static void mul4(const T*, const T&, T*) noexcept;
+        template <typename T> inline static void div4(const T*, const T&, T*) noexcept;
+
+        template <typename T> inline static T dot4(const T*, const T*) noexcept;
+        template <typename T> inline static void normalize4(const T*, T*) noexcept;
+
+    // N contiguous lanes (unaligned): whole registers of four, then a scalar tail
+    public:
+        template <typename T> inline static void addN(const T*, const T*, T*, const std::size_t&) noexcept;
+        template <typename T> inline static void subN(const T*, const T*, T*, const std::size_t&) noexcept;
+
+        template <typename T> inline static void addN(const T*, const T&, T*, const std::size_t&) noexcept;
+        template <typename T> inline static void subN(const T*, const T&, T*, const std::size_t&) noexcept;
+        template <typename T> inline static void mulN(const T*, const T&, T*, const std::size_t&) noexcept;
+        template <typename T> inline static void divN(const T*, const T&, T*, const std::size_t&) noexcept;
+
+        // four independent accumulators (registers or not), so long vectors are not bound by the add latency
+        template <typename T> inline static T dotN(const T*, const T*, const std::size_t&) noexcept;
+        // signed bytes (quantized vectors), summed exactly in int32
+        inline static int dotN(const signed char*, const signed char*, const std::size_t&) noexcept;
+
+    // Sixteen contiguous lanes, row-major
+    public:
+        // a * b, each entry summed as ((((0 + a0 b0) + a1 b1) + a2 b2) + a3 b3): bit-identical to the scalar
+        // loop without FMA, one rounding per step with it (as GCC contracts that loop under -mfma)
+        template <typename T> inline static void mul4x4(const T*, const T*, T*) noexcept;
+        // twelve lanes, the bottom rows are implicitly (0, 0, 0, 1)
+        template <typename T> inline static void mul3x4(const T*, const T*, T*) noexcept;
+
+        // out = adj(m) / det(m), returns det(m) (2x2 block cofactors, requires has4<T>)
+        template <typename T> inline static T inverse4x4(const T* m, T* out) noexcept;
+
+    // Row-major 4x4 applied to arrays of column vectors (requires has4<T>)
+    public:
+        // outputs at least this large bypass the cache with non-temporal stores (Vec4 outputs only when
+        // element aligned, Vec3 outputs from their first register aligned element on)
+        inline static constexpr std::size_t STREAM_BYTES = 4 * 1024 * 1024;
+
+        // out[i] = m * in[i]                       (4 lanes per element)
+        template <typename T> inline static void transform4(const T* m, const T* in, T* out, const std::size_t& count) noexcept;
+        // out[i] = m * (in[i], w), divided by the result w if project  (3 lanes per element)
+        template <typename T> inline static void transform3(const T* m, const T* in, T* out, const std::size_t& count, const T& w, const bool& project) noexcept;
+
+    // Arrays of Vec / Mat through the lane kernels. Their lanes are separate members, so no T* may run from
+    // one object to the next: f(lanes..., n) sees up to a block of objects of every array at a time, copied
+    // into aligned lanes. Const arrays are read (copied in), the others written (copied out after f, never
+    // read: an in place call passes the array twice), arrays of T go through as they are. Outputs of
+    // STREAM_BYTES or more are copied out with non-temporal stores.
+    public:
+        template <typename T, typename F, typename... A>
+        inline static void blocks(const std::size_t& count, const F& f, A*... arrays) noexcept;
+
+    private:
+        // T lanes per object, 0 for T itself
+        template <typename T, typename A>
+        inline static constexpr std::size_t LANES = (isSame<A, T> || isSame<A, const T>) ? 0 : sizeof(A) / sizeof(T);
+
+        template <typename T, typename F, std::size_t... I, typename... A>
+        inline static void blocks(const std::size_t& count, const F& f, std::index_sequence<I...>, A*... arrays) noexcept;
+
+        template <typename T, typename A> inline static void copyIn(const A* src, T* lanes, const std::size_t& n) noexcept;
+        template <typename T, typename A> inline static void copyIn(A*, T*, const std::size_t&) noexcept { }
+        template <typename T, typename A> inline static const T* view(const A* array, T* lanes) noexcept;
+        template <typename T, typename A> inline static T* view(A* array, T* lanes) noexcept;
+        // true if streamed (count: the whole array)
+        template <typename T, typename A> inline static bool copyOut(const A*, const T*, const std::size_t&, const std::size_t&) noexcept { return false; }
+        template <typename T, typename A> inline static bool copyOut(A* dst, const T* lanes, const std::size_t& n, const std::size_t& count) noexcept;
+
+        // memcpy, the 16 byte aligned middle of dst with non-temporal stores (the caller fences)
+        inline static void streamCopy(void* dst, const void* src, const std::size_t& bytes) noexcept;
+
+    // Packed GEMM micro-kernel: c (GEMM_MR x GEMM_NR tile, row stride ldc) += a * b over kc steps,
+    // a packed GEMM_MR lanes per step (a column of the tile rows), b GEMM_NR lanes per step (a row)
+    public:
+        template <typename T> inline static constexpr unsigned int GEMM_MR = 6;
+        template <typename T> inline static constexpr unsigned int GEMM_NR = (isSame<T, float> && AVX) ? 16 : (has4<T> ? 8 : 4);
+
+        template <typename T> inline static void gemm(const std::size_t& kc, const T* a, const T* b, T* c, const std::size_t& ldc) noexcept;
+
+    // Batched N x N linear systems (N = 2 - 4, float / double): matrices row-major N * N lanes apart,
+    // right-hand sides and solutions N lanes apart. Four systems run side by side, one per register
+    // lane (has4<T>, otherwise one at a time). Returns how many systems were singular (LU) or not
+    // positive definite (Cholesky), their solutions are zero.
+    public:
+        // Gaussian elimination with partial pivoting
+        template <unsigned int N, typename T> inline static std::size_t solveLU(const T* a, const T* b, T* x, const std::size_t& count) noexcept;
+        // symmetric positive definite, only the lower triangles are read
+        template <unsigned int N, typename T> inline static std::size_t solveCholesky(const T* a, const T* b, T* x, const std::size_t& count) noexcept;
+
+    // Symmetric 3x3 eigen decomposition: cyclic Jacobi with a fixed number of sweeps, no branches.
+    // m row-major 9 lanes apart, values 3 lanes apart in descending order, vectors 9 lanes apart
+    // with one unit eigenvector per row. Four matrices per register (has4<T>), the rest one at a time.
+    public:
+        // enough for float / double precision on any input (quadratic convergence)
+        template <typename T> inline static constexpr unsigned int JACOBI_SWEEPS = isSame<T, float> ? 4 : 6;
+
+        template <typename T> inline static void eigen3(const T* m, T* values, T* vectors, const std::size_t& count) noexcept;
+
+    // Rotation quaternions (x, y, z, w) 4 lanes apart. Four quaternions per register (has4<T>),
+    // transposed into x / y / z / w registers, the rest one at a time. Any output may be one of the inputs.
+    public:
+        // from a[i] (t = 0) to b[i] (t = 1) on the shorter arc: normalized lerp / spherical, which takes the
+        // nlerp where sin(theta) vanishes. theta = atan2(sqrt(1 - c^2), c) and the sines go through the Math
+        // array kernels, 64 quaternions a pass
+        template <typename T> inline static void quatNlerp(const T* a, const T* b, const T& t, T* out, const std::size_t& count) noexcept;
+        template <typename T> inline static void quatSlerp(const T* a, const T* b, const T& t, T* out, const std::size_t& count) noexcept;
+        // row-major rotation matrices, 16 lanes apart
+        template <typename T> inline static void quatToMat4(const T* q, T* out, const std::size_t& count) noexcept;
+
+    // Escape-time iteration z = z^2 + c from z = (zr, zi), c = (cr, ci): counts[i] is how many
+    // iterations point i ran with |z| <= 2, at most limit (float limit up to 2^24). Groups of
+    // ESCAPE_GROUP<T> registers run together until every lane has left, the rest one point at a time.
+    // Returns the sum of counts
+    public:
+        // 16 lanes hide the multiply-add latency, which costs more than lanes idling for the slowest
+        // point of their group (so does refilling lanes as they finish). Without registers one at a time
+        template <typename T> inline static constexpr unsigned int ESCAPE_GROUP = has4<T> ? 4 : 1;
+
+        template <typename T> inline static unsigned long long escapeN(const T* zr, const T* zi, const T* cr, const T* ci, unsigned int* counts, const std::size_t& n, const unsigned int& limit) noexcept;
+
+    // Complex lanes, n values: split (a real and an imaginary plane) or interleaved (real,
+    // imaginary pairs, 2 n lanes). Four values per register (has4<T>), interleaved pairs are
+    // split in registers. Any output may be one of the inputs.
+    public:
+        // out = a * b
+        template <typename T> inline static void complexMulN(const T* ar, const T* ai, const T* br, const T* bi, T* outR, T* outI, const std::size_t& n) noexcept;
+        template <typename T> inline static void complexMulN(const T* a, const T* b, T* out, const std::size_t& n) noexcept;
+        // out = a * conj(b)
+        template <typename T> inline static void complexConjMulN(const T* ar, const T* ai, const T* br, const T* bi, T* outR, T* outI, const std::size_t& n) noexcept;
+        template <typename T> inline static void complexConjMulN(const T* a, const T* b, T* out, const std::size_t& n) noexcept;
+        // out = a / b, one division per value (b = 0 is not checked)
+        template <typename T> inline static void complexDivN(const T* ar, const T* ai, const T* br, const T* bi, T* outR, T* outI, const std::size_t& n) noexcept;
+        template <typename T> inline static void complexDivN(const T* a, const T* b, T* out, const std::size_t& n) noexcept;
+
+        // out = re^2 + im^2 / its square root (no rescaling, |z| past sqrt(max of T) overflows)
+        template <typename T> inline static void complexMagnitudeSquareN(const T* re, const T* im, T* out, const std::size_t& n) noexcept;
+        template <typename T> inline static void complexMagnitudeSquareN(const T* a, T* out, const std::size_t& n) noexcept;
+        template <typename T> inline static void complexMagnitudeN(const T* re, const T* im, T* out, const std::size_t& n) noexcept;
+        template <typename T> inline static void complexMagnitudeN(const T* a, T* out, const std::size_t& n) noexcept;
+
+    // Approximate reciprocal square root (a few ULP, under 4e-7 relative error): float
+    // uses the hardware estimate plus one Newton-Raphson step, anything else (or a build
+    // without MATH_SIMD_SSE) 1 / sqrt. Zero gives inf / NaN, nothing is checked.
+    public:
+        template <typename T> inline static T rsqrt(const T&) noexcept;
+
+        // count vectors of DIM contiguous lanes
+        template <unsigned int DIM, typename T> inline static void fastNormalize(const T* in, T* out, const std::size_t& count) noexcept;
+        template <unsigned int DIM, typename T> inline static void fastLength(const T* in, T* out, const std::size_t& count) noexcept;
+
+    private:
+        inline static void prefetch(const void* p) noexcept {
+            #if defined(MATH_SIMD_SSE)
+                _mm_prefetch(static_cast<const char*>(p), _MM_HINT_T0);
+            #else
+                (void)p;
+            #endif
+        }
+        inline static void fence() noexcept {
+            #if defined(MATH_SIMD_SSE)
+                _mm_sfence();
+            #endif
+        }
+
+        #if defined(MATH_SIMD_SSE)
+            inline static __m128 load(const float* p) noexcept { return _mm_loadu_ps(p); }
+            inline static void store(float* p, const __m128& v) noexcept { _mm_storeu_ps(p, v); }
+            inline static __m128 broadcast(const float& val) noexcept { return _mm_set1_ps(val); }
+            inline static __m128 set(const float& a, const float& b, const float& c, const float& d) noexcept { return _mm_setr_ps(a, b, c, d); }
+            inline static void stream(float* p, const __m128& v) noexcept { _mm_stream_ps(p, v); }
+            inline static void store3(float* p, const __m128& v) noexcept {
+                _mm_storel_pi(reinterpret_cast<__m64*>(p), v);
+                _mm_store_ss(p + 2, _mm_movehl_ps(v, v));
+            }
+            // x, y, z of r0 - r3 as three non-temporal registers (p 16 byte aligned)
+            inline static void stream3(float* p, const __m128& r0, const __m128& r1, const __m128& r2, const __m128& r3) noexcept {
+                _mm_stream_ps(p,     _mm_shuffle_ps(r0, _mm_shuffle_ps(r0, r1, _MM_SHUFFLE(0, 0, 2, 2)), _MM_SHUFFLE(2, 0, 1, 0)));
+                _mm_stream_ps(p + 4, _mm_shuffle_ps(r1, r2, _MM_SHUFFLE(1, 0, 2, 1)));
+                _mm_stream_ps(p + 8, _mm_shuffle_ps(_mm_shuffle_ps(r2, r3, _MM_SHUFFLE(0, 0, 2, 2)), r3, _MM_SHUFFLE(2, 1, 2, 0)));
+            }
+            inline static __m128 broadcastW(const __m128& v) noexcept { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)); }
+
+            // lane i of the result is lane Ii of v
+            template <int I0, int I1, int I2, int I3>
+            inline static __m128 swizzle(const __m128& v) noexcept { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(I3, I2, I1, I0)); }
+            // (a[I0], a[I1], b[J0], b[J1])
+            template <int I0, int I1, int J0, int J1>
+            inline static __m128 shuffle(const __m128& a, const __m128& b) noexcept { return _mm_shuffle_ps(a, b, _MM_SHUFFLE(J1, J0, I1, I0)); }
+            // (a0, a1, b0, b1) / (a2, a3, b2, b3)
+            inline static __m128 lowHalves(const __m128& a, const __m128& b) noexcept { return _mm_movelh_ps(a, b); }
+            inline static __m128 highHalves(const __m128& a, const __m128& b) noexcept { return _mm_movehl_ps(b, a); }
+
+            inline static __m128 add(const __m128& a, const __m128& b) noexcept { return _mm_add_ps(a, b); }
+            inline static __m128 sub(const __m128& a, const __m128& b) noexcept { return _mm_sub_ps(a, b); }
+            inline static __m128 mul(const __m128& a, const __m128& b) noexcept { return _mm_mul_ps(a, b); }
+            inline static __m128 div(const __m128& a, const __m128& b) noexcept { return _mm_div_ps(a, b); }
+            inline static __m128 div(const __m128& a, const float& val) noexcept { return _mm_div_ps(a, _mm_set1_ps(val)); }
+            inline static __m128 sqrt(const __m128& a) noexcept { return _mm_sqrt_ps(a); }
+            // y * (1.5 - 0.5 * a * y * y), y = rsqrtps(a)
+            inline static __m128 rsqrt(const __m128& a) noexcept {
+                const __m128 y = _mm_rsqrt_ps(a);
+
+                return _mm_mul_ps(y, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), a), _mm_mul_ps(y, y))));
+            }
+
+            // a * b + c
+            inline static __m128 fmadd(const __m128& a, const __m128& b, const __m128& c) noexcept {
+                #if defined(MATH_SIMD_FMA)
+                    return _mm_fmadd_ps(a, b, c);
+                #else
+                    return _mm_add_ps(_mm_mul_ps(a, b), c);
+                #endif
+            }
+
+            inline static float first(const __m128& v) noexcept { return _mm_cvtss_f32(v); }
+
+            // sum of all lanes, broadcast to every lane
+            inline static __m128 hsum(const __m128& v) noexcept {
+                const __m128 pair = _mm_add_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+
+                return _mm_add_ps(pair, _mm_shuffle_ps(pair, pair, _MM_SHUFFLE(1, 0, 3, 2)));
+            }
+
+            // round to nearest (even) integer lanes and back
+            inline static __m128i roundInt(const __m128& v) noexcept { return _mm_cvtps_epi32(v); }
+            inline static __m128 toFloat(const __m128i& v) noexcept { return _mm_cvtepi32_ps(v); }
+            // lanes with bit I of q set: every bit / only the sign bit
+            template <int I>
+            inline static __m128 bitMask(const __m128i& q) noexcept {
+                const __m128i bit = _mm_set1_epi32(1 << I);
+
+                return _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(q, bit), bit));
+            }
+            template <int I>
+            inline static __m128 bitSign(const __m128i& q) noexcept { return _mm_castsi128_ps(_mm_slli_epi32(_mm_srli_epi32(q, I), 31)); }
+            // mask ? a : b, per lane
+            inline static __m128 select(const __m128& mask, const __m128& a, const __m128& b) noexcept { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+            inline static __m128 flipSign(const __m128& v, const __m128& sign) noexcept { return _mm_xor_ps(v, sign); }
+            // every bit of the lanes with the sign bit set (-0 included)
+            inline static __m128 signMask(const __m128& v) noexcept { return _mm_castsi128_ps(_mm_srai_epi32(_mm_castps_si128(v), 31)); }
+            inline static __m128 signBit(const __m128& v) noexcept { return _mm_and_ps(v, _mm_set1_ps(-0.0f)); }
+
+            // v 2^k, k up to twice a normal exponent (two steps, so a denormal result survives)
+            inline static __m128 mulPow2(const __m128& v, const __m128i& k) noexcept {
+                const __m128i half = _mm_srai_epi32(k, 1);
+                const __m128i bias = _mm_set1_epi32(127);
+
+                const __m128 a = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(half, bias), 23));
+                const __m128 b = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(_mm_sub_epi32(k, half), bias), 23));
+
+                return _mm_mul_ps(_mm_mul_ps(v, a), b);
+            }
+            // v = m 2^k (v positive and normal), m in [low, 2 low) for the bits of low
+            inline static __m128 splitExponent(const __m128& v, const unsigned int& low, __m128& k) noexcept {
+                const __m128i bits = _mm_add_epi32(_mm_castps_si128(v), _mm_set1_epi32(static_cast<int>(0x3F80'0000u - low)));
+
+                k = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127)));
+
+                return _mm_castsi128_ps(_mm_add_epi32(_mm_and_si128(bits, _mm_set1_epi32(0x007F'FFFF)), _mm_set1_epi32(static_cast<int>(low))));
+            }
+
+            // four (re, im) pairs from v0, v1 into four real / imaginary lanes and back
+            inline static void deinterleave(const __m128& v0, const __m128& v1, __m128& re, __m128& im) noexcept {
+                re = _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(2, 0, 2, 0));
+                im = _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(3, 1, 3, 1));
+            }
+            inline static void interleave(const __m128& re, const __m128& im, __m128& v0, __m128& v1) noexcept {
+                v0 = _mm_unpacklo_ps(re, im);
+                v1 = _mm_unpackhi_ps(re, im);
+            }
+            // rows r0 - r3 into columns, in place
+            inline static void transpose4(__m128& r0, __m128& r1, __m128& r2, __m128& r3) noexcept { _MM_TRANSPOSE4_PS(r0, r1, r2, r3); }
+        #endif
+        #if defined(MATH_SIMD_AVX)
+            inline static __m256d load(const double* p) noexcept { return _mm256_loadu_pd(p); }
+            inline static void store(double* p, const __m256d& v) noexcept { _mm256_storeu_pd(p, v); }
+            inline static __m256d broadcast(const double& val) noexcept { return _mm256_set1_pd(val); }
+            inline static __m256d set(const double& a, const double& b, const double& c, const double& d) noexcept { return _mm256_setr_pd(a, b, c, d); }
+            inline static void stream(double* p, const __m256d& v) noexcept { _mm256_stream_pd(p, v); }
+            inline static void store3(double* p, const __m256d& v) noexcept {
+                _mm_storeu_pd(p, _mm256_castpd256_pd128(v));
+                _mm_store_sd(p + 2, _mm256_extractf128_pd(v, 1));
+            }
+            // (p 32 byte aligned)
+            inline static void stream3(double* p, const __m256d& r0, const __m256d& r1, const __m256d& r2, const __m256d& r3) noexcept {
+                const __m256d r12 = _mm256_permute2f128_pd(r1, r2, 0x21);
+
+                _mm256_stream_pd(p,     _mm256_shuffle_pd(r0, _mm256_permute2f128_pd(r0, r1, 0x20), 0b0010));
+                _mm256_stream_pd(p + 4, _mm256_blend_pd(_mm256_shuffle_pd(r1, r12, 0b0001), r12, 0b1100));
+                _mm256_stream_pd(p + 8, _mm256_shuffle_pd(_mm256_permute2f128_pd(r2, r3, 0x21), r3, 0b0100));
+            }
+            inline static __m256d broadcastW(const __m256d& v) noexcept { return _mm256_permute_pd(_mm256_permute2f128_pd(v, v, 0x11), 0b1111); }
+
+            template <int I0, int I1, int I2, int I3>
+            inline static __m256d swizzle(const __m256d& v) noexcept {
+                #if defined(__AVX2__)
+                    return _mm256_permute4x64_pd(v, _MM_SHUFFLE(I3, I2, I1, I0));
+                #else
+                    // pick within duplicated low / high halves, then blend
+                    constexpr int inPair = (I0 & 1) | ((I1 & 1) << 1) | ((I2 & 1) << 2) | ((I3 & 1) << 3);
+                    constexpr int fromHigh = (I0 >> 1) | ((I1 >> 1) << 1) | ((I2 >> 1) << 2) | ((I3 >> 1) << 3);
+
+                    const __m256d low  = _mm256_permute_pd(_mm256_permute2f128_pd(v, v, 0x00), inPair);
+                    const __m256d high = _mm256_permute_pd(_mm256_permute2f128_pd(v, v, 0x11), inPair);
+
+                    return _mm256_blend_pd(low, high, fromHigh);
+                #endif
+            }
+            inline static __m256d lowHalves(const __m256d& a, const __m256d& b) noexcept { return _mm256_permute2f128_pd(a, b, 0x20); }
+            inline static __m256d highHalves(const __m256d& a, const __m256d& b) noexcept { return _mm256_permute2f128_pd(a, b, 0x31); }
+
+            inline static __m256d add(const __m256d& a, const __m256d& b) noexcept { return _mm256_add_pd(a, b); }
+            inline static __m256d sub(const __m256d& a, const __m256d& b) noexcept { return _mm256_sub_pd(a, b); }
+            inline static __m256d mul(const __m256d& a, const __m256d& b) noexcept { return _mm256_mul_pd(a, b); }
+            inline static __m256d div(const __m256d& a, const __m256d& b) noexcept { return _mm256_div_pd(a, b); }
+            // by a scalar as two 128-bit divides: the 256-bit divider is not fully pipelined (about 1.4x faster per Vec4)
+            inline static __m256d div(const __m256d& a, const double& val) noexcept {
+                const __m128d d = _mm_set1_pd(val);
+
+                return _mm256_set_m128d(_mm_div_pd(_mm256_extractf128_pd(a, 1), d), _mm_div_pd(_mm256_castpd256_pd128(a), d));
+            }
+            inline static __m256d sqrt(const __m256d& a) noexcept { return _mm256_sqrt_pd(a); }
+
+            inline static __m256d fmadd(const __m256d& a, const __m256d& b, const __m256d& c) noexcept {
+                #if defined(MATH_SIMD_FMA)
+                    return _mm256_fmadd_pd(a, b, c);
+                #else
+                    return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+                #endif
+            }
+
+            inline static double first(const __m256d& v) noexcept { return _mm256_cvtsd_f64(v); }
+
+            inline static __m256d hsum(const __m256d& v) noexcept {
+                const __m256d pair = _mm256_add_pd(v, _mm256_permute_pd(v, 0b0101));
+
+                return _mm256_add_pd(pair, _mm256_permute2f128_pd(pair, pair, 0x01));
+            }
+
+            // the lanes come out as pairs 0, 2, 1, 3, interleave() puts them back
+            inline static void deinterleave(const __m256d& v0, const __m256d& v1, __m256d& re, __m256d& im) noexcept {
+                re = _mm256_unpacklo_pd(v0, v1);
+                im = _mm256_unpackhi_pd(v0, v1);
+            }
+            inline static void interleave(const __m256d& re, const __m256d& im, __m256d& v0, __m256d& v1) noexcept {
+                v0 = _mm256_unpacklo_pd(re, im);
+                v1 = _mm256_unpackhi_pd(re, im);
+            }
+            inline static void transpose4(__m256d& r0, __m256d& r1, __m256d& r2, __m256d& r3) noexcept {
+                const __m256d t0 = _mm256_unpacklo_pd(r0, r1);
+                const __m256d t1 = _mm256_unpackhi_pd(r0, r1);
+                const __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+                const __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+
+                r0 = _mm256_permute2f128_pd(t0, t2, 0x20);
+                r1 = _mm256_permute2f128_pd(t1, t3, 0x20);
+                r2 = _mm256_permute2f128_pd(t0, t2, 0x31);
+                r3 = _mm256_permute2f128_pd(t1, t3, 0x31);
+            }
+        #endif
+
+        // 2x2 matrices packed row-major in one register
+        #if defined(MATH_SIMD_SSE)
+            template <typename V> inline static V det2(const V&) noexcept;
+            template <typename V> inline static V mul2(const V&, const V&) noexcept;
+            template <typename V> inline static V adjMul2(const V&, const V&) noexcept;
+            template <typename V> inline static V mulAdj2(const V&, const V&) noexcept;
+        #endif
+
+        // the lane operations of the solvers on plain scalars (a mask is a bool)
+        template <typename T, typename = enableIF<isFloat<T>>> inline static T add(const T& a, const T& b) noexcept { return a + b; }
+        template <typename T, typename = enableIF<isFloat<T>>> inline static T sub(const T& a, const T& b) noexcept { return a - b; }
+        template <typename T, typename = enableIF<isFloat<T>>> inline static T mul(const T& a, const T& b) noexcept { return a * b; }
+        template <typename T, typename = enableIF<isFloat<T>>> inline static T div(const T& a, const T& b) noexcept { return a / b; }
+        template <typename T, typename = enableIF<isFloat<T>>> inline static T sqrt(const T& a) noexcept { return std::sqrt(a); }
+        template <typename T, typename = enableIF<isFloat<T>>> inline static T abs(const T& a) noexcept { return std::abs(a); }
+        template <typename T, typename = enableIF<isFloat<T>>> inline static bool greater(const T& a, const T& b) noexcept { return a > b; }
+        template <typename T, typename = enableIF<isFloat<T>>> inline static bool lessEqual(const T& a, const T& b) noexcept { return a <= b; }
+        template <typename T, typename = enableIF<isFloat<T>>> inline static T select(const bool& mask, const T& a, const T& b) noexcept { return mask ? a : b; }
+        inline static bool maskOr(const bool& a, const bool& b) noexcept { return a || b; }
+        inline static bool maskAnd(const bool& a, const bool& b) noexcept { return a && b; }
+        inline static int maskBits(const bool& mask) noexcept { return mask ? 1 : 0; }
+
+        #if defined(MATH_SIMD_SSE)
+            inline static __m128 abs(const __m128& v) noexcept { return _mm_andnot_ps(_mm_set1_ps(-0.0f), v); }
+            inline static __m128 greater(const __m128& a, const __m128& b) noexcept { return _mm_cmpgt_ps(a, b); }
+            inline static __m128 lessEqual(const __m128& a, const __m128& b) noexcept { return _mm_cmple_ps(a, b); }
+            inline static __m128 maskOr(const __m128& a, const __m128& b) noexcept { return _mm_or_ps(a, b); }
+            inline static __m128 maskAnd(const __m128& a, const __m128& b) noexcept { return _mm_and_ps(a, b); }
+            inline static int maskBits(const __m128& mask) noexcept { return _mm_movemask_ps(mask); }
+        #endif
+        #if defined(MATH_SIMD_AVX)
+            inline static __m256d abs(const __m256d& v) noexcept { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), v); }
+            inline static __m256d greater(const __m256d& a, const __m256d& b) noexcept { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+            inline static __m256d lessEqual(const __m256d& a, const __m256d& b) noexcept { return _mm256_cmp_pd(a, b, _CMP_LE_OQ); }
+            inline static __m256d select(const __m256d& mask, const __m256d& a, const __m256d& b) noexcept { return _mm256_blendv_pd(b, a, mask); }
+            inline static __m256d maskOr(const __m256d& a, const __m256d& b) noexcept { return _mm256_or_pd(a, b); }
+            inline static __m256d maskAnd(const __m256d& a, const __m256d& b) noexcept { return _mm256_and_pd(a, b); }
+            inline static int maskBits(const __m256d& mask) noexcept { return _mm256_movemask_pd(mask); }
+        #endif
+
+        // W = 4: a register whose lane s is p[s * stride] (has4<T>), W = 1: the T itself
+        template <unsigned int W, typename T> inline static auto gather(const T* p, const std::size_t& stride) noexcept;
+        template <unsigned int W, typename T> inline static auto splat(const T&) noexcept;
+        template <unsigned int W, typename T, typename V> inline static void scatter(const V&, T* p, const std::size_t& stride) noexcept;
+
+        // op(ar, ai, br, bi, r, i) on registers, then on the scalar tail
+        template <typename T, typename F>
+        inline static void complexN(const F& op, const T* ar, const T* ai, const T* br, const T* bi, T* outR, T* outI, const std::size_t& n) noexcept;
+        template <typename T, typename F>
+        inline static void complexN(const F& op, const T* a, const T* b, T* out, const std::size_t& n) noexcept;
+        // out = op(re, im)
+        template <typename T, typename F>
+        inline static void complexUnaryN(const F& op, const T* re, const T* im, T* out, const std::size_t& n) noexcept;
+        template <typename T, typename F>
+        inline static void complexUnaryN(const F& op, const T* a, T* out, const std::size_t& n) noexcept;
+
+        // W matrices from m on, a holds the diagonal then (0, 1), (0, 2), (1, 2)
+        template <unsigned int W, unsigned int G, typename T> inline static void eigen3(const T* m, T* values, T* vectors) noexcept;
+        template <unsigned int W, unsigned int G, typename T, typename V> inline static void jacobi3(V (&a)[G][6], V (&v)[G][3][3]) noexcept;
+
+        // W rows of 4 lanes, stride lanes apart from p on, as 4 column registers (W = 4: a transpose) and back
+        template <unsigned int W, typename T, typename V> inline static void loadRows(const T* p, const std::size_t& stride, V (&columns)[4]) noexcept;
+        template <unsigned int W, typename T, typename V> inline static void storeRows(V (&columns)[4], T* p, const std::size_t& stride) noexcept;
+        // W quaternions at a time (dot: W lanes, out = a wa + b wb with W lanes of each weight)
+        template <unsigned int W, typename T> inline static void quatNlerp(const T* a, const T* b, const T& t, T* out) noexcept;
+        template <unsigned int W, typename T> inline static void quatDot(const T* a, const T* b, T* dot) noexcept;
+        template <unsigned int W, typename T> inline static void quatBlend(const T* a, const T* b, const T* wa, const T* wb, T* out) noexcept;
+        template <unsigned int W, typename T> inline static void quatToMat4(const T* q, T* out) noexcept;
+
+        // G * W points
+        template <unsigned int W, unsigned int G, typename T>
+        inline static unsigned long long escape(const T* zr, const T* zi, const T* cr, const T* ci, unsigned int* counts, const unsigned int& limit) noexcept;
+
+        template <unsigned int N, bool SPD, typename T>
+        inline static std::size_t solve(const T* a, const T* b, T* x, const std::size_t& count) noexcept;
+        // a and b are destroyed, returns the mask of the failed lanes
+        template <unsigned int N, typename V>
+        inline static auto eliminate(V (&a)[N][N], V (&b)[N], V (&x)[N], const V& eps) noexcept;
+        template <unsigned int N, typename V>
+        inline static auto cholesky(const V (&a)[N][N], const V (&b)[N], V (&x)[N], const V& eps) noexcept;
+
+        // four contiguous vectors of DIM (2 - 4) float lanes
+        #if defined(MATH_SIMD_SSE)
+            // loads them into rows, returns their squared lengths
+            template <unsigned int DIM> inline static __m128 lengthSquare4(const float* v, __m128* rows) noexcept;
+            // scales each vector in rows by its lane of s
+            template <unsigned int DIM> inline static void scale4(__m128* rows, const __m128& s) noexcept;
+        #endif
+};
+
+template <typename T>
+inline void SIMD::add4(const T* a, const T* b, T* out) noexcept {
+    if constexpr (has4<T>)
+        store(out, add(load(a), load(b)));
+    else {
+        for (unsigned int i = 0; i < 4; ++i)
+            out[i] = a[i] + b[i];
+    }
+}
+template <typename T>
+inline void SIMD::sub4(const T* a, const T* b, T* out) noexcept {
+    if constexpr (has4<T>)
+        store(out, sub(load(a), load(b)));
+    else {
+        for (unsigned int i = 0; i < 4; ++i)
+            out[i] = a[i] - b[i];
+    }
+}
+
+template <typename T>
+inline void SIMD::add4(const T* a, const T& val, T* out) noexcept {
+    if constexpr (has4<T>)
+        store(out, add(load(a), broadcast(val)));
+    else {
+        for (unsigned int i = 0; i < 4; ++i)
+            out[i] = a[i] + val;
+    }
+}
+template <typename T>
+inline void SIMD::sub4(const T* a, const T& val, T* out) noexcept {
+    if constexpr (has4<T>)
+        store(out, sub(load(a), broadcast(val)));
+    else {
+        for (unsigned int i = 0; i < 4; ++i)
+            out[i] = a[i] - val;
+    }
+}
+template <typename T>
+inline void SIMD::mul4(const T* a, const T& val, T* out) noexcept {
+    if constexpr (has4<T>)
+        store(out, mul(load(a), broadcast(val)));
+    else {
+        for (unsigned int i = 0; i < 4; ++i)
+            out[i] = a[i] * val;
+    }
+}
+template <typename T>
+inline void SIMD::div4(const T* a, const T& val, T* out) noexcept {
+    if constexpr (has4<T>)
+        store(out, div(load(a), val));
+    else {
+        for (unsigned int i = 0; i < 4; ++i)
+            out[i] = a[i] / val;
+    }
+}
+
+template <typename T>
+inline T SIMD::dot4(const T* a, const T* b) noexcept {
+    if constexpr (has4<T>)
+        return first(hsum(mul(load(a), load(b))));
+    else
+        return (a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3]);
+}
+template <typename T>
+inline void SIMD::normalize4(const T* a, T* out) noexcept {
+    if constexpr (has4<T>) {
+        const auto v = load(a);
+
+        // the root of one lane: a full-width sqrt of the broadcast sum costs double its latency (__m256d)
+        store(out, div(v, static_cast<T>(std::sqrt(first(hsum(mul(v, v)))))));
+    }
+    else {
+        const T len = static_cast<T>(std::sqrt(dot4(a, a)));
+
+        for (unsigned int i = 0; i < 4; ++i)
+            out[i] = a[i] / len;
+    }
+}
+
+template <typename T>
+inline void SIMD::addN(const T* a, const T* b, T* out, const std::size_t& n) noexcept {
+    std::size_t i = 0;
+
+    if constexpr (has4<T>) {
+        for (; i < n / 4 * 4; i += 4)
+            store(out + i, add(load(a + i), load(b + i)));
+    }
+
+    for (; i < n; ++i)
+        out[i] = a[i] + b[i];
+}
+template <typename T>
+inline void SIMD::subN(const T* a, const T* b, T* out, const std::size_t& n) noexcept {
+    std::size_t i = 0;
+
+    if constexpr (has4<T>) {
+        for (; i < n / 4 * 4; i += 4)
+            store(out + i, sub(load(a + i), load(b + i)));
+    }
+
+    for (; i < n; ++i)
+        out[i] = a[i] - b[i];
+}
+
+template <typename T>
+inline void SIMD::addN(const T* a, const T& val, T* out, const std::size_t& n) noexcept {
+    std::size_t i = 0;
+
+    if constexpr (has4<T>) {
+        const auto v = broadcast(val);
+        for (; i < n / 4 * 4; i += 4)
+            store(out + i, add(load(a + i), v));
+    }
+
+    for (; i < n; ++i)
+        out[i] = a[i] + val;
+}
+template <typename T>
+inline void SIMD::subN(const T* a, const T& val, T* out, const std::size_t& n) noexcept {
+    std::size_t i = 0;
+
+    if constexpr (has4<T>) {
+        const auto v = broadcast(val);
+        for (; i < n / 4 * 4; i += 4)
+            store(out + i, sub(load(a + i), v));
+    }
+
+    for (; i < n; ++i)
+        out[i] = a[i] - val;
+}
+template <typename T>
+inline void SIMD::mulN(const T* a, const T& val, T* out, const std::size_t& n) noexcept {
+    std::size_t i = 0;
+
+    if constexpr (has4<T>) {
+        const auto v = broadcast(val);
+        for (; i < n / 4 * 4; i += 4)
+            store(out + i, mul(load(a + i), v));
+    }
+
+    for (; i < n; ++i)
+        out[i] = a[i] * val;
+}
+template <typename T>
+inline void SIMD::divN(const T* a, const T& val, T* out, const std::size_t& n) noexcept {
+    std::size_t i = 0;
+
+    if constexpr (has4<T>) {
+        const auto v = broadcast(val);
+        for (; i < n / 4 * 4; i += 4)
+            store(out + i, div(load(a + i), v));
+    }
+
+    for (; i < n; ++i)
+        out[i] = a[i] / val;
+}
+
+template <typename T>
+inline T SIMD::dotN(const T* a, const T* b, const std::size_t& n) noexcept {
+    std::size_t i = 0;
+    T sum = static_cast<T>(0);
+
+    if constexpr (has4<T>) {
+        auto acc0 = broadcast(sum);
+        auto acc1 = acc0;
+        auto acc2 = acc0;
+        auto acc3 = acc0;
+
+        for (; i < n / 16 * 16; i += 16) {
+            acc0 = fmadd(load(a + i),      load(b + i),      acc0);
+            acc1 = fmadd(load(a + i + 4),  load(b + i + 4),  acc1);
+            acc2 = fmadd(load(a + i + 8),  load(b + i + 8),  acc2);
+            acc3 = fmadd(load(a + i + 12), load(b + i + 12), acc3);
+        }
+        for (; i < n / 4 * 4; i += 4)
+            acc0 = fmadd(load(a + i), load(b + i), acc0);
+
+        sum = first(hsum(add(add(acc0, acc1), add(acc2, acc3))));
+    }
+    else {
+        T acc[4]{ };
+        for (; i < n / 4 * 4; i += 4) {
+            for (unsigned int lane = 0; lane < 4; ++lane)
+                acc[lane] += a[i + lane] * b[i + lane];
+        }
+
+        sum = (acc[0] + acc[1]) + (acc[2] + acc[3]);
+    }
+
+    for (; i < n; ++i)
+        sum += a[i] * b[i];
+
+    return sum;
+}
+
+inline int SIMD::dotN(const signed char* a, const signed char* b, const std::size_t& n) noexcept {
+    std::size_t i = 0;
+    int sum = 0;
+
+    #if defined(MATH_SIMD_SSE)
+        const auto bytes = [](const signed char* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); };
+
+        // int16 products summed pairwise into int32 lanes (pmaddwd)
+        #if defined(__AVX2__)
+            __m256i wide = _mm256_setzero_si256();
+            for (; i < n / 16 * 16; i += 16)
+                wide = _mm256_add_epi32(wide, _mm256_madd_epi16(_mm256_cvtepi8_epi16(bytes(a + i)), _mm256_cvtepi8_epi16(bytes(b + i))));
+
+            __m128i acc = _mm_add_epi32(_mm256_castsi256_si128(wide), _mm256_extracti128_si256(wide, 1));
+        #else
+            __m128i acc = _mm_setzero_si128();
+            for (; i < n / 16 * 16; i += 16) {
+                const __m128i va = bytes(a + i);
+                const __m128i vb = bytes(b + i);
+
+                // sign extension: each byte into the high half of an int16, then shifted back down
+                const __m128i aLow  = _mm_srai_epi16(_mm_unpacklo_epi8(va, va), 8);
+                const __m128i aHigh = _mm_srai_epi16(_mm_unpackhi_epi8(va, va), 8);
+                const __m128i bLow  = _mm_srai_epi16(_mm_unpacklo_epi8(vb, vb), 8);
+                const __m128i bHigh = _mm_srai_epi16(_mm_unpackhi_epi8(vb, vb), 8);
+
+                acc = _mm_add_epi32(acc, _mm_add_epi32(_mm_madd_epi16(aLow, bLow), _mm_madd_epi16(aHigh, bHigh)));
+            }
+        #endif
+
+        acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(1, 0, 3, 2)));
+        acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(2, 3, 0, 1)));
+        sum = _mm_cvtsi128_si32(acc);
+    #endif
+
+    for (; i < n; ++i)
+        sum += a[i] * b[i];
+
+    return sum;
+}
+
+template <typename T>
+inline T SIMD::rsqrt(const T& val) noexcept {
+    if constexpr (isSame<T, float> && SSE)
+        return first(rsqrt(broadcast(val)));
+    else
+        return static_cast<T>(1) / static_cast<T>(std::sqrt(val));
+}
+template <unsigned int DIM, typename T>
+inline void SIMD::fastNormalize(const T* in, T* out, const std::size_t& count) noexcept {
+    std::size_t i = 0;
+
+    #if defined(MATH_SIMD_SSE)
+        // four vectors per packed rsqrt, without leaving the registers
+        if constexpr (isSame<T, float> && DIM >= 2 && DIM <= 4) {
+            for (; i < count / 4 * 4; i += 4) {
+                __m128 rows[DIM];
+                scale4<DIM>(rows, rsqrt(lengthSquare4<DIM>(in + i * DIM, rows)));
+
+                for (unsigned int d = 0; d < DIM; ++d)
+                    store(out + i * DIM + d * 4, rows[d]);
+            }
+        }
+    #endif
+
+    for (; i < count; ++i) {
+        const T* v = in + i * DIM;
+
+        T sq = v[0] * v[0];
+        for (unsigned int d = 1; d < DIM; ++d)
+            sq += v[d] * v[d];
+
+        const T inv = rsqrt(sq);
+        for (unsigned int d = 0; d < DIM; ++d)
+            out[i * DIM + d] = v[d] * inv;
+    }
+}
+template <unsigned int DIM, typename T>
+inline void SIMD::fastLength(const T* in, T* out, const std::size_t& count) noexcept {
+    std::size_t i = 0;
+
+    #if defined(MATH_SIMD_SSE)
+        if constexpr (isSame<T, float> && DIM >= 2 && DIM <= 4) {
+            for (; i < count / 4 * 4; i += 4) {
+                __m128 rows[DIM];
+                const __m128 sq = lengthSquare4<DIM>(in + i * DIM, rows);
+
+                // zero stays zero instead of 0 * inf
+                store(out + i, _mm_and_ps(mul(sq, rsqrt(sq)), _mm_cmpgt_ps(sq, _mm_setzero_ps())));
+            }
+        }
+    #endif
+
+    for (; i < count; ++i) {
+        const T* v = in + i * DIM;
+
+        T sq = v[0] * v[0];
+        for (unsigned int d = 1; d < DIM; ++d)
+            sq += v[d] * v[d];
+
+        out[i] = (sq > 0) ? sq * rsqrt(sq) : static_cast<T>(0);
+    }
+}
+
+template <typename T>
+inline void SIMD::mul4x4(const T* a, const T* b, T* out) noexcept {
+    if constexpr (has4<T>) {
+        const auto b0 = load(b);
+        const auto b1 = load(b + 4);
+        const auto b2 = load(b + 8);
+        const auto b3 = load(b + 12);
+
+        const auto zero = broadcast(static_cast<T>(0));
+
+        // out[row] = 0 + a[row].x * b[0] + a[row].y * b[1] + a[row].z * b[2] + a[row].w * b[3], summed
+        // from +0 like the scalar loop (a sum of -0 products is +0)
+        const auto row = [&](const T* r) {
+            auto acc = fmadd(broadcast(r[0]), b0, zero);
+            acc = fmadd(broadcast(r[1]), b1, acc);
+            acc = fmadd(broadcast(r[2]), b2, acc);
+
+            return fmadd(broadcast(r[3]), b3, acc);
+        };
+
+        const auto r0 = row(a);
+        const auto r1 = row(a + 4);
+        const auto r2 = row(a + 8);
+        const auto r3 = row(a + 12);
+
+        store(out,      r0);
+        store(out + 4,  r1);
+        store(out + 8,  r2);
+        store(out + 12, r3);
+    }
+    else {
+        for (unsigned int row = 0; row < 4; ++row) {
+            const T* r = a + row * 4;
+
+            for (unsigned int col = 0; col < 4; ++col)
+                out[row * 4 + col] = static_cast<T>(0) + r[0] * b[col] + r[1] * b[4 + col] + r[2] * b[8 + col] + r[3] * b[12 + col];
+        }
+    }
+}
+
+template <typename T>
+inline void SIMD::mul3x4(const T* a, const T* b, T* out) noexcept {
+    if constexpr (has4<T>) {
+        const auto b0 = load(b);
+        const auto b1 = load(b + 4);
+        const auto b2 = load(b + 8);
+        const auto b3 = set(static_cast<T>(0), static_cast<T>(0), static_cast<T>(0), static_cast<T>(1));
+
+        const auto row = [&](const T* r) {
+            auto acc = fmadd(broadcast(r[3]), b3, mul(broadcast(r[0]), b0));
+            acc = fmadd(broadcast(r[1]), b1, acc);
+
+            return fmadd(broadcast(r[2]), b2, acc);
+        };
+
+        const auto r0 = row(a);
+        const auto r1 = row(a + 4);
+        const auto r2 = row(a + 8);
+
+        store(out,     r0);
+        store(out + 4, r1);
+        store(out + 8, r2);
+    }
+    else {
+        for (unsigned int row = 0; row < 3; ++row) {
+            const T* r = a + row * 4;
+
+            for (unsigned int col = 0; col < 4; ++col)
+                out[row * 4 + col] = r[0] * b[col] + r[1] * b[4 + col] + r[2] * b[8 + col];
+
+            out[row * 4 + 3] += r[3];
+        }
+    }
+}
+
+#if defined(MATH_SIMD_SSE)
+    // det(a) in every lane
+    template <typename V>
+    inline V SIMD::det2(const V& a) noexcept {
+        const V p = mul(a, swizzle<3, 2, 1, 0>(a));
+
+        return sub(swizzle<0, 0, 0, 0>(p), swizzle<1, 1, 1, 1>(p));
+    }
+    // a * b
+    template <typename V>
+    inline V SIMD::mul2(const V& a, const V& b) noexcept {
+        return fmadd(a, swizzle<0, 3, 0, 3>(b), mul(swizzle<1, 0, 3, 2>(a), swizzle<2, 1, 2, 1>(b)));
+    }
+    // adj(a) * b
+    template <typename V>
+    inline V SIMD::adjMul2(const V& a, const V& b) noexcept {
+        return sub(mul(swizzle<3, 3, 0, 0>(a), b), mul(swizzle<1, 1, 2, 2>(a), swizzle<2, 3, 0, 1>(b)));
+    }
+    // a * adj(b)
+    template <typename V>
+    inline V SIMD::mulAdj2(const V& a, const V& b) noexcept {
+        return sub(mul(a, swizzle<3, 0, 3, 0>(b)), mul(swizzle<1, 0, 3, 2>(a), swizzle<2, 1, 2, 1>(b)));
+    }
+
+    // | A B |
+    // | C D |   det = det(A) det(D) + det(B) det(C) - tr(adj(A) B adj(D) C)
+    template <typename T>
+    inline T SIMD::inverse4x4(const T* m, T* out) noexcept {
+        static_assert(has4<T>);
+
+        const auto r0 = load(m);
+        const auto r1 = load(m + 4);
+        const auto r2 = load(m + 8);
+        const auto r3 = load(m + 12);
+
+        const auto A = lowHalves(r0, r1);
+        const auto B = highHalves(r0, r1);
+        const auto C = lowHalves(r2, r3);
+        const auto D = highHalves(r2, r3);
+
+        const auto detA = det2(A);
+        const auto detB = det2(B);
+        const auto detC = det2(C);
+        const auto detD = det2(D);
+
+        const auto AB = adjMul2(A, B);
+        const auto DC = adjMul2(D, C);
+
+        const auto det = sub(fmadd(detA, detD, mul(detB, detC)), hsum(mul(AB, swizzle<0, 2, 1, 3>(DC))));
+
+        // adjugate blocks of the inverse, still to be transposed within each block
+        const auto X = sub(mul(detD, A), mul2(B, DC));
+        const auto Y = sub(mul(detB, C), mulAdj2(D, AB));
+        const auto Z = sub(mul(detC, B), mulAdj2(A, DC));
+        const auto W = sub(mul(detA, D), mul2(C, AB));
+
+        const auto rcp = div(set(static_cast<T>(1), static_cast<T>(-1), static_cast<T>(-1), static_cast<T>(1)), det);
+
+        const auto x = swizzle<3, 1, 2, 0>(mul(X, rcp));
+        const auto y = swizzle<3, 1, 2, 0>(mul(Y, rcp));
+        const auto z = swizzle<3, 1, 2, 0>(mul(Z, rcp));
+        const auto w = swizzle<3, 1, 2, 0>(mul(W, rcp));
+
+        store(out,      lowHalves(x, y));
+        store(out + 4,  highHalves(x, y));
+        store(out + 8,  lowHalves(z, w));
+        store(out + 12, highHalves(z, w));
+
+        return first(det);
+    }
+
+    template <unsigned int DIM>
+    inline __m128 SIMD::lengthSquare4(const float* v, __m128* rows) noexcept {
+        for (unsigned int d = 0; d < DIM; ++d)
+            rows[d] = load(v + d * 4);
+
+        if constexpr (DIM == 3) {
+            const __m128 a = mul(rows[0], rows[0]);
+            const __m128 b = mul(rows[1], rows[1]);
+            const __m128 c = mul(rows[2], rows[2]);
+
+            // x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3 -> x0 x1 x2 x3, y0 y1 y2 y3, z0 z1 z2 z3
+            const __m128 x = shuffle<0, 3, 0, 2>(a, shuffle<2, 2, 1, 1>(b, c));
+            const __m128 y = shuffle<0, 2, 0, 2>(shuffle<1, 1, 0, 0>(a, b), shuffle<3, 3, 2, 2>(b, c));
+            const __m128 z = shuffle<0, 2, 0, 3>(shuffle<2, 2, 1, 1>(a, b), c);
+
+            return add(add(x, y), z);
+        }
+        else if constexpr (DIM == 2)
+            return _mm_hadd_ps(mul(rows[0], rows[0]), mul(rows[1], rows[1]));
+        else {
+            const __m128 p01 = _mm_hadd_ps(mul(rows[0], rows[0]), mul(rows[1], rows[1]));
+            const __m128 p23 = _mm_hadd_ps(mul(rows[2], rows[2]), mul(rows[3], rows[3]));
+
+            return _mm_hadd_ps(p01, p23);
+        }
+    }
+    template <unsigned int DIM>
+    inline void SIMD::scale4(__m128* rows, const __m128& s) noexcept {
+        if constexpr (DIM == 3) {
+            rows[0] = mul(rows[0], swizzle<0, 0, 0, 1>(s));
+            rows[1] = mul(rows[1], swizzle<1, 1, 2, 2>(s));
+            rows[2] = mul(rows[2], swizzle<2, 3, 3, 3>(s));
+        }
+        else if constexpr (DIM == 2) {
+            rows[0] = mul(rows[0], swizzle<0, 0, 1, 1>(s));
+            rows[1] = mul(rows[1], swizzle<2, 2, 3, 3>(s));
+        }
+        else {
+            rows[0] = mul(rows[0], swizzle<0, 0, 0, 0>(s));
+            rows[1] = mul(rows[1], swizzle<1, 1, 1, 1>(s));
+            rows[2] = mul(rows[2], swizzle<2, 2, 2, 2>(s));
+            rows[3] = mul(rows[3], swizzle<3, 3, 3, 3>(s));
+        }
+    }
+#endif
+
+template <typename T>
+inline void SIMD::transform4(const T* m, const T* in, T* out, const std::size_t& count) noexcept {
+    static_assert(has4<T>);
+
+    const auto c0 = set(m[0], m[4], m[8],  m[12]);
+    const auto c1 = set(m[1], m[5], m[9],  m[13]);
+    const auto c2 = set(m[2], m[6], m[10], m[14]);
+    const auto c3 = set(m[3], m[7], m[11], m[15]);
+
+    const auto kernel = [&](const T* v) {
+        auto acc = mul(c0, broadcast(v[0]));
+        acc = fmadd(c1, broadcast(v[1]), acc);
+        acc = fmadd(c2, broadcast(v[2]), acc);
+
+        return fmadd(c3, broadcast(v[3]), acc);
+    };
+
+    // 16 elements (4 cache lines of float, 8 of double) ahead, none past the end
+    constexpr std::size_t PREFETCH = 16;
+
+    const std::size_t last = (count > PREFETCH) ? count - PREFETCH : 0;
+
+    const bool nonTemporal = (count * 4 * sizeof(T) >= STREAM_BYTES) &&
+                             (reinterpret_cast<std::uintptr_t>(out) % (4 * sizeof(T)) == 0);
+
+    // prefetching up to last, then the tail without
+    std::size_t i = 0;
+    if (nonTemporal) {
+        for (; i < last; ++i) {
+            prefetch(in + (i + PREFETCH) * 4);
+
+            stream(out + i * 4, kernel(in + i * 4));
+        }
+        for (; i < count; ++i)
+            stream(out + i * 4, kernel(in + i * 4));
+
+        fence();
+    }
+    else {
+        for (; i < last; ++i) {
+            prefetch(in + (i + PREFETCH) * 4);
+
+            store(out + i * 4, kernel(in + i * 4));
+        }
+        for (; i < count; ++i)
+            store(out + i * 4, kernel(in + i * 4));
+    }
+}
+template <typename T>
+inline void SIMD::transform3(const T* m, const T* in, T* out, const std::size_t& count, const T& w, const bool& project) noexcept {
+    static_assert(has4<T>);
+
+    const auto c0 = set(m[0], m[4], m[8],  m[12]);
+    const auto c1 = set(m[1], m[5], m[9],  m[13]);
+    const auto c2 = set(m[2], m[6], m[10], m[14]);
+    const auto c3 = mul(set(m[3], m[7], m[11], m[15]), broadcast(w));
+
+    const auto kernel = [&](const T* v) {
+        auto acc = fmadd(c0, broadcast(v[0]), c3);
+        acc = fmadd(c1, broadcast(v[1]), acc);
+
+        return fmadd(c2, broadcast(v[2]), acc);
+    };
+
+    constexpr std::size_t PREFETCH = 16;
+
+    const std::size_t last = (count > PREFETCH) ? count - PREFETCH : 0;
+
+    const bool nonTemporal = (count * 3 * sizeof(T) >= STREAM_BYTES);
+
+    const auto element = [&](const std::size_t& i) {
+        const auto r = kernel(in + i * 3);
+
+        return project ? div(r, broadcastW(r)) : r;
+    };
+
+    std::size_t i = 0;
+    if (nonTemporal) {
+        // four elements fill three registers: single elements up to the first register aligned one
+        for (; (i < count) && (reinterpret_cast<std::uintptr_t>(out + i * 3) % (4 * sizeof(T)) != 0); ++i)
+            store3(out + i * 3, element(i));
+
+        for (; i + 4 <= count; i += 4) {
+            // 6 lanes apart: at most 48 bytes between prefetches, so no cache line is skipped
+            if (i < last) {
+                prefetch(in + (i + PREFETCH) * 3);
+                prefetch(in + (i + PREFETCH) * 3 + 6);
+            }
+
+            const auto r0 = element(i);
+            const auto r1 = element(i + 1);
+            const auto r2 = element(i + 2);
+            const auto r3 = element(i + 3);
+
+            stream3(out + i * 3, r0, r1, r2, r3);
+        }
+    }
+    else {
+        for (; i < last; ++i) {
+            prefetch(in + (i + PREFETCH) * 3);
+
+            store3(out + i * 3, element(i));
+        }
+    }
+
+    for (; i < count; ++i)
+        store3(out + i * 3, element(i));
+
+    if (nonTemporal)
+        fence();
+}
+
+template <typename T, typename F, typename... A>
+inline void SIMD::blocks(const std::size_t& count, const F& f, A*... arrays) noexcept { blocks<T>(count, f, std::index_sequence_for<A...>{ }, arrays...); }
+template <typename T, typename F, std::size_t... I, typename... A>
+inline void SIMD::blocks(const std::size_t& count, const F& f, std::index_sequence<I...>, A*... arrays) noexcept {
+    static_assert(((isTriviallyCopyable<A> && (sizeof(A) % sizeof(T) == 0)) && ...));
+
+    constexpr std::size_t TOTAL = (LANES<T, A> + ...);
+    static_assert(TOTAL > 0);
+
+    // about 2048 lanes a pass, in whole groups of 8 objects: a kernel's groups of 4 / 8 fall as they would over the whole array
+    constexpr std::size_t BLOCK = (TOTAL > 256) ? 8 : 2048 / TOTAL / 8 * 8;
+
+    // where the lanes of every array start, in units of BLOCK lanes
+    constexpr std::size_t WIDTH[] = { LANES<T, A>... };
+    constexpr auto start = [](const std::size_t& k) {
+        std::size_t sum = 0;
+        for (std::size_t j = 0; j < k; ++j)
+            sum += WIDTH[j];
+
+        return sum;
+    };
+    constexpr std::size_t START[] = { start(I)... };
+
+    alignas(64) T buffer[BLOCK * TOTAL];
+
+    bool streamed = false;
+    for (std::size_t i = 0; i < count; i += BLOCK) {
+        const std::size_t n = (count - i < BLOCK) ? count - i : BLOCK;
+
+        (copyIn(arrays + i, buffer + START[I] * BLOCK, n), ...);
+        f(view(arrays + i, buffer + START[I] * BLOCK)..., n);
+        streamed |= (copyOut(arrays + i, buffer + START[I] * BLOCK, n, count) | ...);
+    }
+
+    if (streamed)
+        fence();
+}
+template <typename T, typename A>
+inline void SIMD::copyIn(const A* src, T* lanes, const std::size_t& n) noexcept {
+    if constexpr (LANES<T, A> != 0)
+        std::memcpy(lanes, src, n * sizeof(A));
+}
+template <typename T, typename A>
+inline const T* SIMD::view(const A* array, T* lanes) noexcept {
+    if constexpr (LANES<T, A> == 0)
+        return array;
+    else
+        return lanes;
+}
+template <typename T, typename A>
+inline T* SIMD::view(A* array, T* lanes) noexcept {
+    if constexpr (LANES<T, A> == 0)
+        return array;
+    else
+        return lanes;
+}
+template <typename T, typename A>
+inline bool SIMD::copyOut(A* dst, const T* lanes, const std::size_t& n, const std::size_t& count) noexcept {
+    if constexpr (LANES<T, A> == 0)
+        return false;
+    else {
+        // void*: A is trivially copyable, -Wclass-memaccess only sees its default member initializers
+        if (count * sizeof(A) < STREAM_BYTES) {
+            std::memcpy(static_cast<void*>(dst), lanes, n * sizeof(A));
+
+            return false;
+        }
+
+        streamCopy(dst, lanes, n * sizeof(A));
+
+        return true;
+    }
+}
+inline void SIMD::streamCopy(void* dst, const void* src, const std::size_t& bytes) noexcept {
+    #if defined(MATH_SIMD_SSE)
+        unsigned char* d = static_cast<unsigned char*>(dst);
+        const unsigned char* s = static_cast<const unsigned char*>(src);
+
+        // plain copies up to the first 16 byte boundary of dst and after the last one
+        std::size_t i = (16 - reinterpret_cast<std::uintptr_t>(d) % 16) % 16;
+        if (i > bytes)
+            i = bytes;
+
+        std::memcpy(d, s, i);
+
+        for (; i + 16 <= bytes; i += 16)
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d + i), _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i)));
+
+        std::memcpy(d + i, s + i, bytes - i);
+    #else
+        std::memcpy(dst, src, bytes);
+    #endif
+}
+
+template <typename T>
+inline void SIMD::gemm(const std::size_t& kc, const T* a, const T* b, T* c, const std::size_t& ldc) noexcept {
+    constexpr unsigned int MR = GEMM_MR<T>;
+    constexpr unsigned int NR = GEMM_NR<T>;
+
+    static_assert(MR == 6);
+
+    // twelve named accumulators (six rows of two registers), an array would be kept in memory
+
+    // float with AVX: 8 lanes per register
+    #if defined(MATH_SIMD_AVX)
+        if constexpr (isSame<T, float>) {
+            const auto step = [](const float* ar, const __m256& b0, const __m256& b1, __m256& lo, __m256& hi) {
+                const __m256 r = _mm256_broadcast_ss(ar);
+
+                #if defined(MATH_SIMD_FMA)
+                    lo = _mm256_fmadd_ps(r, b0, lo);
+                    hi = _mm256_fmadd_ps(r, b1, hi);
+                #else
+                    lo = _mm256_add_ps(_mm256_mul_ps(r, b0), lo);
+                    hi = _mm256_add_ps(_mm256_mul_ps(r, b1), hi);
+                #endif
+            };
+            const auto flush = [](float* row, const __m256& lo, const __m256& hi) {
+                _mm256_storeu_ps(row,     _mm256_add_ps(_mm256_loadu_ps(row),     lo));
+                _mm256_storeu_ps(row + 8, _mm256_add_ps(_mm256_loadu_ps(row + 8), hi));
+            };
+
+            __m256 c00 = _mm256_setzero_ps(), c01 = c00, c10 = c00, c11 = c00, c20 = c00, c21 = c00;
+            __m256 c30 = c00, c31 = c00, c40 = c00, c41 = c00, c50 = c00, c51 = c00;
+
+            for (std::size_t k = 0; k < kc; ++k, a += MR, b += NR) {
+                const __m256 b0 = _mm256_loadu_ps(b);
+                const __m256 b1 = _mm256_loadu_ps(b + 8);
+
+                step(a,     b0, b1, c00, c01);
+                step(a + 1, b0, b1, c10, c11);
+                step(a + 2, b0, b1, c20, c21);
+                step(a + 3, b0, b1, c30, c31);
+                step(a + 4, b0, b1, c40, c41);
+                step(a + 5, b0, b1, c50, c51);
+            }
+
+            flush(c,           c00, c01);
+            flush(c + ldc,     c10, c11);
+            flush(c + 2 * ldc, c20, c21);
+            flush(c + 3 * ldc, c30, c31);
+            flush(c + 4 * ldc, c40, c41);
+            flush(c + 5 * ldc, c50, c51);
+
+            return;
+        }
+    #endif
+
+    if constexpr (has4<T>) {
+        using V = decltype(load(a));
+
+        const auto step = [](const T* ar, const V& b0, const V& b1, V& lo, V& hi) {
+            const V r = broadcast(*ar);
+
+            lo = fmadd(r, b0, lo);
+            hi = fmadd(r, b1, hi);
+        };
+        const auto flush = [](T* row, const V& lo, const V& hi) {
+            store(row,     add(load(row),     lo));
+            store(row + 4, add(load(row + 4), hi));
+        };
+
+        V c00 = broadcast(static_cast<T>(0)), c01 = c00, c10 = c00, c11 = c00, c20 = c00, c21 = c00;
+        V c30 = c00, c31 = c00, c40 = c00, c41 = c00, c50 = c00, c51 = c00;
+
+        for (std::size_t k = 0; k < kc; ++k, a += MR, b += NR) {
+            const V b0 = load(b);
+            const V b1 = load(b + 4);
+
+            step(a,     b0, b1, c00, c01);
+            step(a + 1, b0, b1, c10, c11);
+            step(a + 2, b0, b1, c20, c21);
+            step(a + 3, b0, b1, c30, c31);
+            step(a + 4, b0, b1, c40, c41);
+            step(a + 5, b0, b1, c50, c51);
+        }
+
+        flush(c,           c00, c01);
+        flush(c + ldc,     c10, c11);
+        flush(c + 2 * ldc, c20, c21);
+        flush(c + 3 * ldc, c30, c31);
+        flush(c + 4 * ldc, c40, c41);
+        flush(c + 5 * ldc, c50, c51);
+    }
+    else {
+        T acc[MR][NR]{ };
+
+        for (std::size_t k = 0; k < kc; ++k, a += MR, b += NR) {
+            for (unsigned int r = 0; r < MR; ++r) {
+                for (unsigned int j = 0; j < NR; ++j)
+                    acc[r][j] += a[r] * b[j];
+            }
+        }
+
+        for (unsigned int r = 0; r < MR; ++r) {
+            for (unsigned int j = 0; j < NR; ++j)
+                c[r * ldc + j] += acc[r][j];
+        }
+    }
+}
+
+template <unsigned int W, typename T>
+inline auto SIMD::gather(const T* p, const std::size_t& stride) noexcept {
+    if constexpr (W == 1)
+        return *p;
+    else
+        return set(p[0], p[stride], p[2 * stride], p[3 * stride]);
+}
+template <unsigned int W, typename T>
+inline auto SIMD::splat(const T& val) noexcept {
+    if constexpr (W == 1)
+        return val;
+    else
+        return broadcast(val);
+}
+template <unsigned int W, typename T, typename V>
+inline void SIMD::scatter(const V& v, T* p, const std::size_t& stride) noexcept {
+    if constexpr (W == 1)
+        *p = v;
+    else {
+        T lanes[W];
+        store(lanes, v);
+
+        for (unsigned int s = 0; s < W; ++s)
+            p[s * stride] = lanes[s];
+    }
+}
+
+template <unsigned int N, typename T>
+inline std::size_t SIMD::solveLU(const T* a, const T* b, T* x, const std::size_t& count) noexcept { return solve<N, false>(a, b, x, count); }
+template <unsigned int N, typename T>
+inline std::size_t SIMD::solveCholesky(const T* a, const T* b, T* x, const std::size_t& count) noexcept { return solve<N, true>(a, b, x, count); }
+
+template <unsigned int N, bool SPD, typename T>
+inline std::size_t SIMD::solve(const T* a, const T* b, T* x, const std::size_t& count) noexcept {
+    static_assert(isFloat<T> && N >= 2 && N <= 4);
+
+    constexpr unsigned int W = has4<T> ? 4 : 1;
+
+    using V = decltype(splat<W>(T{ }));
+
+    // dependent, so Math only has to be complete where solve is instantiated
+    using M = IF<isFloat<T>, Math, void>;
+
+    const V eps = splat<W>(M::template EPSILON<T>);
+
+    std::size_t failed = 0;
+    for (std::size_t i = 0; i < count; i += W) {
+        const std::size_t lanes = (count - i < W) ? count - i : W;
+
+        const T* pa = a + i * N * N;
+        const T* pb = b + i * N;
+
+        // a partial block is padded with identity systems
+        T padA[W * N * N];
+        T padB[W * N];
+        if (lanes < W) {
+            for (std::size_t s = 0; s < W; ++s) {
+                for (unsigned int j = 0; j < N * N; ++j)
+                    padA[s * N * N + j] = (s < lanes) ? pa[s * N * N + j] : static_cast<T>((j % (N + 1) == 0) ? 1 : 0);
+                for (unsigned int j = 0; j < N; ++j)
+                    padB[s * N + j] = (s < lanes) ? pb[s * N + j] : static_cast<T>(0);
+            }
+
+            pa = padA;
+            pb = padB;
+        }
+
+        V A[N][N];
+        V B[N];
+        for (unsigned int row = 0; row < N; ++row) {
+            for (unsigned int col = 0; col < N; ++col)
+                A[row][col] = gather<W>(pa + row * N + col, N * N);
+
+            B[row] = gather<W>(pb + row, N);
+        }
+
+        V X[N];
+        int bad = 0;
+        if constexpr (SPD)
+            bad = maskBits(cholesky<N>(A, B, X, eps));
+        else
+            bad = maskBits(eliminate<N>(A, B, X, eps));
+
+        T out[N][W];
+        for (unsigned int row = 0; row < N; ++row) {
+            if constexpr (W == 1)
+                out[row][0] = X[row];
+            else
+                store(out[row], X[row]);
+        }
+
+        for (std::size_t s = 0; s < lanes; ++s) {
+            for (unsigned int row = 0; row < N; ++row)
+                x[(i + s) * N + row] = out[row][s];
+
+            failed += (bad >> s) & 1;
+        }
+    }
+
+    return failed;
+}
+template <unsigned int N, typename V>
+inline auto SIMD::eliminate(V (&a)[N][N], V (&b)[N], V (&x)[N], const V& eps) noexcept {
+    // every lane of eps is the same positive value
+    const V zero = sub(eps, eps);
+    const V one  = div(eps, eps);
+
+    // pivots below eps times the largest magnitude of the matrix count as zero
+    V scale = zero;
+    for (unsigned int row = 0; row < N; ++row) {
+        for (unsigned int col = 0; col < N; ++col)
+            scale = select(greater(abs(a[row][col]), scale), abs(a[row][col]), scale);
+    }
+    scale = mul(scale, eps);
+
+    auto bad = greater(zero, zero);
+
+    V inv[N];
+    for (unsigned int k = 0; k < N; ++k) {
+        // partial pivoting: the row with the largest |a[row][k]| ends up in row k
+        if constexpr (isFloat<V>) {
+            // one system, one swap (a select per row would branch on every compare)
+            unsigned int pivot = k;
+            for (unsigned int row = k + 1; row < N; ++row)
+                pivot = (abs(a[row][k]) > abs(a[pivot][k])) ? row : pivot;
+
+            if (pivot != k) {
+                for (unsigned int col = k; col < N; ++col) {
+                    const V top = a[k][col];
+
+                    a[k][col]     = a[pivot][col];
+                    a[pivot][col] = top;
+                }
+
+                const V top = b[k];
+
+                b[k]     = b[pivot];
+                b[pivot] = top;
+            }
+        }
+        else {
+            // per lane, swapped in with selects
+            for (unsigned int row = k + 1; row < N; ++row) {
+                const auto swap = greater(abs(a[row][k]), abs(a[k][k]));
+
+                for (unsigned int col = k; col < N; ++col) {
+                    const V top = a[k][col];
+
+                    a[k][col]   = select(swap, a[row][col], top);
+                    a[row][col] = select(swap, top, a[row][col]);
+                }
+
+                const V top = b[k];
+
+                b[k]   = select(swap, b[row], top);
+                b[row] = select(swap, top, b[row]);
+            }
+        }
+
+        bad    = maskOr(bad, lessEqual(abs(a[k][k]), scale));
+        inv[k] = div(one, a[k][k]);
+
+        for (unsigned int row = k + 1; row < N; ++row) {
+            const V f = mul(a[row][k], inv[k]);
+
+            for (unsigned int col = k + 1; col < N; ++col)
+                a[row][col] = sub(a[row][col], mul(f, a[k][col]));
+
+            b[row] = sub(b[row], mul(f, b[k]));
+        }
+    }
+
+    for (unsigned int k = N; k-- > 0;) {
+        V sum = b[k];
+        for (unsigned int col = k + 1; col < N; ++col)
+            sum = sub(sum, mul(a[k][col], x[col]));
+
+        x[k] = mul(sum, inv[k]);
+    }
+
+    for (unsigned int row = 0; row < N; ++row)
+        x[row] = select(bad, zero, x[row]);
+
+    return bad;
+}
+template <unsigned int N, typename V>
+inline auto SIMD::cholesky(const V (&a)[N][N], const V (&b)[N], V (&x)[N], const V& eps) noexcept {
+    const V zero = sub(eps, eps);
+    const V one  = div(eps, eps);
+
+    auto bad = greater(zero, zero);
+
+    // a = l * transpose(l), l lower triangular
+    V l[N][N];
+    V inv[N];
+    for (unsigned int j = 0; j < N; ++j) {
+        V d = a[j][j];
+        for (unsigned int k = 0; k < j; ++k)
+            d = sub(d, mul(l[j][k], l[j][k]));
+
+        // the remaining pivot must stay positive against the diagonal it started from
+        bad     = maskOr(bad, lessEqual(d, mul(eps, abs(a[j][j]))));
+        l[j][j] = sqrt(d);
+        inv[j]  = div(one, l[j][j]);
+
+        for (unsigned int row = j + 1; row < N; ++row) {
+            V sum = a[row][j];
+            for (unsigned int k = 0; k < j; ++k)
+                sum = sub(sum, mul(l[row][k], l[j][k]));
+
+            l[row][j] = mul(sum, inv[j]);
+        }
+    }
+
+    // l * y = b, then transpose(l) * x = y
+    V y[N];
+    for (unsigned int row = 0; row < N; ++row) {
+        V sum = b[row];
+        for (unsigned int k = 0; k < row; ++k)
+            sum = sub(sum, mul(l[row][k], y[k]));
+
+        y[row] = mul(sum, inv[row]);
+    }
+    for (unsigned int row = N; row-- > 0;) {
+        V sum = y[row];
+        for (unsigned int k = row + 1; k < N; ++k)
+            sum = sub(sum, mul(l[k][row], x[k]));
+
+        x[row] = mul(sum, inv[row]);
+    }
+
+    for (unsigned int row = 0; row < N; ++row)
+        x[row] = select(bad, zero, x[row]);
+
+    return bad;
+}
+
+template <typename T>
+inline void SIMD::eigen3(const T* m, T* values, T* vectors, const std::size_t& count) noexcept {
+    static_assert(isFloat<T>);
+
+    constexpr unsigned int W = has4<T> ? 4 : 1;
+
+    // independent blocks per call hide the sqrt / div latency of the rotation chain
+    constexpr unsigned int G = has4<T> ? 2 : 4;
+
+    const std::size_t pairs = count - count % (W * G);
+    const std::size_t full  = count - count % W;
+
+    for (std::size_t i = 0; i < pairs; i += W * G)
+        eigen3<W, G>(m + i * 9, values + i * 3, vectors + i * 9);
+    for (std::size_t i = pairs; i < full; i += W)
+        eigen3<W, 1>(m + i * 9, values + i * 3, vectors + i * 9);
+    for (std::size_t i = full; i < count; ++i)
+        eigen3<1, 1>(m + i * 9, values + i * 3, vectors + i * 9);
+}
+template <unsigned int W, unsigned int G, typename T>
+inline void SIMD::eigen3(const T* m, T* values, T* vectors) noexcept {
+    using V = decltype(splat<W>(T{ }));
+
+    const V zero = splat<W>(static_cast<T>(0));
+    const V one  = splat<W>(static_cast<T>(1));
+
+    V a[G][6];
+    V v[G][3][3];
+
+    for (unsigned int g = 0; g < G; ++g) {
+        const T* block = m + g * W * 9;
+
+        // the upper triangle is read
+        a[g][0] = gather<W>(block,     9);
+        a[g][1] = gather<W>(block + 4, 9);
+        a[g][2] = gather<W>(block + 8, 9);
+        a[g][3] = gather<W>(block + 1, 9);
+        a[g][4] = gather<W>(block + 2, 9);
+        a[g][5] = gather<W>(block + 5, 9);
+
+        for (unsigned int row = 0; row < 3; ++row)
+            for (unsigned int col = 0; col < 3; ++col)
+                v[g][row][col] = (row == col) ? one : zero;
+    }
+
+    jacobi3<W, G, T>(a, v);
+
+    for (unsigned int g = 0; g < G; ++g) {
+        for (unsigned int row = 0; row < 3; ++row) {
+            scatter<W>(a[g][row], values + g * W * 3 + row, 3);
+
+            for (unsigned int col = 0; col < 3; ++col)
+                scatter<W>(v[g][row][col], vectors + g * W * 9 + row * 3 + col, 9);
+        }
+    }
+}
+template <typename T>
+inline void SIMD::quatNlerp(const T* a, const T* b, const T& t, T* out, const std::size_t& count) noexcept {
+    static_assert(isFloat<T>);
+
+    constexpr unsigned int W = has4<T> ? 4 : 1;
+
+    const std::size_t full = count - count % W;
+
+    for (std::size_t i = 0; i < full; i += W)
+        quatNlerp<W>(a + i * 4, b + i * 4, t, out + i * 4);
+    for (std::size_t i = full; i < count; ++i)
+        quatNlerp<1>(a + i * 4, b + i * 4, t, out + i * 4);
+}
+template <typename T>
+inline void SIMD::quatSlerp(const T* a, const T* b, const T& t, T* out, const std::size_t& count) noexcept {
+    static_assert(isFloat<T>);
+
+    constexpr unsigned int W = has4<T> ? 4 : 1;
+    constexpr std::size_t CHUNK = 64;
+
+    // dependent, so Math only has to be complete where quatSlerp is instantiated
+    using M = IF<isFloat<T>, Math, void>;
+
+    constexpr T one = static_cast<T>(1);
+    constexpr T limit = one - M::template EPSILON<T> * 10;
+
+    T dot[CHUNK], cosine[CHUNK], sine[CHUNK], theta[CHUNK];
+    T angle[2 * CHUNK], weight[2 * CHUNK];
+
+    for (std::size_t i = 0; i < count; i += CHUNK) {
+        const std::size_t n = (count - i < CHUNK) ? count - i : CHUNK;
+        const std::size_t full = n - n % W;
+
+        const T* pa = a + i * 4;
+        const T* pb = b + i * 4;
+        T* po = out + i * 4;
+
+        for (std::size_t k = 0; k < full; k += W)
+            quatDot<W>(pa + k * 4, pb + k * 4, dot + k);
+        for (std::size_t k = full; k < n; ++k)
+            quatDot<1>(pa + k * 4, pb + k * 4, dot + k);
+
+        // acos(c) = atan2(sin, c), sin = sqrt((1 - c) (1 + c)) keeps its bits near c = 1
+        for (std::size_t k = 0; k < n; ++k) {
+            cosine[k] = std::abs(dot[k]);
+            sine[k] = std::sqrt((one - cosine[k]) * (one + cosine[k]));
+        }
+        M::atan2(sine, cosine, theta, n);
+
+        for (std::size_t k = 0; k < n; ++k) {
+            angle[k]     = (one - t) * theta[k];
+            angle[n + k] = t * theta[k];
+        }
+        M::sin(angle, weight, 2 * n);
+
+        // nearly parallel: the nlerp weights, normalized after the blend
+        bool parallel = false;
+        for (std::size_t k = 0; k < n; ++k) {
+            const T sign = (dot[k] < 0) ? -one : one;
+
+            if (cosine[k] > limit) {
+                weight[k]     = one - t;
+                weight[n + k] = t * sign;
+                parallel = true;
+            }
+            else {
+                weight[k]     = weight[k] / sine[k];
+                weight[n + k] = weight[n + k] / sine[k] * sign;
+            }
+        }
+
+        for (std::size_t k = 0; k < full; k += W)
+            quatBlend<W>(pa + k * 4, pb + k * 4, weight + k, weight + n + k, po + k * 4);
+        for (std::size_t k = full; k < n; ++k)
+            quatBlend<1>(pa + k * 4, pb + k * 4, weight + k, weight + n + k, po + k * 4);
+
+        if (!parallel)
+            continue;
+
+        for (std::size_t k = 0; k < n; ++k) {
+            if (!(cosine[k] > limit))
+                continue;
+
+            T* q = po + k * 4;
+            const T scale = one / std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+
+            for (unsigned int c = 0; c < 4; ++c)
+                q[c] *= scale;
+        }
+    }
+}
+template <typename T>
+inline void SIMD::quatToMat4(const T* q, T* out, const std::size_t& count) noexcept {
+    static_assert(isFloat<T>);
+
+    constexpr unsigned int W = has4<T> ? 4 : 1;
+
+    const std::size_t full = count - count % W;
+
+    for (std::size_t i = 0; i < full; i += W)
+        quatToMat4<W>(q + i * 4, out + i * 16);
+    for (std::size_t i = full; i < count; ++i)
+        quatToMat4<1>(q + i * 4, out + i * 16);
+}
+template <unsigned int W, typename T, typename V>
+inline void SIMD::loadRows(const T* p, const std::size_t& stride, V (&columns)[4]) noexcept {
+    if constexpr (W == 1) {
+        for (unsigned int c = 0; c < 4; ++c)
+            columns[c] = p[c];
+    }
+    else {
+        for (unsigned int s = 0; s < 4; ++s)
+            columns[s] = load(p + s * stride);
+
+        transpose4(columns[0], columns[1], columns[2], columns[3]);
+    }
+}
+template <unsigned int W, typename T, typename V>
+inline void SIMD::storeRows(V (&columns)[4], T* p, const std::size_t& stride) noexcept {
+    if constexpr (W == 1) {
+        for (unsigned int c = 0; c < 4; ++c)
+            p[c] = columns[c];
+    }
+    else {
+        transpose4(columns[0], columns[1], columns[2], columns[3]);
+
+        for (unsigned int s = 0; s < 4; ++s)
+            store(p + s * stride, columns[s]);
+    }
+}
+// the scalar Quat formulas, term for term
+template <unsigned int W, typename T>
+inline void SIMD::quatNlerp(const T* a, const T* b, const T& t, T* out) noexcept {
+    using V = decltype(splat<W>(T{ }));
+
+    V p[4], q[4];
+    loadRows<W>(a, 4, p);
+    loadRows<W>(b, 4, q);
+
+    const V d = add(add(add(mul(p[0], q[0]), mul(p[1], q[1])), mul(p[2], q[2])), mul(p[3], q[3]));
+
+    const V wa = splat<W>(static_cast<T>(1) - t);
+    const V wb = select(greater(splat<W>(static_cast<T>(0)), d), splat<W>(-t), splat<W>(t));
+
+    V r[4];
+    for (unsigned int c = 0; c < 4; ++c)
+        r[c] = add(mul(p[c], wa), mul(q[c], wb));
+
+    const V scale = div(splat<W>(static_cast<T>(1)), sqrt(add(add(add(mul(r[0], r[0]), mul(r[1], r[1])), mul(r[2], r[2])), mul(r[3], r[3]))));
+
+    for (unsigned int c = 0; c < 4; ++c)
+        r[c] = mul(r[c], scale);
+
+    storeRows<W>(r, out, 4);
+}
+template <unsigned int W, typename T>
+inline void SIMD::quatDot(const T* a, const T* b, T* dot) noexcept {
+    using V = decltype(splat<W>(T{ }));
+
+    V p[4], q[4];
+    loadRows<W>(a, 4, p);
+    loadRows<W>(b, 4, q);
+
+    scatter<W>(add(add(add(mul(p[0], q[0]), mul(p[1], q[1])), mul(p[2], q[2])), mul(p[3], q[3])), dot, 1);
+}
+template <unsigned int W, typename T>
+inline void SIMD::quatBlend(const T* a, const T* b, const T* wa, const T* wb, T* out) noexcept {
+    using V = decltype(splat<W>(T{ }));
+
+    V p[4], q[4];
+    loadRows<W>(a, 4, p);
+    loadRows<W>(b, 4, q);
+
+    const V u = gather<W>(wa, 1);
+    const V v = gather<W>(wb, 1);
+
+    V r[4];
+    for (unsigned int c = 0; c < 4; ++c)
+        r[c] = add(mul(p[c], u), mul(q[c], v));
+
+    storeRows<W>(r, out, 4);
+}
+template <unsigned int W, typename T>
+inline void SIMD::quatToMat4(const T* q, T* out) noexcept {
+    using V = decltype(splat<W>(T{ }));
+
+    V p[4];
+    loadRows<W>(q, 4, p);
+
+    const V zero = splat<W>(static_cast<T>(0));
+    const V one  = splat<W>(static_cast<T>(1));
+    const V two  = splat<W>(static_cast<T>(2));
+
+    const V xx = mul(p[0], p[0]), yy = mul(p[1], p[1]), zz = mul(p[2], p[2]);
+    const V xy = mul(p[0], p[1]), xz = mul(p[0], p[2]), yz = mul(p[1], p[2]);
+    const V wx = mul(p[3], p[0]), wy = mul(p[3], p[1]), wz = mul(p[3], p[2]);
+
+    V r0[4] = { sub(one, mul(two, add(yy, zz))), mul(two, sub(xy, wz)), mul(two, add(xz, wy)), zero };
+    V r1[4] = { mul(two, add(xy, wz)), sub(one, mul(two, add(xx, zz))), mul(two, sub(yz, wx)), zero };
+    V r2[4] = { mul(two, sub(xz, wy)), mul(two, add(yz, wx)), sub(one, mul(two, add(xx, yy))), zero };
+    V r3[4] = { zero, zero, zero, one };
+
+    storeRows<W>(r0, out,      16);
+    storeRows<W>(r1, out + 4,  16);
+    storeRows<W>(r2, out + 8,  16);
+    storeRows<W>(r3, out + 12, 16);
+}
+template <typename T>
+inline unsigned long long SIMD::escapeN(const T* zr, const T* zi, const T* cr, const T* ci, unsigned int* counts, const std::size_t& n, const unsigned int& limit) noexcept {
+    static_assert(isFloat<T>);
+
+    constexpr unsigned int W = has4<T> ? 4 : 1;
+    constexpr unsigned int G = ESCAPE_GROUP<T>;
+
+    const std::size_t groups = n - n % (W * G);
+    unsigned long long total = 0;
+
+    for (std::size_t i = 0; i < groups; i += W * G)
+        total += escape<W, G>(zr + i, zi + i, cr + i, ci + i, counts + i, limit);
+    for (std::size_t i = groups; i < n; ++i)
+        total += escape<1, 1>(zr + i, zi + i, cr + i, ci + i, counts + i, limit);
+
+    return total;
+}
+template <unsigned int W, unsigned int G, typename T>
+inline unsigned long long SIMD::escape(const T* zr, const T* zi, const T* cr, const T* ci, unsigned int* counts, const unsigned int& limit) noexcept {
+    using V = decltype(splat<W>(T{ }));
+
+    const V zero  = splat<W>(static_cast<T>(0));
+    const V one   = splat<W>(static_cast<T>(1));
+    const V bound = splat<W>(static_cast<T>(4));
+
+    V x[G], y[G], a[G], b[G], n[G];
+    decltype(lessEqual(zero, zero)) live[G];
+
+    for (unsigned int g = 0; g < G; ++g) {
+        x[g] = gather<W>(zr + g * W, 1);
+        y[g] = gather<W>(zi + g * W, 1);
+        a[g] = gather<W>(cr + g * W, 1);
+        b[g] = gather<W>(ci + g * W, 1);
+        n[g] = zero;
+
+        live[g] = lessEqual(zero, zero);
+    }
+
+    // a lane that left keeps iterating (to inf / NaN) but stays out of live, the group stops with its last lane
+    for (unsigned int it = 0; it < limit; ++it) {
+        decltype(lessEqual(zero, zero)) any = lessEqual(one, zero);
+
+        for (unsigned int g = 0; g < G; ++g) {
+            const V xx = mul(x[g], x[g]);
+            const V yy = mul(y[g], y[g]);
+
+            live[g] = maskAnd(live[g], lessEqual(add(xx, yy), bound));
+            n[g] = add(n[g], select(live[g], one, zero));
+
+            y[g] = add(mul(add(x[g], x[g]), y[g]), b[g]);
+            x[g] = add(sub(xx, yy), a[g]);
+
+            any = maskOr(any, live[g]);
+        }
+
+        if (maskBits(any) == 0)
+            break;
+    }
+
+    unsigned long long total = 0;
+
+    for (unsigned int g = 0; g < G; ++g) {
+        T lanes[W];
+        scatter<W>(n[g], lanes, 1);
+
+        for (unsigned int s = 0; s < W; ++s) {
+            counts[g * W + s] = static_cast<unsigned int>(lanes[s]);
+            total += counts[g * W + s];
+        }
+    }
+
+    return total;
+}
+template <unsigned int W, unsigned int G, typename T, typename V>
+inline void SIMD::jacobi3(V (&a)[G][6], V (&v)[G][3][3]) noexcept {
+    const V zero = splat<W>(static_cast<T>(0));
+    const V one  = splat<W>(static_cast<T>(1));
+    // keeps 0 / 0 out of an already diagonal pair
+    const V tiny = splat<W>(static_cast<T>(isSame<T, float> ? 1.0E-30 : 1.0E-300));
+    const V eps  = splat<W>(static_cast<T>(isSame<T, float> ? 1.0E-08 : 1.0E-17));
+
+    // zeroes apq: a' = J^T a J with J the (p, q) plane rotation, r is the third axis
+    const auto rotate = [&](V& app, V& aqq, V& apq, V& arp, V& arq, V (&vp)[3], V (&vq)[3]) {
+        // a converged apq is dropped instead of squared, its products would go denormal
+        apq = select(lessEqual(abs(apq), mul(eps, add(abs(app), abs(aqq)))), zero, apq);
+
+        // t = tan(angle), the smaller root: 2 apq sign(tau) / (|tau| + sqrt(tau^2 + 4 apq^2))
+        const V tau = sub(aqq, app);
+        const V two = add(apq, apq);
+        const V num = select(greater(zero, tau), sub(zero, two), two);
+        const V den = add(add(abs(tau), sqrt(add(mul(tau, tau), mul(two, two)))), tiny);
+
+        const V t = div(num, den);
+        const V c = div(one, sqrt(add(one, mul(t, t))));
+        const V s = mul(t, c);
+
+        app = sub(app, mul(t, apq));
+        aqq = add(aqq, mul(t, apq));
+        apq = zero;
+
+        const V rp = arp;
+        arp = sub(mul(c, rp), mul(s, arq));
+        arq = add(mul(s, rp), mul(c, arq));
+
+        for (unsigned int i = 0; i < 3; ++i) {
+            const V p = vp[i];
+
+            vp[i] = sub(mul(c, p), mul(s, vq[i]));
+            vq[i] = add(mul(s, p), mul(c, vq[i]));
+        }
+    };
+
+    for (unsigned int sweep = 0; sweep < JACOBI_SWEEPS<T>; ++sweep) {
+        for (unsigned int g = 0; g < G; ++g)
+            rotate(a[g][0], a[g][1], a[g][3], a[g][4], a[g][5], v[g][0], v[g][1]);
+        for (unsigned int g = 0; g < G; ++g)
+            rotate(a[g][0], a[g][2], a[g][4], a[g][3], a[g][5], v[g][0], v[g][2]);
+        for (unsigned int g = 0; g < G; ++g)
+            rotate(a[g][1], a[g][2], a[g][5], a[g][3], a[g][4], v[g][1], v[g][2]);
+    }
+
+    // descending, the vectors follow their values
+    const auto order = [&](V (&e)[6], V (&u)[3][3], const unsigned int& i, const unsigned int& j) {
+        const auto swap = greater(e[j], e[i]);
+
+        const V hi = select(swap, e[j], e[i]);
+        e[j] = select(swap, e[i], e[j]);
+        e[i] = hi;
+
+        for (unsigned int k = 0; k < 3; ++k) {
+            const V first = select(swap, u[j][k], u[i][k]);
+            u[j][k] = select(swap, u[i][k], u[j][k]);
+            u[i][k] = first;
+        }
+    };
+
+    for (unsigned int g = 0; g < G; ++g) {
+        order(a[g], v[g], 0, 1);
+        order(a[g], v[g], 1, 2);
+        order(a[g], v[g], 0, 1);
+    }
+}
+
+template <typename T>
+inline void SIMD::complexMulN(const T* ar, const T* ai, const T* br, const T* bi, T* outR, T* outI, const std::size_t& n) noexcept {
+    complexN([](const auto& xr, const auto& xi, const auto& yr, const auto& yi, auto& r, auto& i) {
+        r = sub(mul(xr, yr), mul(xi, yi));
+        i = add(mul(xr, yi), mul(xi, yr));
+    }, ar, ai, br, bi, outR, outI, n);
+}
+template <typename T>
+inline void SIMD::complexMulN(const T* a, const T* b, T* out, const std::size_t& n) noexcept {
+    complexN([](const auto& xr, const auto& xi, const auto& yr, const auto& yi, auto& r, auto& i) {
+        r = sub(mul(xr, yr), mul(xi, yi));
+        i = add(mul(xr, yi), mul(xi, yr));
+    }, a, b, out, n);
+}
+template <typename T>
+inline void SIMD::complexConjMulN(const T* ar, const T* ai, const T* br, const T* bi, T* outR, T* outI, const std::size_t& n) noexcept {
+    complexN([](const auto& xr, const auto& xi, const auto& yr, const auto& yi, auto& r, auto& i) {
+        r = add(mul(xr, yr), mul(xi, yi));
+        i = sub(mul(xi, yr), mul(xr, yi));
+    }, ar, ai, br, bi, outR, outI, n);
+}
+template <typename T>
+inline void SIMD::complexConjMulN(const T* a, const T* b, T* out, const std::size_t& n) noexcept {
+    complexN([](const auto& xr, const auto& xi, const auto& yr, const auto& yi, auto& r, auto& i) {
+        r = add(mul(xr, yr), mul(xi, yi));
+        i = sub(mul(xi, yr), mul(xr, yi));
+    }, a, b, out, n);
+}
+template <typename T>
+inline void SIMD::complexDivN(const T* ar, const T* ai, const T* br, const T* bi, T* outR, T* outI, const std::size_t& n) noexcept {
+    // a conj(b) / |b|^2, the reciprocal shared by both parts (a lane count of 4 for a register, 1 for a T)
+    complexN([](const auto& xr, const auto& xi, const auto& yr, const auto& yi, auto& r, auto& i) {
+        const auto inv = div(splat<sizeof(xr) / sizeof(T)>(static_cast<T>(1)), add(mul(yr, yr), mul(yi, yi)));
+
+        r = mul(add(mul(xr, yr), mul(xi, yi)), inv);
+        i = mul(sub(mul(xi, yr), mul(xr, yi)), inv);
+    }, ar, ai, br, bi, outR, outI, n);
+}
+template <typename T>
+inline void SIMD::complexDivN(const T* a, const T* b, T* out, const std::size_t& n) noexcept {
+    complexN([](const auto& xr, const auto& xi, const auto& yr, const auto& yi, auto& r, auto& i) {
+        const auto inv = div(splat<sizeof(xr) / sizeof(T)>(static_cast<T>(1)), add(mul(yr, yr), mul(yi, yi)));
+
+        r = mul(add(mul(xr, yr), mul(xi, yi)), inv);
+        i = mul(sub(mul(xi, yr), mul(xr, yi)), inv);
+    }, a, b, out, n);
+}
+
+template <typename T>
+inline void SIMD::complexMagnitudeSquareN(const T* re, const T* im, T* out, const std::size_t& n) noexcept {
+    complexUnaryN([](const auto& r, const auto& i) { return add(mul(r, r), mul(i, i)); }, re, im, out, n);
+}
+template <typename T>
+inline void SIMD::complexMagnitudeSquareN(const T* a, T* out, const std::size_t& n) noexcept {
+    complexUnaryN([](const auto& r, const auto& i) { return add(mul(r, r), mul(i, i)); }, a, out, n);
+}
+template <typename T>
+inline void SIMD::complexMagnitudeN(const T* re, const T* im, T* out, const std::size_t& n) noexcept {
+    complexUnaryN([](const auto& r, const auto& i) { return sqrt(add(mul(r, r), mul(i, i))); }, re, im, out, n);
+}
+template <typename T>
+inline void SIMD::complexMagnitudeN(const T* a, T* out, const std::size_t& n) noexcept {
+    complexUnaryN([](const auto& r, const auto& i) { return sqrt(add(mul(r, r), mul(i, i))); }, a, out, n);
+}
+
+template <typename T, typename F>
+inline void SIMD::complexN(const F& op, const T* ar, const T* ai, const T* br, const T* bi, T* outR, T* outI, const std::size_t& n) noexcept {
+    static_assert(isFloat<T>);
+
+    std::size_t i = 0;
+
+    if constexpr (has4<T>) {
+        using V = decltype(splat<4>(T{ }));
+
+        for (; i < n / 4 * 4; i += 4) {
+            V r, m;
+            op(load(ar + i), load(ai + i), load(br + i), load(bi + i), r, m);
+
+            store(outR + i, r);
+            store(outI + i, m);
+        }
+    }
+
+    // through locals, the output may alias an input
+    for (; i < n; ++i) {
+        T r, m;
+        op(ar[i], ai[i], br[i], bi[i], r, m);
+
+        outR[i] = r;
+        outI[i] = m;
+    }
+}
+template <typename T, typename F>
+inline void SIMD::complexN(const F& op, const T* a, const T* b, T* out, const std::size_t& n) noexcept {
+    static_assert(isFloat<T>);
+
+    std::size_t i = 0;
+
+    if constexpr (has4<T>) {
+        using V = decltype(splat<4>(T{ }));
+
+        for (; i < n / 4 * 4; i += 4) {
+            V ar, ai, br, bi;
+            deinterleave(load(a + 2 * i), load(a + 2 * i + 4), ar, ai);
+            deinterleave(load(b + 2 * i), load(b + 2 * i + 4), br, bi);
+
+            V r, m;
+            op(ar, ai, br, bi, r, m);
+
+            V v0, v1;
+            interleave(r, m, v0, v1);
+
+            store(out + 2 * i, v0);
+            store(out + 2 * i + 4, v1);
+        }
+    }
+
+    for (; i < n; ++i) {
+        T r, m;
+        op(a[2 * i], a[2 * i + 1], b[2 * i], b[2 * i + 1], r, m);
+
+        out[2 * i]     = r;
+        out[2 * i + 1] = m;
+    }
+}
+template <typename T, typename F>
+inline void SIMD::complexUnaryN(const F& op, const T* re, const T* im, T* out, const std::size_t& n) noexcept {
+    static_assert(isFloat<T>);
+
+    std::size_t i = 0;
+
+    if constexpr (has4<T>) {
+        for (; i < n / 4 * 4; i += 4)
+            store(out + i, op(load(re + i), load(im + i)));
+    }
+
+    for (; i < n; ++i)
+        out[i] = op(re[i], im[i]);
+}
+template <typename T, typename F>
+inline void SIMD::complexUnaryN(const F& op, const T* a, T* out, const std::size_t& n) noexcept {
+    static_assert(isFloat<T>);
+
+    std::size_t i = 0;
+
+    if constexpr (has4<T>) {
+        using V = decltype(splat<4>(T{ }));
+
+        for (; i < n / 4 * 4; i += 4) {
+            V re, im;
+            deinterleave(load(a + 2 * i), load(a + 2 * i + 4), re, im);
+
+            // double splits into pairs 0, 2, 1, 3
+            #if defined(MATH_SIMD_AVX)
+                if constexpr (isSame<T, double>) {
+                    store(out + i, swizzle<0, 2, 1, 3>(op(re, im)));
+
+                    continue;
+                }
+            #endif
+
+            store(out + i, op(re, im));
+        }
+    }
+
+    for (; i < n; ++i)
+        out[i] = op(a[2 * i], a[2 * i + 1]);
+}
+
+#include "math.hpp"
\ No newline at end of file
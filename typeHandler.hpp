@@ -62,6 +62,12 @@ inline constexpr bool isInteger = isSignedInteger<T> || isUnsignedInteger<T>;
 template <typename T>
 inline constexpr bool isArithmetic = isInteger<T> || isFloat<T>;
 
+// compiler intrinsics (GCC, Clang, MSVC)
+template <typename T>
+inline constexpr bool isTriviallyCopyable = __is_trivially_copyable(T);
+template <typename T>
+inline constexpr bool isStandardLayout = __is_standard_layout(T);
+
 
 template <bool C, typename A, typename B>
 using IF = typename TypeBase::IF<C, A, B>::type;
@@ -70,6 +76,10 @@ template <bool C, typename T = void>
 using enableIF = typename TypeBase::enableIF<C, T>::type;
 
 
+// true while evaluated in a constant expression (intrinsic paths must fall back to scalar code)
+[[nodiscard]] constexpr bool isConstantEvaluated() noexcept
+{ return __builtin_is_constant_evaluated(); }
+
 template <typename T>
 [[nodiscard]] constexpr decltype(auto) move(T&& val) noexcept
 { return static_cast<removeReference<T>&&>(val); }
\ No newline at end of file
@@ -0,0 +1,312 @@
+#pragma once
+
+#include "../base.hpp"
+#include "../math.hpp"
+#include "../simd.hpp"
+#include "../typeHandler.hpp"
+#include "../matrix/mat4.hpp"
+#include "vec3.hpp"
+#include "vec4.hpp"
+
+#include <cassert>      // assert()
+#include <cmath>        // sqrt(), sin(), cos(), acos()
+#include <cstddef>      // size_t
+
+// Rotation quaternion x i + y j + z k + w, identity by default
+template <typename T>
+class Quat {
+    static_assert(isFloat<T>);
+
+    public:
+        constexpr Quat() noexcept = default;
+        constexpr Quat(const Quat<T>&) noexcept = default;
+        constexpr Quat(Quat<T>&&) noexcept = default;
+        ~Quat() noexcept = default;
+
+        template <typename U> constexpr Quat(const Quat<U>&) noexcept;
+
+        constexpr Quat(const T& x, const T& y, const T& z, const T& w) noexcept;
+
+        constexpr Quat<T>& operator=(const Quat<T>&) noexcept = default;
+        constexpr Quat<T>& operator=(Quat<T>&&) noexcept = default;
+
+        template <typename U> constexpr Quat<T>& operator=(const Quat<U>&) noexcept;
+
+        template <typename U> constexpr Quat<T>& operator*=(const Quat<U>&) noexcept;
+
+        // this rotation applied after other
+        template <typename U> inline constexpr Quat<T> operator*(const Quat<U>&) const noexcept;
+        template <typename U> inline constexpr Vec3<T> operator*(const Vec3<U>&) const noexcept;
+
+        template <typename U> inline constexpr Quat<T> operator+(const Quat<U>&) const noexcept;
+        template <typename U> inline constexpr Quat<T> operator-(const Quat<U>&) const noexcept;
+        inline constexpr Quat<T> operator*(const T&) const noexcept;
+        inline constexpr Quat<T> operator-() const noexcept;
+
+        template <typename U> inline constexpr T dot(const Quat<U>&) const noexcept;
+        template <typename U> inline constexpr Vec3<T> rotate(const Vec3<U>&) const noexcept;
+
+        inline constexpr Quat<T> conjugate() const noexcept;
+        inline constexpr Quat<T> inverse() const;
+        inline Quat<T> normalize() const noexcept;
+        inline T length() const noexcept;
+        inline constexpr T lengthSquare() const noexcept;
+
+        // same matrix as the Mat4 rotate builders
+        inline constexpr Mat<T, 4, 4> toMat4() const noexcept;
+
+        static inline constexpr Quat<T> identity() noexcept;
+        // angle in degrees around a non-zero axis
+        static inline Quat<T> axisAngle(const Vec3<T>&, const T&) noexcept;
+        // rotateZ(r.z) * rotateY(r.y) * rotateX(r.x), angles in degrees
+        static inline Quat<T> fromEuler(const Vec3<T>&) noexcept;
+        // upper 3x3 must be a pure rotation
+        static inline Quat<T> fromMat4(const Mat<T, 4, 4>&) noexcept;
+
+        static inline Quat<T> nlerp(const Quat<T>&, const Quat<T>&, const T&) noexcept;
+        static inline Quat<T> slerp(const Quat<T>&, const Quat<T>&, const T&) noexcept;
+
+        // dst[i] = op(src[i]...) over whole arrays (dst may equal a source). No product / per-element rotate:
+        // their arrays store each quaternion across a register, the transposes cost more than the loop of operator*
+        static inline void rotate(const Quat<T>&, const Vec3<T>*, Vec3<T>*, const std::size_t&) noexcept;
+        static inline void toMat4(const Quat<T>*, Mat<T, 4, 4>*, const std::size_t&) noexcept;
+        static inline void nlerp(const Quat<T>*, const Quat<T>*, const T&, Quat<T>*, const std::size_t&) noexcept;
+        static inline void slerp(const Quat<T>*, const Quat<T>*, const T&, Quat<T>*, const std::size_t&) noexcept;
+
+    public:
+        T x{ };
+        T y{ };
+        T z{ };
+        T w{ static_cast<T>(1) };
+};
+
+template <typename T> template <typename U>
+constexpr Quat<T>::Quat(const Quat<U>& other) noexcept { *this = other; }
+
+template <typename T>
+constexpr Quat<T>::Quat(const T& _x, const T& _y, const T& _z, const T& _w) noexcept
+    : x{_x}, y{_y}, z{_z}, w{_w} { }
+
+template <typename T> template <typename U>
+constexpr Quat<T>& Quat<T>::operator=(const Quat<U>& other) noexcept {
+    x = static_cast<T>(other.x);
+    y = static_cast<T>(other.y);
+    z = static_cast<T>(other.z);
+    w = static_cast<T>(other.w);
+
+    return *this;
+}
+
+template <typename T> template <typename U>
+constexpr Quat<T>& Quat<T>::operator*=(const Quat<U>& other) noexcept { return (*this = ((*this) * other)); }
+
+template <typename T> template <typename U>
+inline constexpr Quat<T> Quat<T>::operator*(const Quat<U>& q) const noexcept {
+    return {
+        static_cast<T>(w * q.x + x * q.w + y * q.z - z * q.y),
+        static_cast<T>(w * q.y - x * q.z + y * q.w + z * q.x),
+        static_cast<T>(w * q.z + x * q.y - y * q.x + z * q.w),
+        static_cast<T>(w * q.w - x * q.x - y * q.y - z * q.z)
+    };
+}
+template <typename T> template <typename U>
+inline constexpr Vec3<T> Quat<T>::operator*(const Vec3<U>& v) const noexcept { return rotate(v); }
+
+template <typename T> template <typename U>
+inline constexpr Quat<T> Quat<T>::operator+(const Quat<U>& q) const noexcept {
+    return {
+        static_cast<T>(x + q.x),
+        static_cast<T>(y + q.y),
+        static_cast<T>(z + q.z),
+        static_cast<T>(w + q.w)
+    };
+}
+template <typename T> template <typename U>
+inline constexpr Quat<T> Quat<T>::operator-(const Quat<U>& q) const noexcept {
+    return {
+        static_cast<T>(x - q.x),
+        static_cast<T>(y - q.y),
+        static_cast<T>(z - q.z),
+        static_cast<T>(w - q.w)
+    };
+}
+template <typename T>
+inline constexpr Quat<T> Quat<T>::operator*(const T& val) const noexcept { return { x * val, y * val, z * val, w * val }; }
+template <typename T>
+inline constexpr Quat<T> Quat<T>::operator-() const noexcept { return { -x, -y, -z, -w }; }
+
+template <typename T> template <typename U>
+inline constexpr T Quat<T>::dot(const Quat<U>& q) const noexcept { return static_cast<T>(x * q.x + y * q.y + z * q.z + w * q.w); }
+
+// v + w t + q x t, t = 2 (q x v)
+template <typename T> template <typename U>
+inline constexpr Vec3<T> Quat<T>::rotate(const Vec3<U>& v) const noexcept {
+    const T tx = static_cast<T>(2 * (y * v.z - z * v.y));
+    const T ty = static_cast<T>(2 * (z * v.x - x * v.z));
+    const T tz = static_cast<T>(2 * (x * v.y - y * v.x));
+
+    return {
+        static_cast<T>(v.x + w * tx + (y * tz - z * ty)),
+        static_cast<T>(v.y + w * ty + (z * tx - x * tz)),
+        static_cast<T>(v.z + w * tz + (x * ty - y * tx))
+    };
+}
+
+template <typename T> inline constexpr Quat<T> Quat<T>::conjugate() const noexcept { return { -x, -y, -z, w }; }
+template <typename T> inline constexpr Quat<T> Quat<T>::inverse() const {
+    const T lenSq = lengthSquare();
+
+    assert(!Math::isZero(lenSq));
+
+    return conjugate() * (static_cast<T>(1) / lenSq);
+}
+template <typename T> inline Quat<T> Quat<T>::normalize() const noexcept { return (*this) * (static_cast<T>(1) / length()); }
+template <typename T> inline T Quat<T>::length() const noexcept { return static_cast<T>(std::sqrt(lengthSquare())); }
+template <typename T> inline constexpr T Quat<T>::lengthSquare() const noexcept { return dot(*this); }
+
+template <typename T> inline constexpr Mat<T, 4, 4> Quat<T>::toMat4() const noexcept {
+    constexpr T zero = static_cast<T>(0);
+    constexpr T one  = static_cast<T>(1);
+
+    const T xx = x * x, yy = y * y, zz = z * z;
+    const T xy = x * y, xz = x * z, yz = y * z;
+    const T wx = w * x, wy = w * y, wz = w * z;
+
+    return {
+        Vec4<T>{ one - 2 * (yy + zz),       2 * (xy - wz),       2 * (xz + wy), zero },
+        Vec4<T>{       2 * (xy + wz), one - 2 * (xx + zz),       2 * (yz - wx), zero },
+        Vec4<T>{       2 * (xz - wy),       2 * (yz + wx), one - 2 * (xx + yy), zero },
+        Vec4<T>{            zero    ,            zero    ,            zero    ,  one }
+    };
+}
+
+template <typename T> inline constexpr Quat<T> Quat<T>::identity() noexcept { return { }; }
+template <typename T> inline Quat<T> Quat<T>::axisAngle(const Vec3<T>& axis, const T& deg) noexcept {
+    const Vec3<T> n = axis.normalize();
+
+    T s{ }, c{ };
+    Math::sincos(Math::toRad(deg) / 2, s, c);
+
+    return { n.x * s, n.y * s, n.z * s, c };
+}
+template <typename T> inline Quat<T> Quat<T>::fromEuler(const Vec3<T>& r) noexcept {
+    T sx{ }, cx{ }, sy{ }, cy{ }, sz{ }, cz{ };
+    Math::sincos(Math::toRad(r.x) / 2, sx, cx);
+    Math::sincos(Math::toRad(r.y) / 2, sy, cy);
+    Math::sincos(Math::toRad(r.z) / 2, sz, cz);
+
+    return {
+        cz * cy * sx - sz * sy * cx,
+        cz * sy * cx + sz * cy * sx,
+        sz * cy * cx - cz * sy * sx,
+        cz * cy * cx + sz * sy * sx
+    };
+}
+// Shepperd: divide by the largest of 4w^2, 4x^2, 4y^2, 4z^2
+template <typename T> inline Quat<T> Quat<T>::fromMat4(const Mat<T, 4, 4>& m) noexcept {
+    const Vec4<T>& r0 = m.mROW[0];
+    const Vec4<T>& r1 = m.mROW[1];
+    const Vec4<T>& r2 = m.mROW[2];
+
+    constexpr T one     = static_cast<T>(1);
+    constexpr T quarter = static_cast<T>(0.25);
+
+    const T trace = r0.x + r1.y + r2.z;
+
+    if (trace > 0) {
+        const T s = static_cast<T>(std::sqrt(one + trace) * 2);
+
+        return { (r2.y - r1.z) / s, (r0.z - r2.x) / s, (r1.x - r0.y) / s, quarter * s };
+    }
+    if (r0.x > r1.y && r0.x > r2.z) {
+        const T s = static_cast<T>(std::sqrt(one + r0.x - r1.y - r2.z) * 2);
+
+        return { quarter * s, (r0.y + r1.x) / s, (r0.z + r2.x) / s, (r2.y - r1.z) / s };
+    }
+    if (r1.y > r2.z) {
+        const T s = static_cast<T>(std::sqrt(one + r1.y - r0.x - r2.z) * 2);
+
+        return { (r0.y + r1.x) / s, quarter * s, (r1.z + r2.y) / s, (r0.z - r2.x) / s };
+    }
+
+    const T s = static_cast<T>(std::sqrt(one + r2.z - r0.x - r1.y) * 2);
+
+    return { (r0.z + r2.x) / s, (r1.z + r2.y) / s, quarter * s, (r1.x - r0.y) / s };
+}
+
+// both interpolations take the shorter arc
+template <typename T> inline Quat<T> Quat<T>::nlerp(const Quat<T>& a, const Quat<T>& b, const T& t) noexcept {
+    const T wb = (a.dot(b) < 0) ? -t : t;
+
+    return (a * (static_cast<T>(1) - t) + b * wb).normalize();
+}
+template <typename T> inline Quat<T> Quat<T>::slerp(const Quat<T>& a, const Quat<T>& b, const T& t) noexcept {
+    T cosTheta = a.dot(b);
+    T sign = static_cast<T>(1);
+
+    if (cosTheta < 0) {
+        cosTheta = -cosTheta;
+        sign = static_cast<T>(-1);
+    }
+
+    // nearly parallel: sin(theta) vanishes, nlerp is exact enough
+    if (cosTheta > static_cast<T>(1) - Math::EPSILON<T> * 10)
+        return nlerp(a, b, t);
+
+    const T theta = static_cast<T>(std::acos(cosTheta));
+    const T invSin = static_cast<T>(1 / std::sin(theta));
+
+    const T wa = static_cast<T>(std::sin((1 - t) * theta) * invSin);
+    const T wb = static_cast<T>(std::sin(t * theta) * invSin) * sign;
+
+    return a * wa + b * wb;
+}
+
+// SIMD::quat* over four quaternions per register (has4<T>), a single rotation as its matrix through transformDirections
+template <typename T>
+inline void Quat<T>::rotate(const Quat<T>& q, const Vec3<T>* src, Vec3<T>* dst, const std::size_t& count) noexcept {
+    if constexpr (SIMD::has4<T>) {
+        Mat<T, 4, 4>::transformDirections(q.toMat4(), src, dst, count);
+
+        return;
+    }
+
+    for (std::size_t i = 0; i < count; ++i)
+        dst[i] = q.rotate(src[i]);
+}
+template <typename T>
+inline void Quat<T>::toMat4(const Quat<T>* src, Mat<T, 4, 4>* dst, const std::size_t& count) noexcept {
+    if constexpr (SIMD::has4<T>) {
+        SIMD::blocks<T>(count, [](const T* in, T* out, const std::size_t& n) { SIMD::quatToMat4(in, out, n); }, src, dst);
+
+        return;
+    }
+
+    for (std::size_t i = 0; i < count; ++i)
+        dst[i] = src[i].toMat4();
+}
+template <typename T>
+inline void Quat<T>::nlerp(const Quat<T>* a, const Quat<T>* b, const T& t, Quat<T>* dst, const std::size_t& count) noexcept {
+    if constexpr (SIMD::has4<T>) {
+        SIMD::blocks<T>(count, [&t](const T* lanesA, const T* lanesB, T* out, const std::size_t& n) { SIMD::quatNlerp(lanesA, lanesB, t, out, n); }, a, b, dst);
+
+        return;
+    }
+
+    for (std::size_t i = 0; i < count; ++i)
+        dst[i] = nlerp(a[i], b[i], t);
+}
+template <typename T>
+inline void Quat<T>::slerp(const Quat<T>* a, const Quat<T>* b, const T& t, Quat<T>* dst, const std::size_t& count) noexcept {
+    if constexpr (SIMD::has4<T>) {
+        SIMD::blocks<T>(count, [&t](const T* lanesA, const T* lanesB, T* out, const std::size_t& n) { SIMD::quatSlerp(lanesA, lanesB, t, out, n); }, a, b, dst);
+
+        return;
+    }
+
+    for (std::size_t i = 0; i < count; ++i)
+        dst[i] = slerp(a[i], b[i], t);
+}
+
+static_assert(isTriviallyCopyable<Quat<float>>  && isStandardLayout<Quat<float>>);
+static_assert(isTriviallyCopyable<Quat<double>> && isStandardLayout<Quat<double>>);
\ No newline at end of file
@@ -2,56 +2,57 @@
 
 #include "../base.hpp"
 #include "../math.hpp"
+#include "../simd.hpp"
 #include "../typeHandler.hpp"
 
 #include <cassert>      // assert()
 #include <cmath>        // sqrt()
+#include <cstddef>      // size_t
 
 template <typename T>
 class Vec<T, 2> {
     public:
-        Vec() noexcept;
-        Vec(const Vec<T, 2>&) noexcept;
-        Vec(Vec<T, 2>&&) noexcept;
-        ~Vec() noexcept;
+        constexpr Vec() noexcept = default;
+        constexpr Vec(const Vec<T, 2>&) noexcept = default;
+        constexpr Vec(Vec<T, 2>&&) noexcept = default;
+        ~Vec() noexcept = default;
 
-        template <typename U> Vec(const Vec<U, 2>&) noexcept;
-        template <typename U> Vec(Vec<U, 2>&&) noexcept;
+        template <typename U> constexpr Vec(const Vec<U, 2>&) noexcept;
 
         template <typename U>
-        Vec(const U&) noexcept;
+        constexpr Vec(const U&) noexcept;
         template <typename U1, typename U2>
-        Vec(const U1&, const U2&) noexcept;
+        constexpr Vec(const U1&, const U2&) noexcept;
 
-        Vec<T, 2>& operator=(const Vec<T, 2>&) noexcept;
-        Vec<T, 2>& operator=(Vec<T, 2>&&) noexcept;
+        constexpr Vec<T, 2>& operator=(const Vec<T, 2>&) noexcept = default;
+        constexpr Vec<T, 2>& operator=(Vec<T, 2>&&) noexcept = default;
 
-        template <typename U> Vec<T, 2>& operator=(const Vec<U, 2>&) noexcept;
-        template <typename U> Vec<T, 2>& operator=(Vec<U, 2>&&) noexcept;
+        template <typename U> constexpr Vec<T, 2>& operator=(const Vec<U, 2>&) noexcept;
+        template <typename E> constexpr Vec<T, 2>& operator=(const Expr<E>&) noexcept;
 
         template <typename U>
-        Vec<T, 2>& operator()(const Vec<U, 2>&) noexcept;
+        constexpr Vec<T, 2>& operator()(const Vec<U, 2>&) noexcept;
         template <typename U>
-        Vec<T, 2>& operator()(const U&) noexcept;
+        constexpr Vec<T, 2>& operator()(const U&) noexcept;
         template <typename U1, typename U2>
-        Vec<T, 2>& operator()(const U1&, const U2&) noexcept;
+        constexpr Vec<T, 2>& operator()(const U1&, const U2&) noexcept;
 
-        T& operator[](const unsigned int& idx);
-        const T& operator[](const unsigned int& idx) const;
+        constexpr T& operator[](const unsigned int& idx);
+        constexpr const T& operator[](const unsigned int& idx) const;
 
-        template <typename U> Vec<T, 2>& operator+=(const Vec<U, 2>&) noexcept;
-        template <typename U> Vec<T, 2>& operator-=(const Vec<U, 2>&) noexcept;
-        template <typename U> Vec<T, 2>& operator+=(const U&) noexcept;
-        template <typename U> Vec<T, 2>& operator-=(const U&) noexcept;
-        template <typename U> Vec<T, 2>& operator*=(const U&) noexcept;
-        template <typename U> Vec<T, 2>& operator/=(const U&);
+        template <typename U> constexpr Vec<T, 2>& operator+=(const Vec<U, 2>&) noexcept;
+        template <typename U> constexpr Vec<T, 2>& operator-=(const Vec<U, 2>&) noexcept;
+        template <typename U> constexpr Vec<T, 2>& operator+=(const U&) noexcept;
+        template <typename U> constexpr Vec<T, 2>& operator-=(const U&) noexcept;
+        template <typename U> constexpr Vec<T, 2>& operator*=(const U&) noexcept;
+        template <typename U> constexpr Vec<T, 2>& operator/=(const U&);
 
-        template <typename U> inline Vec<T, 2> operator+(const Vec<U, 2>&) const noexcept;
-        template <typename U> inline Vec<T, 2> operator-(const Vec<U, 2>&) const noexcept;
-        template <typename U> inline Vec<T, 2> operator+(const U&) const noexcept;
-        template <typename U> inline Vec<T, 2> operator-(const U&) const noexcept;
-        template <typename U> inline Vec<T, 2> operator*(const U&) const noexcept;
-        template <typename U> inline Vec<T, 2> operator/(const U&) const;
+        template <typename U> inline constexpr Vec<T, 2> operator+(const Vec<U, 2>&) const noexcept;
+        template <typename U> inline constexpr Vec<T, 2> operator-(const Vec<U, 2>&) const noexcept;
+        template <typename U> inline constexpr Vec<T, 2> operator+(const U&) const noexcept;
+        template <typename U> inline constexpr Vec<T, 2> operator-(const U&) const noexcept;
+        template <typename U> inline constexpr Vec<T, 2> operator*(const U&) const noexcept;
+        template <typename U> inline constexpr Vec<T, 2> operator/(const U&) const;
 
         template <typename U> inline constexpr T dot(const Vec<U, 2>&) const noexcept;
         template <typename U> inline constexpr T cross(const Vec<U, 2>&) const noexcept;
@@ -59,6 +60,9 @@ class Vec<T, 2> {
         inline Vec<T, 2> normalize() const noexcept;
         inline constexpr T length() const noexcept;
         inline constexpr T lengthSquare() const noexcept;
+        // rsqrt with one Newton step (SIMD::rsqrt): under 4e-7 relative error, no zero check
+        inline Vec<T, 2> fastNormalize() const noexcept;
+        inline T fastLength() const noexcept;
 
         template <typename U> static inline constexpr T dot(const Vec<T, 2>&, const Vec<U, 2>&) noexcept;
         template <typename U> static inline constexpr T cross(const Vec<T, 2>&, const Vec<U, 2>&) noexcept;
@@ -67,78 +71,62 @@ class Vec<T, 2> {
         static inline constexpr T length(const Vec<T, 2>&) noexcept;
         static inline constexpr T lengthSquare(const Vec<T, 2>&) noexcept;
 
+        static inline Vec<T, 2> fastNormalize(const Vec<T, 2>&) noexcept;
+        static inline T fastLength(const Vec<T, 2>&) noexcept;
+        static inline void fastNormalize(const Vec<T, 2>* src, Vec<T, 2>* dst, const std::size_t& count) noexcept;
+        static inline void fastLength(const Vec<T, 2>* src, T* dst, const std::size_t& count) noexcept;
+
     public:
         union { T x{ }, s; };
         union { T y{ }, t; };
 };
 template <typename T> using Vec2 = Vec<T, 2>;
 
-template <typename T> Vec<T, 2>::Vec() noexcept { }
-template <typename T> Vec<T, 2>::Vec(const Vec<T, 2>& other) noexcept { *this = other; }
-template <typename T> Vec<T, 2>::Vec(Vec<T, 2>&& other) noexcept { *this = move(other); }
-template <typename T> Vec<T, 2>::~Vec() noexcept { }
-
 template <typename T> template <typename U>
-Vec<T, 2>::Vec(const Vec<U, 2>& other) noexcept { *this = other; }
-template <typename T> template <typename U>
-Vec<T, 2>::Vec(Vec<U, 2>&& other) noexcept { *this = move(other); }
+constexpr Vec<T, 2>::Vec(const Vec<U, 2>& other) noexcept { *this = other; }
 
 template <typename T> template <typename U>
-Vec<T, 2>::Vec(const U& _x) noexcept { (*this)(_x); }
+constexpr Vec<T, 2>::Vec(const U& _x) noexcept { (*this)(_x); }
 template <typename T> template <typename U1, typename U2>
-Vec<T, 2>::Vec(const U1& _x, const U2& _y) noexcept { (*this)(_x, _y); }
-
-template <typename T> Vec<T, 2>& Vec<T, 2>::operator=(const Vec<T, 2>& other) noexcept {
-    x = other.x;
-    y = other.y;
-
-    return *this;
-}
-template <typename T> Vec<T, 2>& Vec<T, 2>::operator=(Vec<T, 2>&& other) noexcept {
-    x = other.x;
-    y = other.y;
-
-    other.x = { };
-    other.y = { };
-
-    return *this;
-}
+constexpr Vec<T, 2>::Vec(const U1& _x, const U2& _y) noexcept { (*this)(_x, _y); }
 
 template <typename T> template <typename U>
-Vec<T, 2>& Vec<T, 2>::operator=(const Vec<U, 2>& other) noexcept {
+constexpr Vec<T, 2>& Vec<T, 2>::operator=(const Vec<U, 2>& other) noexcept {
     x = static_cast<T>(other.x);
     y = static_cast<T>(other.y);
 
     return *this;
 }
-template <typename T> template <typename U>
-Vec<T, 2>& Vec<T, 2>::operator=(Vec<U, 2>&& other) noexcept {
-    x = static_cast<T>(other.x);
-    y = static_cast<T>(other.y);
+template <typename T> template <typename E>
+constexpr Vec<T, 2>& Vec<T, 2>::operator=(const Expr<E>& e) noexcept {
+    static_assert((E::ROWS == 2) && (E::COLS == 1));
 
-    other.x = { };
-    other.y = { };
+    const T _x = static_cast<T>(e[0]);
+    const T _y = static_cast<T>(e[1]);
+
+    x = _x;
+    y = _y;
 
     return *this;
 }
 
 template <typename T> template <typename U>
-Vec<T, 2>& Vec<T, 2>::operator()(const Vec<U, 2>& other) noexcept { return (*this = other); }
+constexpr Vec<T, 2>& Vec<T, 2>::operator()(const Vec<U, 2>& other) noexcept { return (*this = other); }
 template <typename T> template <typename U>
-Vec<T, 2>& Vec<T, 2>::operator()(const U& _x) noexcept {
+constexpr Vec<T, 2>& Vec<T, 2>::operator()(const U& _x) noexcept {
     x = static_cast<T>(_x);
 
     return *this;
 }
 template <typename T> template <typename U1, typename U2>
-Vec<T, 2>& Vec<T, 2>::operator()(const U1& _x, const U2& _y) noexcept {
+constexpr Vec<T, 2>& Vec<T, 2>::operator()(const U1& _x, const U2& _y) noexcept {
     x = static_cast<T>(_x);
     y = static_cast<T>(_y);
 
     return *this;
 }
 
-template <typename T> T& Vec<T, 2>::operator[](const unsigned int& idx) {
+template <typename T> constexpr T& Vec<T, 2>::operator[](const unsigned int& idx) {
     assert(idx < 2);
 
     switch (idx) {
@@ -147,7 +135,7 @@ template <typename T> T& Vec<T, 2>::operator[](const unsigned int& idx) {
         case 1: return y;
     }
 }
-template <typename T> const T& Vec<T, 2>::operator[](const unsigned int& idx) const {
+template <typename T> constexpr const T& Vec<T, 2>::operator[](const unsigned int& idx) const {
     assert(idx < 2);
 
     switch (idx) {
@@ -158,42 +146,42 @@ template <typename T> const T& Vec<T, 2>::operator[](const unsigned int& idx) co
 }
 
 template <typename T> template <typename U>
-Vec<T, 2>& Vec<T, 2>::operator+=(const Vec<U, 2>& other) noexcept {
+constexpr Vec<T, 2>& Vec<T, 2>::operator+=(const Vec<U, 2>& other) noexcept {
     x = static_cast<T>(x + other.x);
     y = static_cast<T>(y + other.y);
 
     return *this;
 }
 template <typename T> template <typename U>
-Vec<T, 2>& Vec<T, 2>::operator-=(const Vec<U, 2>& other) noexcept {
+constexpr Vec<T, 2>& Vec<T, 2>::operator-=(const Vec<U, 2>& other) noexcept {
     x = static_cast<T>(x - other.x);
     y = static_cast<T>(y - other.y);
 
     return *this;
 }
 template <typename T> template <typename U>
-Vec<T, 2>& Vec<T, 2>::operator+=(const U& val) noexcept {
+constexpr Vec<T, 2>& Vec<T, 2>::operator+=(const U& val) noexcept {
     x = static_cast<T>(x + val);
     y = static_cast<T>(y + val);
 
     return *this;
 }
 template <typename T> template <typename U>
-Vec<T, 2>& Vec<T, 2>::operator-=(const U& val) noexcept {
+constexpr Vec<T, 2>& Vec<T, 2>::operator-=(const U& val) noexcept {
     x = static_cast<T>(x - val);
     y = static_cast<T>(y - val);
 
     return *this;
 }
 template <typename T> template <typename U>
-Vec<T, 2>& Vec<T, 2>::operator*=(const U& val) noexcept {
+constexpr Vec<T, 2>& Vec<T, 2>::operator*=(const U& val) noexcept {
     x = static_cast<T>(x * val);
     y = static_cast<T>(y * val);
 
     return *this;
 }
 template <typename T> template <typename U>
-Vec<T, 2>& Vec<T, 2>::operator/=(const U& val) {
+constexpr Vec<T, 2>& Vec<T, 2>::operator/=(const U& val) {
     assert(!Math::isZero(val));
 
     x = static_cast<T>(x / val);
@@ -203,42 +191,42 @@ Vec<T, 2>& Vec<T, 2>::operator/=(const U& val) {
 }
 
 template <typename T> template <typename U>
-inline Vec<T, 2> Vec<T, 2>::operator+(const Vec<U, 2>& other) const noexcept {
+inline constexpr Vec<T, 2> Vec<T, 2>::operator+(const Vec<U, 2>& other) const noexcept {
     return {
         static_cast<T>(x + other.x),
         static_cast<T>(y + other.y)
     };
 }
 template <typename T> template <typename U>
-inline Vec<T, 2> Vec<T, 2>::operator-(const Vec<U, 2>& other) const noexcept {
+inline constexpr Vec<T, 2> Vec<T, 2>::operator-(const Vec<U, 2>& other) const noexcept {
     return {
         static_cast<T>(x - other.x),
         static_cast<T>(y - other.y)
     };
 }
 template <typename T> template <typename U>
-inline Vec<T, 2> Vec<T, 2>::operator+(const U& val) const noexcept {
+inline constexpr Vec<T, 2> Vec<T, 2>::operator+(const U& val) const noexcept {
     return {
         static_cast<T>(x + val),
         static_cast<T>(y + val)
     };
 }
 template <typename T> template <typename U>
-inline Vec<T, 2> Vec<T, 2>::operator-(const U& val) const noexcept {
+inline constexpr Vec<T, 2> Vec<T, 2>::operator-(const U& val) const noexcept {
     return {
         static_cast<T>(x - val),
         static_cast<T>(y - val)
     };
 }
 template <typename T> template <typename U>
-inline Vec<T, 2> Vec<T, 2>::operator*(const U& val) const noexcept {
+inline constexpr Vec<T, 2> Vec<T, 2>::operator*(const U& val) const noexcept {
     return {
         static_cast<T>(x * val),
         static_cast<T>(y * val)
     };
 }
 template <typename T> template <typename U>
-inline Vec<T, 2> Vec<T, 2>::operator/(const U& val) const {
+inline constexpr Vec<T, 2> Vec<T, 2>::operator/(const U& val) const {
     assert(!Math::isZero(val));
 
     return {
@@ -255,6 +243,18 @@ inline constexpr T Vec<T, 2>::cross(const Vec<U, 2>& other) const noexcept { ret
 template <typename T> inline Vec<T, 2> Vec<T, 2>::normalize() const noexcept { return (*this / length()); }
 template <typename T> inline constexpr T Vec<T, 2>::length() const noexcept { return static_cast<T>(std::sqrt(lengthSquare())); }
 template <typename T> inline constexpr T Vec<T, 2>::lengthSquare() const noexcept { return (Math::square(x) + Math::square(y)); }
+template <typename T> inline Vec<T, 2> Vec<T, 2>::fastNormalize() const noexcept {
+    static_assert(isFloat<T>);
+
+    return (*this * SIMD::rsqrt(lengthSquare()));
+}
+template <typename T> inline T Vec<T, 2>::fastLength() const noexcept {
+    static_assert(isFloat<T>);
+
+    const T sq = lengthSquare();
+
+    return (sq > 0) ? sq * SIMD::rsqrt(sq) : static_cast<T>(0);
+}
 
 template <typename T> template <typename U>
 inline constexpr T Vec<T, 2>::dot(const Vec<T, 2>& v1, const Vec<U, 2>& v2) noexcept { return v1.dot(v2); }
@@ -263,4 +263,26 @@ inline constexpr T Vec<T, 2>::cross(const Vec<T, 2>& v1, const Vec<U, 2>& v2) no
 
 template <typename T> inline Vec<T, 2> Vec<T, 2>::normalize(const Vec<T, 2>& v) noexcept { return v.normalize(); }
 template <typename T> inline constexpr T Vec<T, 2>::length(const Vec<T, 2>& v) noexcept { return v.length(); }
-template <typename T> inline constexpr T Vec<T, 2>::lengthSquare(const Vec<T, 2>& v) noexcept { return v.lengthSquare(); }
\ No newline at end of file
+template <typename T> inline constexpr T Vec<T, 2>::lengthSquare(const Vec<T, 2>& v) noexcept { return v.lengthSquare(); }
+
+template <typename T> inline Vec<T, 2> Vec<T, 2>::fastNormalize(const Vec<T, 2>& v) noexcept { return v.fastNormalize(); }
+template <typename T> inline T Vec<T, 2>::fastLength(const Vec<T, 2>& v) noexcept { return v.fastLength(); }
+template <typename T>
+inline void Vec<T, 2>::fastNormalize(const Vec<T, 2>* src, Vec<T, 2>* dst, const std::size_t& count) noexcept {
+    static_assert(isFloat<T>);
+    // copied as count * 2 lanes
+    static_assert(sizeof(Vec<T, 2>) == 2 * sizeof(T));
+
+    SIMD::blocks<T>(count, &SIMD::fastNormalize<2, T>, src, dst);
+}
+template <typename T>
+inline void Vec<T, 2>::fastLength(const Vec<T, 2>* src, T* dst, const std::size_t& count) noexcept {
+    static_assert(isFloat<T>);
+    static_assert(sizeof(Vec<T, 2>) == 2 * sizeof(T));
+
+    SIMD::blocks<T>(count, &SIMD::fastLength<2, T>, src, dst);
+}
+
+static_assert(isTriviallyCopyable<Vec2<float>>  && isStandardLayout<Vec2<float>>);
+static_assert(isTriviallyCopyable<Vec2<double>> && isStandardLayout<Vec2<double>>);
+static_assert(isTriviallyCopyable<Vec2<int>>    && isStandardLayout<Vec2<int>>);
\ No newline at end of file
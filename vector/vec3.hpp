@@ -2,75 +2,84 @@
 
 #include "../base.hpp"
 #include "../math.hpp"
+#include "../simd.hpp"
 #include "../typeHandler.hpp"
 
 #include <cassert>      // assert()
 #include <cmath>        // sqrt()
+#include <cstddef>      // size_t
 
 template <typename T>
 class Vec<T, 3> {
     public:
-        Vec() noexcept;
-        Vec(const Vec<T, 3>&) noexcept;
-        Vec(Vec<T, 3>&&) noexcept;
-        ~Vec() noexcept;
+        constexpr Vec() noexcept = default;
+        constexpr Vec(const Vec<T, 3>&) noexcept = default;
+        constexpr Vec(Vec<T, 3>&&) noexcept = default;
+        ~Vec() noexcept = default;
 
-        template <typename U> Vec(const Vec<U, 3>&) noexcept;
-        template <typename U> Vec(Vec<U, 3>&&) noexcept;
+        template <typename U> constexpr Vec(const Vec<U, 3>&) noexcept;
 
         template <typename U>
-        Vec(const U&) noexcept;
+        constexpr Vec(const U&) noexcept;
         template <typename U1, typename U2>
-        Vec(const U1&, const U2&) noexcept;
+        constexpr Vec(const U1&, const U2&) noexcept;
         template <typename U1, typename U2, typename U3>
-        Vec(const U1&, const U2&, const U3&) noexcept;
+        constexpr Vec(const U1&, const U2&, const U3&) noexcept;
 
-        Vec<T, 3>& operator=(const Vec<T, 3>&) noexcept;
-        Vec<T, 3>& operator=(Vec<T, 3>&&) noexcept;
+        constexpr Vec<T, 3>& operator=(const Vec<T, 3>&) noexcept = default;
+        constexpr Vec<T, 3>& operator=(Vec<T, 3>&&) noexcept = default;
 
-        template <typename U> Vec<T, 3>& operator=(const Vec<U, 3>&) noexcept;
-        template <typename U> Vec<T, 3>& operator=(Vec<U, 3>&&) noexcept;
+        template <typename U> constexpr Vec<T, 3>& operator=(const Vec<U, 3>&) noexcept;
+        template <typename E> constexpr Vec<T, 3>& operator=(const Expr<E>&) noexcept;
 
         template <typename U>
-        Vec<T, 3>& operator()(const Vec<U, 3>&) noexcept;
+        constexpr Vec<T, 3>& operator()(const Vec<U, 3>&) noexcept;
         template <typename U>
-        Vec<T, 3>& operator()(const U&) noexcept;
+        constexpr Vec<T, 3>& operator()(const U&) noexcept;
         template <typename U1, typename U2>
-        Vec<T, 3>& operator()(const U1&, const U2&) noexcept;
+        constexpr Vec<T, 3>& operator()(const U1&, const U2&) noexcept;
         template <typename U1, typename U2, typename U3>
-        Vec<T, 3>& operator()(const U1&, const U2&, const U3&) noexcept;
+        constexpr Vec<T, 3>& operator()(const U1&, const U2&, const U3&) noexcept;
 
-        T& operator[](const unsigned int& idx);
-        const T& operator[](const unsigned int& idx) const;
+        constexpr T& operator[](const unsigned int& idx);
+        constexpr const T& operator[](const unsigned int& idx) const;
 
-        template <typename U> Vec<T, 3>& operator+=(const Vec<U, 3>&) noexcept;
-        template <typename U> Vec<T, 3>& operator-=(const Vec<U, 3>&) noexcept;
-        template <typename U> Vec<T, 3>& operator+=(const U&) noexcept;
-        template <typename U> Vec<T, 3>& operator-=(const U&) noexcept;
-        template <typename U> Vec<T, 3>& operator*=(const U&) noexcept;
-        template <typename U> Vec<T, 3>& operator/=(const U&);
+        template <typename U> constexpr Vec<T, 3>& operator+=(const Vec<U, 3>&) noexcept;
+        template <typename U> constexpr Vec<T, 3>& operator-=(const Vec<U, 3>&) noexcept;
+        template <typename U> constexpr Vec<T, 3>& operator+=(const U&) noexcept;
+        template <typename U> constexpr Vec<T, 3>& operator-=(const U&) noexcept;
+        template <typename U> constexpr Vec<T, 3>& operator*=(const U&) noexcept;
+        template <typename U> constexpr Vec<T, 3>& operator/=(const U&);
 
-        template <typename U> inline Vec<T, 3> operator+(const Vec<U, 3>&) const noexcept;
-        template <typename U> inline Vec<T, 3> operator-(const Vec<U, 3>&) const noexcept;
-        template <typename U> inline Vec<T, 3> operator+(const U&) const noexcept;
-        template <typename U> inline Vec<T, 3> operator-(const U&) const noexcept;
-        template <typename U> inline Vec<T, 3> operator*(const U&) const noexcept;
-        template <typename U> inline Vec<T, 3> operator/(const U&) const;
+        template <typename U> inline constexpr Vec<T, 3> operator+(const Vec<U, 3>&) const noexcept;
+        template <typename U> inline constexpr Vec<T, 3> operator-(const Vec<U, 3>&) const noexcept;
+        template <typename U> inline constexpr Vec<T, 3> operator+(const U&) const noexcept;
+        template <typename U> inline constexpr Vec<T, 3> operator-(const U&) const noexcept;
+        template <typename U> inline constexpr Vec<T, 3> operator*(const U&) const noexcept;
+        template <typename U> inline constexpr Vec<T, 3> operator/(const U&) const;
 
         template <typename U> inline constexpr T dot(const Vec<U, 3>&) const noexcept;
-        template <typename U> inline Vec<T, 3> cross(const Vec<U, 3>&) const noexcept;
+        template <typename U> inline constexpr Vec<T, 3> cross(const Vec<U, 3>&) const noexcept;
 
         inline Vec<T, 3> normalize() const noexcept;
         inline constexpr T length() const noexcept;
         inline constexpr T lengthSquare() const noexcept;
+        // rsqrt with one Newton step (SIMD::rsqrt): under 4e-7 relative error, no zero check
+        inline Vec<T, 3> fastNormalize() const noexcept;
+        inline T fastLength() const noexcept;
 
         template <typename U> static inline constexpr T dot(const Vec<T, 3>&, const Vec<U, 3>&) noexcept;
-        template <typename U> static inline Vec<T, 3> cross(const Vec<T, 3>&, const Vec<U, 3>&) noexcept;
+        template <typename U> static inline constexpr Vec<T, 3> cross(const Vec<T, 3>&, const Vec<U, 3>&) noexcept;
 
         static inline Vec<T, 3> normalize(const Vec<T, 3>&) noexcept;
         static inline constexpr T length(const Vec<T, 3>&) noexcept;
         static inline constexpr T lengthSquare(const Vec<T, 3>&) noexcept;
 
+        static inline Vec<T, 3> fastNormalize(const Vec<T, 3>&) noexcept;
+        static inline T fastLength(const Vec<T, 3>&) noexcept;
+        static inline void fastNormalize(const Vec<T, 3>* src, Vec<T, 3>* dst, const std::size_t& count) noexcept;
+        static inline void fastLength(const Vec<T, 3>* src, T* dst, const std::size_t& count) noexcept;
+
     public:
         union { T x{ }, r; };
         union { T y{ }, g; };
@@ -78,80 +87,56 @@ class Vec<T, 3> {
 };
 template <typename T> using Vec3 = Vec<T, 3>;
 
-template <typename T> Vec<T, 3>::Vec() noexcept { }
-template <typename T> Vec<T, 3>::Vec(const Vec<T, 3>& other) noexcept { *this = other; }
-template <typename T> Vec<T, 3>::Vec(Vec<T, 3>&& other) noexcept { *this = move(other); }
-template <typename T> Vec<T, 3>::~Vec() noexcept { }
-
 template <typename T> template <typename U>
-Vec<T, 3>::Vec(const Vec<U, 3>& other) noexcept { *this = other; }
-template <typename T> template <typename U>
-Vec<T, 3>::Vec(Vec<U, 3>&& other) noexcept { *this = move(other); }
+constexpr Vec<T, 3>::Vec(const Vec<U, 3>& other) noexcept { *this = other; }
 
 template <typename T> template <typename U>
-Vec<T, 3>::Vec(const U& _x) noexcept { (*this)(_x); }
+constexpr Vec<T, 3>::Vec(const U& _x) noexcept { (*this)(_x); }
 template <typename T> template <typename U1, typename U2>
-Vec<T, 3>::Vec(const U1& _x, const U2& _y) noexcept { (*this)(_x, _y); }
+constexpr Vec<T, 3>::Vec(const U1& _x, const U2& _y) noexcept { (*this)(_x, _y); }
 template <typename T> template <typename U1, typename U2, typename U3>
-Vec<T, 3>::Vec(const U1& _x, const U2& _y, const U3& _z) noexcept { (*this)(_x, _y, _z); }
-
-template <typename T> Vec<T, 3>& Vec<T, 3>::operator=(const Vec<T, 3>& other) noexcept {
-    x = other.x;
-    y = other.y;
-    z = other.z;
-
-    return *this;
-}
-template <typename T> Vec<T, 3>& Vec<T, 3>::operator=(Vec<T, 3>&& other) noexcept {
-    x = other.x;
-    y = other.y;
-    z = other.z;
-
-    other.x = { };
-    other.y = { };
-    other.z = { };
-
-    return *this;
-}
+constexpr Vec<T, 3>::Vec(const U1& _x, const U2& _y, const U3& _z) noexcept { (*this)(_x, _y, _z); }
 
 template <typename T> template <typename U>
-Vec<T, 3>& Vec<T, 3>::operator=(const Vec<U, 3>& other) noexcept {
+constexpr Vec<T, 3>& Vec<T, 3>::operator=(const Vec<U, 3>& other) noexcept {
     x = static_cast<T>(other.x);
     y = static_cast<T>(other.y);
     z = static_cast<T>(other.z);
 
     return *this;
 }
-template <typename T> template <typename U>
-Vec<T, 3>& Vec<T, 3>::operator=(Vec<U, 3>&& other) noexcept {
-    x = static_cast<T>(other.x);
-    y = static_cast<T>(other.y);
-    z = static_cast<T>(other.z);
+template <typename T> template <typename E>
+constexpr Vec<T, 3>& Vec<T, 3>::operator=(const Expr<E>& e) noexcept {
+    static_assert((E::ROWS == 3) && (E::COLS == 1));
 
-    other.x = { };
-    other.y = { };
-    other.z = { };
+    const T _x = static_cast<T>(e[0]);
+    const T _y = static_cast<T>(e[1]);
+    const T _z = static_cast<T>(e[2]);
+
+    x = _x;
+    y = _y;
+    z = _z;
 
     return *this;
 }
 
 template <typename T> template <typename U>
-Vec<T, 3>& Vec<T, 3>::operator()(const Vec<U, 3>& other) noexcept { return (*this = other); }
+constexpr Vec<T, 3>& Vec<T, 3>::operator()(const Vec<U, 3>& other) noexcept { return (*this = other); }
 template <typename T> template <typename U>
-Vec<T, 3>& Vec<T, 3>::operator()(const U& _x) noexcept {
+constexpr Vec<T, 3>& Vec<T, 3>::operator()(const U& _x) noexcept {
     x = static_cast<T>(_x);
 
     return *this;
 }
 template <typename T> template <typename U1, typename U2>
-Vec<T, 3>& Vec<T, 3>::operator()(const U1& _x, const U2& _y) noexcept {
+constexpr Vec<T, 3>& Vec<T, 3>::operator()(const U1& _x, const U2& _y) noexcept {
     x = static_cast<T>(_x);
     y = static_cast<T>(_y);
 
     return *this;
 }
 template <typename T> template <typename U1, typename U2, typename U3>
-Vec<T, 3>& Vec<T, 3>::operator()(const U1& _x, const U2& _y, const U3& _z) noexcept {
+constexpr Vec<T, 3>& Vec<T, 3>::operator()(const U1& _x, const U2& _y, const U3& _z) noexcept {
     x = static_cast<T>(_x);
     y = static_cast<T>(_y);
     z = static_cast<T>(_z);
@@ -159,7 +144,7 @@ Vec<T, 3>& Vec<T, 3>::operator()(const U1& _x, const U2& _y, const U3& _z) noexc
     return *this;
 }
 
-template <typename T> T& Vec<T, 3>::operator[](const unsigned int& idx) {
+template <typename T> constexpr T& Vec<T, 3>::operator[](const unsigned int& idx) {
     assert(idx < 3);
 
     switch (idx) {
@@ -169,7 +154,7 @@ template <typename T> T& Vec<T, 3>::operator[](const unsigned int& idx) {
         case 2: return z;
     }
 }
-template <typename T> const T& Vec<T, 3>::operator[](const unsigned int& idx) const {
+template <typename T> constexpr const T& Vec<T, 3>::operator[](const unsigned int& idx) const {
     assert(idx < 3);
 
     switch (idx) {
@@ -181,7 +166,7 @@ template <typename T> const T& Vec<T, 3>::operator[](const unsigned int& idx) co
 }
 
 template <typename T> template <typename U>
-Vec<T, 3>& Vec<T, 3>::operator+=(const Vec<U, 3>& other) noexcept {
+constexpr Vec<T, 3>& Vec<T, 3>::operator+=(const Vec<U, 3>& other) noexcept {
     x = static_cast<T>(x + other.x);
     y = static_cast<T>(y + other.y);
     z = static_cast<T>(z + other.z);
@@ -189,7 +174,7 @@ Vec<T, 3>& Vec<T, 3>::operator+=(const Vec<U, 3>& other) noexcept {
     return *this;
 }
 template <typename T> template <typename U>
-Vec<T, 3>& Vec<T, 3>::operator-=(const Vec<U, 3>& other) noexcept {
+constexpr Vec<T, 3>& Vec<T, 3>::operator-=(const Vec<U, 3>& other) noexcept {
     x = static_cast<T>(x - other.x);
     y = static_cast<T>(y - other.y);
     z = static_cast<T>(z - other.z);
@@ -197,7 +182,7 @@ Vec<T, 3>& Vec<T, 3>::operator-=(const Vec<U, 3>& other) noexcept {
     return *this;
 }
 template <typename T> template <typename U>
-Vec<T, 3>& Vec<T, 3>::operator+=(const U& val) noexcept {
+constexpr Vec<T, 3>& Vec<T, 3>::operator+=(const U& val) noexcept {
     x = static_cast<T>(x + val);
     y = static_cast<T>(y + val);
     z = static_cast<T>(z + val);
@@ -205,7 +190,7 @@ Vec<T, 3>& Vec<T, 3>::operator+=(const U& val) noexcept {
     return *this;
 }
 template <typename T> template <typename U>
-Vec<T, 3>& Vec<T, 3>::operator-=(const U& val) noexcept {
+constexpr Vec<T, 3>& Vec<T, 3>::operator-=(const U& val) noexcept {
     x = static_cast<T>(x - val);
     y = static_cast<T>(y - val);
     z = static_cast<T>(z - val);
@@ -213,7 +198,7 @@ Vec<T, 3>& Vec<T, 3>::operator-=(const U& val) noexcept {
     return *this;
 }
 template <typename T> template <typename U>
-Vec<T, 3>& Vec<T, 3>::operator*=(const U& val) noexcept {
+constexpr Vec<T, 3>& Vec<T, 3>::operator*=(const U& val) noexcept {
     x = static_cast<T>(x * val);
     y = static_cast<T>(y * val);
     z = static_cast<T>(z * val);
@@ -221,7 +206,7 @@ Vec<T, 3>& Vec<T, 3>::operator*=(const U& val) noexcept {
     return *this;
 }
 template <typename T> template <typename U>
-Vec<T, 3>& Vec<T, 3>::operator/=(const U& val) {
+constexpr Vec<T, 3>& Vec<T, 3>::operator/=(const U& val) {
     assert(!Math::isZero(val));
 
     x = static_cast<T>(x / val);
@@ -232,7 +217,7 @@ Vec<T, 3>& Vec<T, 3>::operator/=(const U& val) {
 }
 
 template <typename T> template <typename U>
-inline Vec<T, 3> Vec<T, 3>::operator+(const Vec<U, 3>& other) const noexcept {
+inline constexpr Vec<T, 3> Vec<T, 3>::operator+(const Vec<U, 3>& other) const noexcept {
     return {
         static_cast<T>(x + other.x),
         static_cast<T>(y + other.y),
@@ -240,7 +225,7 @@ inline Vec<T, 3> Vec<T, 3>::operator+(const Vec<U, 3>& other) const noexcept {
     };
 }
 template <typename T> template <typename U>
-inline Vec<T, 3> Vec<T, 3>::operator-(const Vec<U, 3>& other) const noexcept {
+inline constexpr Vec<T, 3> Vec<T, 3>::operator-(const Vec<U, 3>& other) const noexcept {
     return {
         static_cast<T>(x - other.x),
         static_cast<T>(y - other.y),
@@ -248,7 +233,7 @@ inline Vec<T, 3> Vec<T, 3>::operator-(const Vec<U, 3>& other) const noexcept {
     };
 }
 template <typename T> template <typename U>
-inline Vec<T, 3> Vec<T, 3>::operator+(const U& val) const noexcept {
+inline constexpr Vec<T, 3> Vec<T, 3>::operator+(const U& val) const noexcept {
     return {
         static_cast<T>(x + val),
         static_cast<T>(y + val),
@@ -256,7 +241,7 @@ inline Vec<T, 3> Vec<T, 3>::operator+(const U& val) const noexcept {
     };
 }
 template <typename T> template <typename U>
-inline Vec<T, 3> Vec<T, 3>::operator-(const U& val) const noexcept {
+inline constexpr Vec<T, 3> Vec<T, 3>::operator-(const U& val) const noexcept {
     return {
         static_cast<T>(x - val),
         static_cast<T>(y - val),
@@ -264,7 +249,7 @@ inline Vec<T, 3> Vec<T, 3>::operator-(const U& val) const noexcept {
     };
 }
 template <typename T> template <typename U>
-inline Vec<T, 3> Vec<T, 3>::operator*(const U& val) const noexcept {
+inline constexpr Vec<T, 3> Vec<T, 3>::operator*(const U& val) const noexcept {
     return {
         static_cast<T>(x * val),
         static_cast<T>(y * val),
@@ -272,7 +257,7 @@ inline Vec<T, 3> Vec<T, 3>::operator*(const U& val) const noexcept {
     };
 }
 template <typename T> template <typename U>
-inline Vec<T, 3> Vec<T, 3>::operator/(const U& val) const {
+inline constexpr Vec<T, 3> Vec<T, 3>::operator/(const U& val) const {
     assert(!Math::isZero(val));
 
     return {
@@ -291,7 +276,7 @@ inline constexpr T Vec<T, 3>::dot(const Vec<U, 3>& other) const noexcept {
     );
 }
 template <typename T> template <typename U>
-inline Vec<T, 3> Vec<T, 3>::cross(const Vec<U, 3>& other) const noexcept {
+inline constexpr Vec<T, 3> Vec<T, 3>::cross(const Vec<U, 3>& other) const noexcept {
     return {
         static_cast<T>(y * other.z - z * other.y),
         static_cast<T>(z * other.x - x * other.z),
@@ -308,12 +293,46 @@ template <typename T> inline constexpr T Vec<T, 3>::lengthSquare() const noexcep
         Math::square(z)
     );
 }
+template <typename T> inline Vec<T, 3> Vec<T, 3>::fastNormalize() const noexcept {
+    static_assert(isFloat<T>);
+
+    return (*this * SIMD::rsqrt(lengthSquare()));
+}
+template <typename T> inline T Vec<T, 3>::fastLength() const noexcept {
+    static_assert(isFloat<T>);
+
+    const T sq = lengthSquare();
+
+    return (sq > 0) ? sq * SIMD::rsqrt(sq) : static_cast<T>(0);
+}
 
 template <typename T> template <typename U>
 inline constexpr T Vec<T, 3>::dot(const Vec<T, 3>& v1, const Vec<U, 3>& v2) noexcept { return v1.dot(v2); }
 template <typename T> template <typename U>
-inline Vec<T, 3> Vec<T, 3>::cross(const Vec<T, 3>& v1, const Vec<U, 3>& v2) noexcept { return v1.cross(v2); }
+inline constexpr Vec<T, 3> Vec<T, 3>::cross(const Vec<T, 3>& v1, const Vec<U, 3>& v2) noexcept { return v1.cross(v2); }
 
 template <typename T> inline Vec<T, 3> Vec<T, 3>::normalize(const Vec<T, 3>& v) noexcept { return v.normalize(); }
 template <typename T> inline constexpr T Vec<T, 3>::length(const Vec<T, 3>& v) noexcept { return v.length(); }
-template <typename T> inline constexpr T Vec<T, 3>::lengthSquare(const Vec<T, 3>& v) noexcept { return v.lengthSquare(); }
\ No newline at end of file
+template <typename T> inline constexpr T Vec<T, 3>::lengthSquare(const Vec<T, 3>& v) noexcept { return v.lengthSquare(); }
+
+template <typename T> inline Vec<T, 3> Vec<T, 3>::fastNormalize(const Vec<T, 3>& v) noexcept { return v.fastNormalize(); }
+template <typename T> inline T Vec<T, 3>::fastLength(const Vec<T, 3>& v) noexcept { return v.fastLength(); }
+template <typename T>
+inline void Vec<T, 3>::fastNormalize(const Vec<T, 3>* src, Vec<T, 3>* dst, const std::size_t& count) noexcept {
+    static_assert(isFloat<T>);
+    // copied as count * 3 lanes
+    static_assert(sizeof(Vec<T, 3>) == 3 * sizeof(T));
+
+    SIMD::blocks<T>(count, &SIMD::fastNormalize<3, T>, src, dst);
+}
+template <typename T>
+inline void Vec<T, 3>::fastLength(const Vec<T, 3>* src, T* dst, const std::size_t& count) noexcept {
+    static_assert(isFloat<T>);
+    static_assert(sizeof(Vec<T, 3>) == 3 * sizeof(T));
+
+    SIMD::blocks<T>(count, &SIMD::fastLength<3, T>, src, dst);
+}
+
+static_assert(isTriviallyCopyable<Vec3<float>>  && isStandardLayout<Vec3<float>>);
+static_assert(isTriviallyCopyable<Vec3<double>> && isStandardLayout<Vec3<double>>);
+static_assert(isTriviallyCopyable<Vec3<int>>    && isStandardLayout<Vec3<int>>);
\ No newline at end of file
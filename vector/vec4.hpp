@@ -2,70 +2,74 @@
 
 #include "../base.hpp"
 #include "../math.hpp"
+#include "../simd.hpp"
 #include "../typeHandler.hpp"
 
 #include <cassert>      // assert()
 #include <cmath>        // sqrt()
+#include <cstddef>      // size_t
 
 template <typename T>
 class Vec<T, 4> {
     public:
-        Vec() noexcept;
-        Vec(const Vec<T, 4>&) noexcept;
-        Vec(Vec<T, 4>&&) noexcept;
-        ~Vec() noexcept;
+        constexpr Vec() noexcept = default;
+        constexpr Vec(const Vec<T, 4>&) noexcept = default;
+        constexpr Vec(Vec<T, 4>&&) noexcept = default;
+        ~Vec() noexcept = default;
 
-        template <typename U> Vec(const Vec<U, 4>&) noexcept;
-        template <typename U> Vec(Vec<U, 4>&&) noexcept;
+        template <typename U> constexpr Vec(const Vec<U, 4>&) noexcept;
 
         template <typename U>
-        Vec(const U&) noexcept;
+        constexpr Vec(const U&) noexcept;
         template <typename U1, typename U2>
-        Vec(const U1&, const U2&) noexcept;
+        constexpr Vec(const U1&, const U2&) noexcept;
         template <typename U1, typename U2, typename U3>
-        Vec(const U1&, const U2&, const U3&) noexcept;
+        constexpr Vec(const U1&, const U2&, const U3&) noexcept;
         template <typename U1, typename U2, typename U3, typename U4>
-        Vec(const U1&, const U2&, const U3&, const U4&) noexcept;
+        constexpr Vec(const U1&, const U2&, const U3&, const U4&) noexcept;
 
-        Vec<T, 4>& operator=(const Vec<T, 4>&) noexcept;
-        Vec<T, 4>& operator=(Vec<T, 4>&&) noexcept;
+        constexpr Vec<T, 4>& operator=(const Vec<T, 4>&) noexcept = default;
+        constexpr Vec<T, 4>& operator=(Vec<T, 4>&&) noexcept = default;
 
-        template <typename U> Vec<T, 4>& operator=(const Vec<U, 4>&) noexcept;
-        template <typename U> Vec<T, 4>& operator=(Vec<U, 4>&&) noexcept;
+        template <typename U> constexpr Vec<T, 4>& operator=(const Vec<U, 4>&) noexcept;
+        template <typename E> constexpr Vec<T, 4>& operator=(const Expr<E>&) noexcept;
 
         template <typename U>
-        Vec<T, 4>& operator()(const Vec<U, 4>&) noexcept;
+        constexpr Vec<T, 4>& operator()(const Vec<U, 4>&) noexcept;
         template <typename U>
-        Vec<T, 4>& operator()(const U&) noexcept;
+        constexpr Vec<T, 4>& operator()(const U&) noexcept;
         template <typename U1, typename U2>
-        Vec<T, 4>& operator()(const U1&, const U2&) noexcept;
+        constexpr Vec<T, 4>& operator()(const U1&, const U2&) noexcept;
         template <typename U1, typename U2, typename U3>
-        Vec<T, 4>& operator()(const U1&, const U2&, const U3&) noexcept;
+        constexpr Vec<T, 4>& operator()(const U1&, const U2&, const U3&) noexcept;
         template <typename U1, typename U2, typename U3, typename U4>
-        Vec<T, 4>& operator()(const U1&, const U2&, const U3&, const U4&) noexcept;
+        constexpr Vec<T, 4>& operator()(const U1&, const U2&, const U3&, const U4&) noexcept;
 
-        T& operator[](const unsigned int& idx);
-        const T& operator[](const unsigned int& idx) const;
+        constexpr T& operator[](const unsigned int& idx);
+        constexpr const T& operator[](const unsigned int& idx) const;
 
-        template <typename U> Vec<T, 4>& operator+=(const Vec<U, 4>&) noexcept;
-        template <typename U> Vec<T, 4>& operator-=(const Vec<U, 4>&) noexcept;
-        template <typename U> Vec<T, 4>& operator+=(const U&) noexcept;
-        template <typename U> Vec<T, 4>& operator-=(const U&) noexcept;
-        template <typename U> Vec<T, 4>& operator*=(const U&) noexcept;
-        template <typename U> Vec<T, 4>& operator/=(const U&);
+        template <typename U> constexpr Vec<T, 4>& operator+=(const Vec<U, 4>&) noexcept;
+        template <typename U> constexpr Vec<T, 4>& operator-=(const Vec<U, 4>&) noexcept;
+        template <typename U> constexpr Vec<T, 4>& operator+=(const U&) noexcept;
+        template <typename U> constexpr Vec<T, 4>& operator-=(const U&) noexcept;
+        template <typename U> constexpr Vec<T, 4>& operator*=(const U&) noexcept;
+        template <typename U> constexpr Vec<T, 4>& operator/=(const U&);
 
-        template <typename U> inline Vec<T, 4> operator+(const Vec<U, 4>&) const noexcept;
-        template <typename U> inline Vec<T, 4> operator-(const Vec<U, 4>&) const noexcept;
-        template <typename U> inline Vec<T, 4> operator+(const U&) const noexcept;
-        template <typename U> inline Vec<T, 4> operator-(const U&) const noexcept;
-        template <typename U> inline Vec<T, 4> operator*(const U&) const noexcept;
-        template <typename U> inline Vec<T, 4> operator/(const U&) const;
+        template <typename U> inline constexpr Vec<T, 4> operator+(const Vec<U, 4>&) const noexcept;
+        template <typename U> inline constexpr Vec<T, 4> operator-(const Vec<U, 4>&) const noexcept;
+        template <typename U> inline constexpr Vec<T, 4> operator+(const U&) const noexcept;
+        template <typename U> inline constexpr Vec<T, 4> operator-(const U&) const noexcept;
+        template <typename U> inline constexpr Vec<T, 4> operator*(const U&) const noexcept;
+        template <typename U> inline constexpr Vec<T, 4> operator/(const U&) const;
 
         template <typename U> inline constexpr T dot(const Vec<U, 4>&) const noexcept;
 
         inline Vec<T, 4> normalize() const noexcept;
         inline constexpr T length() const noexcept;
         inline constexpr T lengthSquare() const noexcept;
+        // rsqrt with one Newton step (SIMD::rsqrt): under 4e-7 relative error, no zero check
+        inline Vec<T, 4> fastNormalize() const noexcept;
+        inline T fastLength() const noexcept;
 
         template <typename U> static inline constexpr T dot(const Vec<T, 4>&, const Vec<U, 4>&) noexcept;
 
@@ -73,6 +77,18 @@ class Vec<T, 4> {
         static inline constexpr T length(const Vec<T, 4>&) noexcept;
         static inline constexpr T lengthSquare(const Vec<T, 4>&) noexcept;
 
+        static inline Vec<T, 4> fastNormalize(const Vec<T, 4>&) noexcept;
+        static inline T fastLength(const Vec<T, 4>&) noexcept;
+        static inline void fastNormalize(const Vec<T, 4>* src, Vec<T, 4>* dst, const std::size_t& count) noexcept;
+        static inline void fastLength(const Vec<T, 4>* src, T* dst, const std::size_t& count) noexcept;
+
+    // the four lanes as one array for the SIMD loads and stores (x, y, z and w are separate union members)
+    private:
+        struct Lanes { T at[4]; };
+
+        inline Lanes lanes() const noexcept;
+        inline void lanes(const Lanes&) noexcept;
+
     public:
         union { T x{ }, r; };
         union { T y{ }, g; };
@@ -81,49 +97,20 @@ class Vec<T, 4> {
 };
 template <typename T> using Vec4 = Vec<T, 4>;
 
-template <typename T> Vec<T, 4>::Vec() noexcept { }
-template <typename T> Vec<T, 4>::Vec(const Vec<T, 4>& other) noexcept { *this = other; }
-template <typename T> Vec<T, 4>::Vec(Vec<T, 4>&& other) noexcept { *this = move(other); }
-template <typename T> Vec<T, 4>::~Vec() noexcept { }
-
-template <typename T> template <typename U>
-Vec<T, 4>::Vec(const Vec<U, 4>& other) noexcept { *this = other; }
 template <typename T> template <typename U>
-Vec<T, 4>::Vec(Vec<U, 4>&& other) noexcept { *this = move(other); }
+constexpr Vec<T, 4>::Vec(const Vec<U, 4>& other) noexcept { *this = other; }
 
 template <typename T> template <typename U>
-Vec<T, 4>::Vec(const U& _x) noexcept { (*this)(_x); }
+constexpr Vec<T, 4>::Vec(const U& _x) noexcept { (*this)(_x); }
 template <typename T> template <typename U1, typename U2>
-Vec<T, 4>::Vec(const U1& _x, const U2& _y) noexcept { (*this)(_x, _y); }
+constexpr Vec<T, 4>::Vec(const U1& _x, const U2& _y) noexcept { (*this)(_x, _y); }
 template <typename T> template <typename U1, typename U2, typename U3>
-Vec<T, 4>::Vec(const U1& _x, const U2& _y, const U3& _z) noexcept { (*this)(_x, _y, _z); }
+constexpr Vec<T, 4>::Vec(const U1& _x, const U2& _y, const U3& _z) noexcept { (*this)(_x, _y, _z); }
 template <typename T> template <typename U1, typename U2, typename U3, typename U4>
-Vec<T, 4>::Vec(const U1& _x, const U2& _y, const U3& _z, const U4& _w) noexcept { (*this)(_x, _y, _z, _w); }
-
-template <typename T> Vec<T, 4>& Vec<T, 4>::operator=(const Vec<T, 4>& other) noexcept {
-    x = other.x;
-    y = other.y;
-    z = other.z;
-    w = other.w;
-
-    return *this;
-}
-template <typename T> Vec<T, 4>& Vec<T, 4>::operator=(Vec<T, 4>&& other) noexcept {
-    x = other.x;
-    y = other.y;
-    z = other.z;
-    w = other.w;
-
-    other.x = { };
-    other.y = { };
-    other.z = { };
-    other.w = { };
-
-    return *this;
-}
+constexpr Vec<T, 4>::Vec(const U1& _x, const U2& _y, const U3& _z, const U4& _w) noexcept { (*this)(_x, _y, _z, _w); }
 
 template <typename T> template <typename U>
-Vec<T, 4>& Vec<T, 4>::operator=(const Vec<U, 4>& other) noexcept {
+constexpr Vec<T, 4>& Vec<T, 4>::operator=(const Vec<U, 4>& other) noexcept {
     x = static_cast<T>(other.x);
     y = static_cast<T>(other.y);
     z = static_cast<T>(other.z);
@@ -131,38 +118,40 @@ Vec<T, 4>& Vec<T, 4>::operator=(const Vec<U, 4>& other) noexcept {
 
     return *this;
 }
-template <typename T> template <typename U>
-Vec<T, 4>& Vec<T, 4>::operator=(Vec<U, 4>&& other) noexcept {
-    x = static_cast<T>(other.x);
-    y = static_cast<T>(other.y);
-    z = static_cast<T>(other.z);
-    w = static_cast<T>(other.w);
+template <typename T> template <typename E>
+constexpr Vec<T, 4>& Vec<T, 4>::operator=(const Expr<E>& e) noexcept {
+    static_assert((E::ROWS == 4) && (E::COLS == 1));
+
+    const T _x = static_cast<T>(e[0]);
+    const T _y = static_cast<T>(e[1]);
+    const T _z = static_cast<T>(e[2]);
+    const T _w = static_cast<T>(e[3]);
 
-    other.x = { };
-    other.y = { };
-    other.z = { };
-    other.w = { };
+    x = _x;
+    y = _y;
+    z = _z;
+    w = _w;
 
     return *this;
 }
 
 template <typename T> template <typename U>
-Vec<T, 4>& Vec<T, 4>::operator()(const Vec<U, 4>& other) noexcept { return (*this = other); }
+constexpr Vec<T, 4>& Vec<T, 4>::operator()(const Vec<U, 4>& other) noexcept { return (*this = other); }
 template <typename T> template <typename U>
-Vec<T, 4>& Vec<T, 4>::operator()(const U& _x) noexcept {
+constexpr Vec<T, 4>& Vec<T, 4>::operator()(const U& _x) noexcept {
     x = static_cast<T>(_x);
 
     return *this;
 }
 template <typename T> template <typename U1, typename U2>
-Vec<T, 4>& Vec<T, 4>::operator()(const U1& _x, const U2& _y) noexcept {
+constexpr Vec<T, 4>& Vec<T, 4>::operator()(const U1& _x, const U2& _y) noexcept {
     x = static_cast<T>(_x);
     y = static_cast<T>(_y);
 
     return *this;
 }
 template <typename T> template <typename U1, typename U2, typename U3>
-Vec<T, 4>& Vec<T, 4>::operator()(const U1& _x, const U2& _y, const U3& _z) noexcept {
+constexpr Vec<T, 4>& Vec<T, 4>::operator()(const U1& _x, const U2& _y, const U3& _z) noexcept {
     x = static_cast<T>(_x);
     y = static_cast<T>(_y);
     z = static_cast<T>(_z);
@@ -170,7 +159,7 @@ Vec<T, 4>& Vec<T, 4>::operator()(const U1& _x, const U2& _y, const U3& _z) noexc
     return *this;
 }
 template <typename T> template <typename U1, typename U2, typename U3, typename U4>
-Vec<T, 4>& Vec<T, 4>::operator()(const U1& _x, const U2& _y, const U3& _z, const U4& _w) noexcept {
+constexpr Vec<T, 4>& Vec<T, 4>::operator()(const U1& _x, const U2& _y, const U3& _z, const U4& _w) noexcept {
     x = static_cast<T>(_x);
     y = static_cast<T>(_y);
     z = static_cast<T>(_z);
@@ -179,7 +168,7 @@ Vec<T, 4>& Vec<T, 4>::operator()(const U1& _x, const U2& _y, const U3& _z, const
     return *this;
 }
 
-template <typename T> T& Vec<T, 4>::operator[](const unsigned int& idx) {
+template <typename T> constexpr T& Vec<T, 4>::operator[](const unsigned int& idx) {
     assert(idx < 4);
 
     switch (idx) {
@@ -190,7 +179,7 @@ template <typename T> T& Vec<T, 4>::operator[](const unsigned int& idx) {
         case 3: return w;
     }
 }
-template <typename T> const T& Vec<T, 4>::operator[](const unsigned int& idx) const {
+template <typename T> constexpr const T& Vec<T, 4>::operator[](const unsigned int& idx) const {
     assert(idx < 4);
 
     switch (idx) {
@@ -203,7 +192,17 @@ template <typename T> const T& Vec<T, 4>::operator[](const unsigned int& idx) co
 }
 
 template <typename T> template <typename U>
-Vec<T, 4>& Vec<T, 4>::operator+=(const Vec<U, 4>& other) noexcept {
+constexpr Vec<T, 4>& Vec<T, 4>::operator+=(const Vec<U, 4>& other) noexcept {
+    if constexpr (SIMD::packed4<T, U>) {
+        if (!isConstantEvaluated()) {
+            Lanes l = lanes();
+            SIMD::add4(l.at, other.lanes().at, l.at);
+            lanes(l);
+
+            return *this;
+        }
+    }
+
     x = static_cast<T>(x + other.x);
     y = static_cast<T>(y + other.y);
     z = static_cast<T>(z + other.z);
@@ -212,7 +211,17 @@ Vec<T, 4>& Vec<T, 4>::operator+=(const Vec<U, 4>& other) noexcept {
     return *this;
 }
 template <typename T> template <typename U>
-Vec<T, 4>& Vec<T, 4>::operator-=(const Vec<U, 4>& other) noexcept {
+constexpr Vec<T, 4>& Vec<T, 4>::operator-=(const Vec<U, 4>& other) noexcept {
+    if constexpr (SIMD::packed4<T, U>) {
+        if (!isConstantEvaluated()) {
+            Lanes l = lanes();
+            SIMD::sub4(l.at, other.lanes().at, l.at);
+            lanes(l);
+
+            return *this;
+        }
+    }
+
     x = static_cast<T>(x - other.x);
     y = static_cast<T>(y - other.y);
     z = static_cast<T>(z - other.z);
@@ -221,7 +230,17 @@ Vec<T, 4>& Vec<T, 4>::operator-=(const Vec<U, 4>& other) noexcept {
     return *this;
 }
 template <typename T> template <typename U>
-Vec<T, 4>& Vec<T, 4>::operator+=(const U& val) noexcept {
+constexpr Vec<T, 4>& Vec<T, 4>::operator+=(const U& val) noexcept {
+    if constexpr (SIMD::packed4Scalar<T, U>) {
+        if (!isConstantEvaluated()) {
+            Lanes l = lanes();
+            SIMD::add4(l.at, static_cast<T>(val), l.at);
+            lanes(l);
+
+            return *this;
+        }
+    }
+
     x = static_cast<T>(x + val);
     y = static_cast<T>(y + val);
     z = static_cast<T>(z + val);
@@ -230,7 +249,17 @@ Vec<T, 4>& Vec<T, 4>::operator+=(const U& val) noexcept {
     return *this;
 }
 template <typename T> template <typename U>
-Vec<T, 4>& Vec<T, 4>::operator-=(const U& val) noexcept {
+constexpr Vec<T, 4>& Vec<T, 4>::operator-=(const U& val) noexcept {
+    if constexpr (SIMD::packed4Scalar<T, U>) {
+        if (!isConstantEvaluated()) {
+            Lanes l = lanes();
+            SIMD::sub4(l.at, static_cast<T>(val), l.at);
+            lanes(l);
+
+            return *this;
+        }
+    }
+
     x = static_cast<T>(x - val);
     y = static_cast<T>(y - val);
     z = static_cast<T>(z - val);
@@ -239,7 +268,17 @@ Vec<T, 4>& Vec<T, 4>::operator-=(const U& val) noexcept {
     return *this;
 }
 template <typename T> template <typename U>
-Vec<T, 4>& Vec<T, 4>::operator*=(const U& val) noexcept {
+constexpr Vec<T, 4>& Vec<T, 4>::operator*=(const U& val) noexcept {
+    if constexpr (SIMD::packed4Scalar<T, U>) {
+        if (!isConstantEvaluated()) {
+            Lanes l = lanes();
+            SIMD::mul4(l.at, static_cast<T>(val), l.at);
+            lanes(l);
+
+            return *this;
+        }
+    }
+
     x = static_cast<T>(x * val);
     y = static_cast<T>(y * val);
     z = static_cast<T>(z * val);
@@ -248,9 +287,19 @@ Vec<T, 4>& Vec<T, 4>::operator*=(const U& val) noexcept {
     return *this;
 }
 template <typename T> template <typename U>
-Vec<T, 4>& Vec<T, 4>::operator/=(const U& val) {
+constexpr Vec<T, 4>& Vec<T, 4>::operator/=(const U& val) {
     assert(!Math::isZero(val));
 
+    if constexpr (SIMD::packed4Scalar<T, U>) {
+        if (!isConstantEvaluated()) {
+            Lanes l = lanes();
+            SIMD::div4(l.at, static_cast<T>(val), l.at);
+            lanes(l);
+
+            return *this;
+        }
+    }
+
     x = static_cast<T>(x / val);
     y = static_cast<T>(y / val);
     z = static_cast<T>(z / val);
@@ -260,7 +309,19 @@ Vec<T, 4>& Vec<T, 4>::operator/=(const U& val) {
 }
 
 template <typename T> template <typename U>
-inline Vec<T, 4> Vec<T, 4>::operator+(const Vec<U, 4>& other) const noexcept {
+inline constexpr Vec<T, 4> Vec<T, 4>::operator+(const Vec<U, 4>& other) const noexcept {
+    if constexpr (SIMD::packed4<T, U>) {
+        if (!isConstantEvaluated()) {
+            Lanes l = lanes();
+            SIMD::add4(l.at, other.lanes().at, l.at);
+
+            Vec<T, 4> result;
+            result.lanes(l);
+
+            return result;
+        }
+    }
+
     return {
         static_cast<T>(x + other.x),
         static_cast<T>(y + other.y),
@@ -269,7 +330,19 @@ inline Vec<T, 4> Vec<T, 4>::operator+(const Vec<U, 4>& other) const noexcept {
     };
 }
 template <typename T> template <typename U>
-inline Vec<T, 4> Vec<T, 4>::operator-(const Vec<U, 4>& other) const noexcept {
+inline constexpr Vec<T, 4> Vec<T, 4>::operator-(const Vec<U, 4>& other) const noexcept {
+    if constexpr (SIMD::packed4<T, U>) {
+        if (!isConstantEvaluated()) {
+            Lanes l = lanes();
+            SIMD::sub4(l.at, other.lanes().at, l.at);
+
+            Vec<T, 4> result;
+            result.lanes(l);
+
+            return result;
+        }
+    }
+
     return {
         static_cast<T>(x - other.x),
         static_cast<T>(y - other.y),
@@ -278,7 +351,19 @@ inline Vec<T, 4> Vec<T, 4>::operator-(const Vec<U, 4>& other) const noexcept {
     };
 }
 template <typename T> template <typename U>
-inline Vec<T, 4> Vec<T, 4>::operator+(const U& val) const noexcept {
+inline constexpr Vec<T, 4> Vec<T, 4>::operator+(const U& val) const noexcept {
+    if constexpr (SIMD::packed4Scalar<T, U>) {
+        if (!isConstantEvaluated()) {
+            Lanes l = lanes();
+            SIMD::add4(l.at, static_cast<T>(val), l.at);
+
+            Vec<T, 4> result;
+            result.lanes(l);
+
+            return result;
+        }
+    }
+
     return {
         static_cast<T>(x + val),
         static_cast<T>(y + val),
@@ -287,7 +372,19 @@ inline Vec<T, 4> Vec<T, 4>::operator+(const U& val) const noexcept {
     };
 }
 template <typename T> template <typename U>
-inline Vec<T, 4> Vec<T, 4>::operator-(const U& val) const noexcept {
+inline constexpr Vec<T, 4> Vec<T, 4>::operator-(const U& val) const noexcept {
+    if constexpr (SIMD::packed4Scalar<T, U>) {
+        if (!isConstantEvaluated()) {
+            Lanes l = lanes();
+            SIMD::sub4(l.at, static_cast<T>(val), l.at);
+
+            Vec<T, 4> result;
+            result.lanes(l);
+
+            return result;
+        }
+    }
+
     return {
         static_cast<T>(x - val),
         static_cast<T>(y - val),
@@ -296,7 +393,19 @@ inline Vec<T, 4> Vec<T, 4>::operator-(const U& val) const noexcept {
     };
 }
 template <typename T> template <typename U>
-inline Vec<T, 4> Vec<T, 4>::operator*(const U& val) const noexcept {
+inline constexpr Vec<T, 4> Vec<T, 4>::operator*(const U& val) const noexcept {
+    if constexpr (SIMD::packed4Scalar<T, U>) {
+        if (!isConstantEvaluated()) {
+            Lanes l = lanes();
+            SIMD::mul4(l.at, static_cast<T>(val), l.at);
+
+            Vec<T, 4> result;
+            result.lanes(l);
+
+            return result;
+        }
+    }
+
     return {
         static_cast<T>(x * val),
         static_cast<T>(y * val),
@@ -305,9 +414,21 @@ inline Vec<T, 4> Vec<T, 4>::operator*(const U& val) const noexcept {
     };
 }
 template <typename T> template <typename U>
-inline Vec<T, 4> Vec<T, 4>::operator/(const U& val) const {
+inline constexpr Vec<T, 4> Vec<T, 4>::operator/(const U& val) const {
     assert(!Math::isZero(val));
 
+    if constexpr (SIMD::packed4Scalar<T, U>) {
+        if (!isConstantEvaluated()) {
+            Lanes l = lanes();
+            SIMD::div4(l.at, static_cast<T>(val), l.at);
+
+            Vec<T, 4> result;
+            result.lanes(l);
+
+            return result;
+        }
+    }
+
     return {
         static_cast<T>(x / val),
         static_cast<T>(y / val),
@@ -318,6 +439,11 @@ inline Vec<T, 4> Vec<T, 4>::operator/(const U& val) const {
 
 template <typename T> template <typename U>
 inline constexpr T Vec<T, 4>::dot(const Vec<U, 4>& other) const noexcept {
+    if constexpr (SIMD::packed4<T, U>) {
+        if (!isConstantEvaluated())
+            return SIMD::dot4(lanes().at, other.lanes().at);
+    }
+
     return static_cast<T>(
         x * other.x +
         y * other.y +
@@ -326,9 +452,31 @@ inline constexpr T Vec<T, 4>::dot(const Vec<U, 4>& other) const noexcept {
     );
 }
 
-template <typename T> inline Vec<T, 4> Vec<T, 4>::normalize() const noexcept { return (*this / length()); }
+template <typename T> inline Vec<T, 4> Vec<T, 4>::normalize() const noexcept {
+    if constexpr (SIMD::has4<T>) {
+        assert(!Math::isZero(lengthSquare()));
+
+        Lanes l = lanes();
+        SIMD::normalize4(l.at, l.at);
+
+        Vec<T, 4> result;
+        result.lanes(l);
+
+        return result;
+    }
+
+    return (*this / length());
+}
 template <typename T> inline constexpr T Vec<T, 4>::length() const noexcept { return static_cast<T>(std::sqrt(lengthSquare())); }
 template <typename T> inline constexpr T Vec<T, 4>::lengthSquare() const noexcept {
+    if constexpr (SIMD::has4<T>) {
+        if (!isConstantEvaluated()) {
+            const Lanes l = lanes();
+
+            return SIMD::dot4(l.at, l.at);
+        }
+    }
+
     return (
         Math::square(x) +
         Math::square(y) +
@@ -336,10 +484,52 @@ template <typename T> inline constexpr T Vec<T, 4>::lengthSquare() const noexcep
         Math::square(w)
     );
 }
+template <typename T> inline Vec<T, 4> Vec<T, 4>::fastNormalize() const noexcept {
+    static_assert(isFloat<T>);
+
+    return (*this * SIMD::rsqrt(lengthSquare()));
+}
+template <typename T> inline T Vec<T, 4>::fastLength() const noexcept {
+    static_assert(isFloat<T>);
+
+    const T sq = lengthSquare();
+
+    return (sq > 0) ? sq * SIMD::rsqrt(sq) : static_cast<T>(0);
+}
 
 template <typename T> template <typename U>
 inline constexpr T Vec<T, 4>::dot(const Vec<T, 4>& v1, const Vec<U, 4>& v2) noexcept { return v1.dot(v2); }
 
 template <typename T> inline Vec<T, 4> Vec<T, 4>::normalize(const Vec<T, 4>& v) noexcept { return v.normalize(); }
 template <typename T> inline constexpr T Vec<T, 4>::length(const Vec<T, 4>& v) noexcept { return v.length(); }
-template <typename T> inline constexpr T Vec<T, 4>::lengthSquare(const Vec<T, 4>& v) noexcept { return v.lengthSquare(); }
\ No newline at end of file
+template <typename T> inline constexpr T Vec<T, 4>::lengthSquare(const Vec<T, 4>& v) noexcept { return v.lengthSquare(); }
+
+template <typename T> inline Vec<T, 4> Vec<T, 4>::fastNormalize(const Vec<T, 4>& v) noexcept { return v.fastNormalize(); }
+template <typename T> inline T Vec<T, 4>::fastLength(const Vec<T, 4>& v) noexcept { return v.fastLength(); }
+template <typename T> inline typename Vec<T, 4>::Lanes Vec<T, 4>::lanes() const noexcept { return { { x, y, z, w } }; }
+template <typename T> inline void Vec<T, 4>::lanes(const Lanes& l) noexcept {
+    x = l.at[0];
+    y = l.at[1];
+    z = l.at[2];
+    w = l.at[3];
+}
+
+template <typename T>
+inline void Vec<T, 4>::fastNormalize(const Vec<T, 4>* src, Vec<T, 4>* dst, const std::size_t& count) noexcept {
+    static_assert(isFloat<T>);
+    // copied as count * 4 lanes
+    static_assert(sizeof(Vec<T, 4>) == 4 * sizeof(T));
+
+    SIMD::blocks<T>(count, &SIMD::fastNormalize<4, T>, src, dst);
+}
+template <typename T>
+inline void Vec<T, 4>::fastLength(const Vec<T, 4>* src, T* dst, const std::size_t& count) noexcept {
+    static_assert(isFloat<T>);
+    static_assert(sizeof(Vec<T, 4>) == 4 * sizeof(T));
+
+    SIMD::blocks<T>(count, &SIMD::fastLength<4, T>, src, dst);
+}
+
+static_assert(isTriviallyCopyable<Vec4<float>>  && isStandardLayout<Vec4<float>>);
+static_assert(isTriviallyCopyable<Vec4<double>> && isStandardLayout<Vec4<double>>);
+static_assert(isTriviallyCopyable<Vec4<int>>    && isStandardLayout<Vec4<int>>);
\ No newline at end of file
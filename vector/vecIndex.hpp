@@ -0,0 +1,379 @@
+#pragma once
+
+#include "../aligned.hpp"
+#include "../base.hpp"
+#include "../math.hpp"
+#include "../parallel.hpp"
+#include "../simd.hpp"
+#include "../typeHandler.hpp"
+#include "vecN.hpp"
+
+#include <algorithm>    // push_heap(), pop_heap(), sort_heap()
+#include <cassert>      // assert()
+#include <cmath>        // sqrt(), lround()
+#include <cstddef>      // size_t
+#include <vector>       // vector
+
+// Brute-force k-nearest search over vectors stored back to back. Every stored vector is
+// scored against the query with SIMD::dotN and the best k are kept in a bounded heap; the
+// stored range is split across threads, each with its own heap, merged at the end.
+//
+// Storage::INT8 also keeps one signed byte per lane (plus a scale per vector) and scans
+// those instead, a quarter of the float traffic; the best k * rerank candidates of that
+// scan are then scored again on the T lanes.
+template <typename T, unsigned int DIM>
+class VecIndex {
+    static_assert(isFloat<T> && DIM > 0);
+
+    public:
+        enum class Metric: unsigned char { COSINE, L2 };
+        enum class Storage: unsigned char { FULL, INT8 };
+
+        // COSINE: the cosine similarity, L2: the squared distance (best first for both)
+        struct Hit {
+            std::size_t index;
+            T score;
+        };
+
+        inline static constexpr std::size_t ALIGNMENT = Aligned::ALIGNMENT;
+        // index of the hits left over when fewer than k vectors are stored
+        inline static constexpr std::size_t NONE = static_cast<std::size_t>(-1);
+        // smallest share of the stored vectors a search thread scans
+        inline static constexpr std::size_t MIN_PER_THREAD = 16'384;
+
+    public:
+        explicit VecIndex(const Metric& = Metric::COSINE, const Storage& = Storage::FULL, const unsigned int& rerank = 4) noexcept;
+        VecIndex(const VecIndex<T, DIM>&) = delete;
+        VecIndex(VecIndex<T, DIM>&&) noexcept;
+        ~VecIndex() noexcept;
+
+        VecIndex<T, DIM>& operator=(const VecIndex<T, DIM>&) = delete;
+        VecIndex<T, DIM>& operator=(VecIndex<T, DIM>&&) noexcept;
+
+        // stored lanes of vector idx (normalized under COSINE)
+        inline const T* operator[](const std::size_t& idx) const;
+
+        void reserve(const std::size_t& count);
+        void add(const Vec<T, DIM>* src, const std::size_t& count);
+        inline void add(const Vec<T, DIM>&);
+        inline void clear() noexcept;
+
+        inline std::size_t size() const noexcept;
+        inline std::size_t capacity() const noexcept;
+
+        // writes the best min(k, size()) hits and returns their count, threads = 0 uses every hardware thread
+        std::size_t search(const Vec<T, DIM>& query, const std::size_t& k, Hit* out, const unsigned int& threads = 0) const;
+        // hits of queries[i] at out + i * k, the queries split across threads
+        void search(const Vec<T, DIM>* queries, const std::size_t& count, const std::size_t& k, Hit* out, const unsigned int& threads = 0) const;
+
+    private:
+        // the query as the scans need it
+        struct Query {
+            T lane[DIM];
+            T lengthSquare;
+            signed char code[DIM];
+            T scale;
+        };
+
+        inline void prepare(const Vec<T, DIM>&, Query&) const;
+
+        // higher is better: COSINE q . x, L2 2 q . x - |x|^2 (|q|^2 - distance)
+        inline T score(const Query&, const std::size_t& idx) const noexcept;
+        // the same from the int8 lanes
+        inline T approximate(const Query&, const std::size_t& idx) const noexcept;
+
+        // best `capacity` of [begin, end) into heap
+        void scan(const Query&, const std::size_t& begin, const std::size_t& end, const std::size_t& capacity, std::vector<Hit>& heap) const;
+        std::size_t searchOne(const Query&, const std::size_t& k, Hit* out, const unsigned int& threads) const;
+
+        static inline bool better(const Hit&, const Hit&) noexcept;
+        // keeps the best `capacity` hits, the worst of them on top
+        static inline void offer(std::vector<Hit>& heap, const std::size_t& capacity, const Hit&);
+
+        static inline void quantize(const T* lanes, signed char* code, T& scale) noexcept;
+
+        void allocate(const std::size_t& count);
+        void release() noexcept;
+
+    private:
+        Metric mMetric{ };
+        Storage mStorage{ };
+        unsigned int mRerank{ };
+
+        T* mLane{ };                // DIM per vector
+        T* mLengthSquare{ };        // L2
+        signed char* mCode{ };      // INT8: DIM per vector
+        T* mScale{ };               // INT8
+
+        std::size_t mSize{ };
+        std::size_t mCapacity{ };
+};
+
+template <typename T, unsigned int DIM>
+VecIndex<T, DIM>::VecIndex(const Metric& metric, const Storage& storage, const unsigned int& rerank) noexcept
+    : mMetric{metric}, mStorage{storage}, mRerank{(rerank == 0) ? 1 : rerank} { }
+template <typename T, unsigned int DIM>
+VecIndex<T, DIM>::VecIndex(VecIndex<T, DIM>&& other) noexcept { *this = move(other); }
+template <typename T, unsigned int DIM>
+VecIndex<T, DIM>::~VecIndex() noexcept { release(); }
+
+template <typename T, unsigned int DIM>
+VecIndex<T, DIM>& VecIndex<T, DIM>::operator=(VecIndex<T, DIM>&& other) noexcept {
+    if (this == &other)
+        return *this;
+
+    release();
+
+    mMetric       = other.mMetric;
+    mStorage      = other.mStorage;
+    mRerank       = other.mRerank;
+    mLane         = other.mLane;
+    mLengthSquare = other.mLengthSquare;
+    mCode         = other.mCode;
+    mScale        = other.mScale;
+    mSize         = other.mSize;
+    mCapacity     = other.mCapacity;
+
+    other.mLane         = nullptr;
+    other.mLengthSquare = nullptr;
+    other.mCode         = nullptr;
+    other.mScale        = nullptr;
+    other.mSize         = 0;
+    other.mCapacity     = 0;
+
+    return *this;
+}
+
+template <typename T, unsigned int DIM>
+inline const T* VecIndex<T, DIM>::operator[](const std::size_t& idx) const {
+    assert(idx < mSize);
+
+    return mLane + idx * DIM;
+}
+
+template <typename T, unsigned int DIM>
+void VecIndex<T, DIM>::reserve(const std::size_t& count) {
+    if (count <= mCapacity)
+        return;
+
+    VecIndex<T, DIM> grown{ mMetric, mStorage, mRerank };
+    grown.allocate(count);
+
+    for (std::size_t i = 0; i < mSize * DIM; ++i)
+        grown.mLane[i] = mLane[i];
+    for (std::size_t i = 0; i < mSize; ++i)
+        grown.mLengthSquare[i] = mLengthSquare[i];
+    if (mStorage == Storage::INT8) {
+        for (std::size_t i = 0; i < mSize * DIM; ++i)
+            grown.mCode[i] = mCode[i];
+        for (std::size_t i = 0; i < mSize; ++i)
+            grown.mScale[i] = mScale[i];
+    }
+
+    grown.mSize = mSize;
+    *this = move(grown);
+}
+template <typename T, unsigned int DIM>
+void VecIndex<T, DIM>::add(const Vec<T, DIM>* src, const std::size_t& count) {
+    if (mSize + count > mCapacity)
+        reserve((mSize + count > 2 * mCapacity) ? mSize + count : 2 * mCapacity);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::size_t idx = mSize + i;
+        const T* from = &src[i][0];
+        T* lane = mLane + idx * DIM;
+
+        T sq = SIMD::dotN(from, from, DIM);
+        if (mMetric == Metric::COSINE) {
+            assert(!Math::isZero(sq));
+
+            const T inv = static_cast<T>(1) / static_cast<T>(std::sqrt(sq));
+            for (unsigned int d = 0; d < DIM; ++d)
+                lane[d] = from[d] * inv;
+
+            sq = static_cast<T>(1);
+        }
+        else {
+            for (unsigned int d = 0; d < DIM; ++d)
+                lane[d] = from[d];
+        }
+
+        mLengthSquare[idx] = sq;
+        if (mStorage == Storage::INT8)
+            quantize(lane, mCode + idx * DIM, mScale[idx]);
+    }
+
+    mSize += count;
+}
+template <typename T, unsigned int DIM>
+inline void VecIndex<T, DIM>::add(const Vec<T, DIM>& v) { add(&v, 1); }
+template <typename T, unsigned int DIM>
+inline void VecIndex<T, DIM>::clear() noexcept { mSize = 0; }
+
+template <typename T, unsigned int DIM>
+inline std::size_t VecIndex<T, DIM>::size() const noexcept { return mSize; }
+template <typename T, unsigned int DIM>
+inline std::size_t VecIndex<T, DIM>::capacity() const noexcept { return mCapacity; }
+
+template <typename T, unsigned int DIM>
+std::size_t VecIndex<T, DIM>::search(const Vec<T, DIM>& query, const std::size_t& k, Hit* out, const unsigned int& threads) const {
+    Query q;
+    prepare(query, q);
+
+    return searchOne(q, k, out, threads);
+}
+template <typename T, unsigned int DIM>
+void VecIndex<T, DIM>::search(const Vec<T, DIM>* queries, const std::size_t& count, const std::size_t& k, Hit* out, const unsigned int& threads) const {
+    const auto run = [&](const std::size_t& begin, const std::size_t& end) {
+        Query q;
+
+        for (std::size_t i = begin; i < end; ++i) {
+            prepare(queries[i], q);
+
+            const std::size_t found = searchOne(q, k, out + i * k, 1);
+            for (std::size_t j = found; j < k; ++j)
+                out[i * k + j] = { NONE, static_cast<T>(0) };
+        }
+    };
+
+    // whole queries per worker
+    const unsigned int workers = Parallel::workers(threads, count * mSize, MIN_PER_THREAD, count);
+
+    Parallel::run(workers, [&](const unsigned int& t) { run(count * t / workers, count * (t + 1) / workers); });
+}
+
+template <typename T, unsigned int DIM>
+inline void VecIndex<T, DIM>::prepare(const Vec<T, DIM>& query, Query& q) const {
+    const T* from = &query[0];
+
+    q.lengthSquare = SIMD::dotN(from, from, DIM);
+
+    const T scale = (mMetric == Metric::COSINE) ? static_cast<T>(1) / static_cast<T>(std::sqrt(q.lengthSquare)) : static_cast<T>(1);
+    assert(mMetric == Metric::L2 || !Math::isZero(q.lengthSquare));
+
+    for (unsigned int d = 0; d < DIM; ++d)
+        q.lane[d] = from[d] * scale;
+
+    if (mStorage == Storage::INT8)
+        quantize(q.lane, q.code, q.scale);
+}
+
+template <typename T, unsigned int DIM>
+inline T VecIndex<T, DIM>::score(const Query& q, const std::size_t& idx) const noexcept {
+    const T dot = SIMD::dotN(q.lane, mLane + idx * DIM, DIM);
+
+    return (mMetric == Metric::COSINE) ? dot : 2 * dot - mLengthSquare[idx];
+}
+template <typename T, unsigned int DIM>
+inline T VecIndex<T, DIM>::approximate(const Query& q, const std::size_t& idx) const noexcept {
+    const T dot = q.scale * mScale[idx] * static_cast<T>(SIMD::dotN(q.code, mCode + idx * DIM, DIM));
+
+    return (mMetric == Metric::COSINE) ? dot : 2 * dot - mLengthSquare[idx];
+}
+
+template <typename T, unsigned int DIM>
+void VecIndex<T, DIM>::scan(const Query& q, const std::size_t& begin, const std::size_t& end, const std::size_t& capacity, std::vector<Hit>& heap) const {
+    heap.reserve(capacity);
+
+    if (mStorage == Storage::INT8) {
+        for (std::size_t i = begin; i < end; ++i)
+            offer(heap, capacity, { i, approximate(q, i) });
+    }
+    else {
+        for (std::size_t i = begin; i < end; ++i)
+            offer(heap, capacity, { i, score(q, i) });
+    }
+}
+template <typename T, unsigned int DIM>
+std::size_t VecIndex<T, DIM>::searchOne(const Query& q, const std::size_t& k, Hit* out, const unsigned int& threads) const {
+    if (k == 0 || mSize == 0)
+        return 0;
+
+    const std::size_t capacity = (mStorage == Storage::INT8) ? k * mRerank : k;
+    const unsigned int workers = Parallel::workers(threads, mSize, MIN_PER_THREAD);
+
+    std::vector<std::vector<Hit>> heaps(workers);
+    Parallel::run(workers, [&](const unsigned int& t) { scan(q, mSize * t / workers, mSize * (t + 1) / workers, capacity, heaps[t]); });
+
+    std::vector<Hit> best;
+    best.reserve(k);
+
+    // INT8: the candidates are scored again on the T lanes
+    for (const std::vector<Hit>& heap: heaps) {
+        for (const Hit& hit: heap)
+            offer(best, k, (mStorage == Storage::INT8) ? Hit{ hit.index, score(q, hit.index) } : hit);
+    }
+
+    std::sort_heap(best.begin(), best.end(), better);
+
+    for (std::size_t i = 0; i < best.size(); ++i) {
+        out[i] = best[i];
+
+        if (mMetric == Metric::L2)
+            out[i].score = q.lengthSquare - best[i].score;
+    }
+
+    return best.size();
+}
+
+// ties go to the lower index, so results do not depend on the thread split
+template <typename T, unsigned int DIM>
+inline bool VecIndex<T, DIM>::better(const Hit& a, const Hit& b) noexcept { return (a.score > b.score) || (a.score == b.score && a.index < b.index); }
+template <typename T, unsigned int DIM>
+inline void VecIndex<T, DIM>::offer(std::vector<Hit>& heap, const std::size_t& capacity, const Hit& hit) {
+    if (heap.size() < capacity) {
+        heap.push_back(hit);
+        std::push_heap(heap.begin(), heap.end(), better);
+    }
+    else if (better(hit, heap.front())) {
+        std::pop_heap(heap.begin(), heap.end(), better);
+        heap.back() = hit;
+        std::push_heap(heap.begin(), heap.end(), better);
+    }
+}
+
+// symmetric per vector: the largest magnitude maps to 127
+template <typename T, unsigned int DIM>
+inline void VecIndex<T, DIM>::quantize(const T* lanes, signed char* code, T& scale) noexcept {
+    T peak = static_cast<T>(0);
+    for (unsigned int d = 0; d < DIM; ++d)
+        peak = (Math::abs(lanes[d]) > peak) ? Math::abs(lanes[d]) : peak;
+
+    scale = peak / 127;
+
+    const T inv = (peak > 0) ? 127 / peak : static_cast<T>(0);
+    for (unsigned int d = 0; d < DIM; ++d)
+        code[d] = static_cast<signed char>(std::lround(lanes[d] * inv));
+}
+
+template <typename T, unsigned int DIM>
+void VecIndex<T, DIM>::allocate(const std::size_t& count) {
+    release();
+
+    if (count == 0)
+        return;
+
+    mLane         = Aligned::allocate<T>(count * DIM);
+    mLengthSquare = Aligned::allocate<T>(count);
+    if (mStorage == Storage::INT8) {
+        mCode  = Aligned::allocate<signed char>(count * DIM);
+        mScale = Aligned::allocate<T>(count);
+    }
+
+    mCapacity = count;
+}
+template <typename T, unsigned int DIM>
+void VecIndex<T, DIM>::release() noexcept {
+    Aligned::release(mLane);
+    Aligned::release(mLengthSquare);
+    Aligned::release(mCode);
+    Aligned::release(mScale);
+
+    mLane         = nullptr;
+    mLengthSquare = nullptr;
+    mCode         = nullptr;
+    mScale        = nullptr;
+
+    mSize     = 0;
+    mCapacity = 0;
+}
\ No newline at end of file
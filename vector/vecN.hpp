@@ -0,0 +1,289 @@
+#pragma once
+
+#include "../base.hpp"
+#include "../math.hpp"
+#include "../simd.hpp"
+#include "../typeHandler.hpp"
+#include "vec2.hpp"
+#include "vec3.hpp"
+#include "vec4.hpp"
+
+#include <cassert>      // assert()
+#include <cmath>        // sqrt()
+#include <cstddef>      // size_t
+
+// Vec<T, DIM> of any width above 4 (feature / embedding vectors): the lanes are one array
+// and every operation is a loop over DIM, run four lanes per register by the SIMD::...N
+// kernels. Vec<T, 2 / 3 / 4> keep their own specializations.
+template <typename T, unsigned int DIM>
+class Vec<T, DIM> {
+    static_assert(DIM > 4);
+
+    public:
+        constexpr Vec() noexcept = default;
+        constexpr Vec(const Vec<T, DIM>&) noexcept = default;
+        constexpr Vec(Vec<T, DIM>&&) noexcept = default;
+        ~Vec() noexcept = default;
+
+        template <typename U> constexpr Vec(const Vec<U, DIM>&) noexcept;
+        template <typename U> explicit constexpr Vec(const U (&)[DIM]) noexcept;
+
+        // leading lanes, the rest stay zero
+        template <typename... U, typename = enableIF<(sizeof...(U) <= DIM) && (isArithmetic<U> && ...)>>
+        constexpr Vec(const U&...) noexcept;
+
+        constexpr Vec<T, DIM>& operator=(const Vec<T, DIM>&) noexcept = default;
+        constexpr Vec<T, DIM>& operator=(Vec<T, DIM>&&) noexcept = default;
+
+        template <typename U> constexpr Vec<T, DIM>& operator=(const Vec<U, DIM>&) noexcept;
+        template <typename E> constexpr Vec<T, DIM>& operator=(const Expr<E>&) noexcept;
+
+        template <typename U>
+        constexpr Vec<T, DIM>& operator()(const Vec<U, DIM>&) noexcept;
+        template <typename... U, typename = enableIF<(sizeof...(U) <= DIM) && (isArithmetic<U> && ...)>>
+        constexpr Vec<T, DIM>& operator()(const U&...) noexcept;
+
+        constexpr T& operator[](const unsigned int& idx);
+        constexpr const T& operator[](const unsigned int& idx) const;
+
+        template <typename U> constexpr Vec<T, DIM>& operator+=(const Vec<U, DIM>&) noexcept;
+        template <typename U> constexpr Vec<T, DIM>& operator-=(const Vec<U, DIM>&) noexcept;
+        template <typename U> constexpr Vec<T, DIM>& operator+=(const U&) noexcept;
+        template <typename U> constexpr Vec<T, DIM>& operator-=(const U&) noexcept;
+        template <typename U> constexpr Vec<T, DIM>& operator*=(const U&) noexcept;
+        template <typename U> constexpr Vec<T, DIM>& operator/=(const U&);
+
+        template <typename U> inline constexpr Vec<T, DIM> operator+(const Vec<U, DIM>&) const noexcept;
+        template <typename U> inline constexpr Vec<T, DIM> operator-(const Vec<U, DIM>&) const noexcept;
+        template <typename U> inline constexpr Vec<T, DIM> operator+(const U&) const noexcept;
+        template <typename U> inline constexpr Vec<T, DIM> operator-(const U&) const noexcept;
+        template <typename U> inline constexpr Vec<T, DIM> operator*(const U&) const noexcept;
+        template <typename U> inline constexpr Vec<T, DIM> operator/(const U&) const;
+
+        template <typename U> inline constexpr T dot(const Vec<U, DIM>&) const noexcept;
+
+        inline Vec<T, DIM> normalize() const noexcept;
+        inline constexpr T length() const noexcept;
+        inline constexpr T lengthSquare() const noexcept;
+
+        template <typename U> static inline constexpr T dot(const Vec<T, DIM>&, const Vec<U, DIM>&) noexcept;
+
+        static inline Vec<T, DIM> normalize(const Vec<T, DIM>&) noexcept;
+        static inline constexpr T length(const Vec<T, DIM>&) noexcept;
+        static inline constexpr T lengthSquare(const Vec<T, DIM>&) noexcept;
+
+    public:
+        T mLANE[DIM]{ };
+};
+template <typename T, unsigned int DIM> using VecN = Vec<T, DIM>;
+
+template <typename T, unsigned int DIM> template <typename U>
+constexpr Vec<T, DIM>::Vec(const Vec<U, DIM>& other) noexcept { *this = other; }
+template <typename T, unsigned int DIM> template <typename U>
+constexpr Vec<T, DIM>::Vec(const U (&lanes)[DIM]) noexcept {
+    for (unsigned int i = 0; i < DIM; ++i)
+        mLANE[i] = static_cast<T>(lanes[i]);
+}
+template <typename T, unsigned int DIM> template <typename... U, typename>
+constexpr Vec<T, DIM>::Vec(const U&... lanes) noexcept { (*this)(lanes...); }
+
+template <typename T, unsigned int DIM> template <typename U>
+constexpr Vec<T, DIM>& Vec<T, DIM>::operator=(const Vec<U, DIM>& other) noexcept {
+    for (unsigned int i = 0; i < DIM; ++i)
+        mLANE[i] = static_cast<T>(other.mLANE[i]);
+
+    return *this;
+}
+template <typename T, unsigned int DIM> template <typename E>
+constexpr Vec<T, DIM>& Vec<T, DIM>::operator=(const Expr<E>& e) noexcept {
+    static_assert((E::ROWS == DIM) && (E::COLS == 1));
+
+    T lanes[DIM]{ };
+    for (unsigned int i = 0; i < DIM; ++i)
+        lanes[i] = static_cast<T>(e[i]);
+
+    for (unsigned int i = 0; i < DIM; ++i)
+        mLANE[i] = lanes[i];
+
+    return *this;
+}
+
+template <typename T, unsigned int DIM> template <typename U>
+constexpr Vec<T, DIM>& Vec<T, DIM>::operator()(const Vec<U, DIM>& other) noexcept { return (*this = other); }
+template <typename T, unsigned int DIM> template <typename... U, typename>
+constexpr Vec<T, DIM>& Vec<T, DIM>::operator()(const U&... lanes) noexcept {
+    unsigned int i = 0;
+    ((mLANE[i++] = static_cast<T>(lanes)), ...);
+
+    return *this;
+}
+
+template <typename T, unsigned int DIM> constexpr T& Vec<T, DIM>::operator[](const unsigned int& idx) {
+    assert(idx < DIM);
+
+    return mLANE[idx];
+}
+template <typename T, unsigned int DIM> constexpr const T& Vec<T, DIM>::operator[](const unsigned int& idx) const {
+    assert(idx < DIM);
+
+    return mLANE[idx];
+}
+
+template <typename T, unsigned int DIM> template <typename U>
+constexpr Vec<T, DIM>& Vec<T, DIM>::operator+=(const Vec<U, DIM>& other) noexcept {
+    if constexpr (SIMD::packed4<T, U>) {
+        if (!isConstantEvaluated()) {
+            SIMD::addN(mLANE, other.mLANE, mLANE, DIM);
+
+            return *this;
+        }
+    }
+
+    for (unsigned int i = 0; i < DIM; ++i)
+        mLANE[i] = static_cast<T>(mLANE[i] + other.mLANE[i]);
+
+    return *this;
+}
+template <typename T, unsigned int DIM> template <typename U>
+constexpr Vec<T, DIM>& Vec<T, DIM>::operator-=(const Vec<U, DIM>& other) noexcept {
+    if constexpr (SIMD::packed4<T, U>) {
+        if (!isConstantEvaluated()) {
+            SIMD::subN(mLANE, other.mLANE, mLANE, DIM);
+
+            return *this;
+        }
+    }
+
+    for (unsigned int i = 0; i < DIM; ++i)
+        mLANE[i] = static_cast<T>(mLANE[i] - other.mLANE[i]);
+
+    return *this;
+}
+template <typename T, unsigned int DIM> template <typename U>
+constexpr Vec<T, DIM>& Vec<T, DIM>::operator+=(const U& val) noexcept {
+    if constexpr (SIMD::packed4Scalar<T, U>) {
+        if (!isConstantEvaluated()) {
+            SIMD::addN(mLANE, static_cast<T>(val), mLANE, DIM);
+
+            return *this;
+        }
+    }
+
+    for (unsigned int i = 0; i < DIM; ++i)
+        mLANE[i] = static_cast<T>(mLANE[i] + val);
+
+    return *this;
+}
+template <typename T, unsigned int DIM> template <typename U>
+constexpr Vec<T, DIM>& Vec<T, DIM>::operator-=(const U& val) noexcept {
+    if constexpr (SIMD::packed4Scalar<T, U>) {
+        if (!isConstantEvaluated()) {
+            SIMD::subN(mLANE, static_cast<T>(val), mLANE, DIM);
+
+            return *this;
+        }
+    }
+
+    for (unsigned int i = 0; i < DIM; ++i)
+        mLANE[i] = static_cast<T>(mLANE[i] - val);
+
+    return *this;
+}
+template <typename T, unsigned int DIM> template <typename U>
+constexpr Vec<T, DIM>& Vec<T, DIM>::operator*=(const U& val) noexcept {
+    if constexpr (SIMD::packed4Scalar<T, U>) {
+        if (!isConstantEvaluated()) {
+            SIMD::mulN(mLANE, static_cast<T>(val), mLANE, DIM);
+
+            return *this;
+        }
+    }
+
+    for (unsigned int i = 0; i < DIM; ++i)
+        mLANE[i] = static_cast<T>(mLANE[i] * val);
+
+    return *this;
+}
+template <typename T, unsigned int DIM> template <typename U>
+constexpr Vec<T, DIM>& Vec<T, DIM>::operator/=(const U& val) {
+    assert(!Math::isZero(val));
+
+    if constexpr (SIMD::packed4Scalar<T, U>) {
+        if (!isConstantEvaluated()) {
+            SIMD::divN(mLANE, static_cast<T>(val), mLANE, DIM);
+
+            return *this;
+        }
+    }
+
+    for (unsigned int i = 0; i < DIM; ++i)
+        mLANE[i] = static_cast<T>(mLANE[i] / val);
+
+    return *this;
+}
+
+template <typename T, unsigned int DIM> template <typename U>
+inline constexpr Vec<T, DIM> Vec<T, DIM>::operator+(const Vec<U, DIM>& other) const noexcept {
+    Vec<T, DIM> result{ *this };
+
+    return (result += other);
+}
+template <typename T, unsigned int DIM> template <typename U>
+inline constexpr Vec<T, DIM> Vec<T, DIM>::operator-(const Vec<U, DIM>& other) const noexcept {
+    Vec<T, DIM> result{ *this };
+
+    return (result -= other);
+}
+template <typename T, unsigned int DIM> template <typename U>
+inline constexpr Vec<T, DIM> Vec<T, DIM>::operator+(const U& val) const noexcept {
+    Vec<T, DIM> result{ *this };
+
+    return (result += val);
+}
+template <typename T, unsigned int DIM> template <typename U>
+inline constexpr Vec<T, DIM> Vec<T, DIM>::operator-(const U& val) const noexcept {
+    Vec<T, DIM> result{ *this };
+
+    return (result -= val);
+}
+template <typename T, unsigned int DIM> template <typename U>
+inline constexpr Vec<T, DIM> Vec<T, DIM>::operator*(const U& val) const noexcept {
+    Vec<T, DIM> result{ *this };
+
+    return (result *= val);
+}
+template <typename T, unsigned int DIM> template <typename U>
+inline constexpr Vec<T, DIM> Vec<T, DIM>::operator/(const U& val) const {
+    Vec<T, DIM> result{ *this };
+
+    return (result /= val);
+}
+
+template <typename T, unsigned int DIM> template <typename U>
+inline constexpr T Vec<T, DIM>::dot(const Vec<U, DIM>& other) const noexcept {
+    // split accumulators pay off without registers too
+    if constexpr (isSame<T, U>) {
+        if (!isConstantEvaluated())
+            return SIMD::dotN(mLANE, other.mLANE, DIM);
+    }
+
+    T sum = static_cast<T>(0);
+    for (unsigned int i = 0; i < DIM; ++i)
+        sum = static_cast<T>(sum + mLANE[i] * other.mLANE[i]);
+
+    return sum;
+}
+
+template <typename T, unsigned int DIM> inline Vec<T, DIM> Vec<T, DIM>::normalize() const noexcept { return (*this / length()); }
+template <typename T, unsigned int DIM> inline constexpr T Vec<T, DIM>::length() const noexcept { return static_cast<T>(std::sqrt(lengthSquare())); }
+template <typename T, unsigned int DIM> inline constexpr T Vec<T, DIM>::lengthSquare() const noexcept { return dot(*this); }
+
+template <typename T, unsigned int DIM> template <typename U>
+inline constexpr T Vec<T, DIM>::dot(const Vec<T, DIM>& v1, const Vec<U, DIM>& v2) noexcept { return v1.dot(v2); }
+
+template <typename T, unsigned int DIM> inline Vec<T, DIM> Vec<T, DIM>::normalize(const Vec<T, DIM>& v) noexcept { return v.normalize(); }
+template <typename T, unsigned int DIM> inline constexpr T Vec<T, DIM>::length(const Vec<T, DIM>& v) noexcept { return v.length(); }
+template <typename T, unsigned int DIM> inline constexpr T Vec<T, DIM>::lengthSquare(const Vec<T, DIM>& v) noexcept { return v.lengthSquare(); }
+
+static_assert(isTriviallyCopyable<Vec<float, 8>>   && isStandardLayout<Vec<float, 8>>);
+static_assert(isTriviallyCopyable<Vec<double, 16>> && isStandardLayout<Vec<double, 16>>);
\ No newline at end of file
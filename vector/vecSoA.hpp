@@ -0,0 +1,380 @@
+#pragma once
+
+#include "../aligned.hpp"
+#include "../base.hpp"
+#include "../math.hpp"
+#include "../typeHandler.hpp"
+
+#include <cassert>      // assert()
+#include <cmath>        // sqrt()
+#include <cstddef>      // size_t
+
+// Structure-of-arrays storage for Vec<T, DIM>: one 64-byte aligned stream per axis,
+// so every batch operation below is a straight loop over contiguous lanes.
+template <typename T, unsigned int DIM>
+class VecSoA {
+    static_assert(isArithmetic<T> && DIM > 0);
+
+    public:
+        inline static constexpr std::size_t ALIGNMENT = Aligned::ALIGNMENT;
+
+    public:
+        VecSoA() noexcept;
+        VecSoA(const VecSoA<T, DIM>&);
+        VecSoA(VecSoA<T, DIM>&&) noexcept;
+        ~VecSoA() noexcept;
+
+        explicit VecSoA(const std::size_t& count);
+        VecSoA(const Vec<T, DIM>* src, const std::size_t& count);
+
+        VecSoA<T, DIM>& operator=(const VecSoA<T, DIM>&);
+        VecSoA<T, DIM>& operator=(VecSoA<T, DIM>&&) noexcept;
+
+        // stream of one axis (0 = x, 1 = y, ...)
+        inline T* operator[](const unsigned int& axis);
+        inline const T* operator[](const unsigned int& axis) const;
+
+        inline Vec<T, DIM> get(const std::size_t& idx) const;
+        inline void set(const std::size_t& idx, const Vec<T, DIM>&);
+
+        void resize(const std::size_t& count);
+        void fromAoS(const Vec<T, DIM>* src, const std::size_t& count);
+        void toAoS(Vec<T, DIM>* dst) const noexcept;
+
+        inline std::size_t size() const noexcept;
+        inline std::size_t capacity() const noexcept;
+
+        VecSoA<T, DIM>& operator+=(const VecSoA<T, DIM>&) noexcept;
+        VecSoA<T, DIM>& operator-=(const VecSoA<T, DIM>&) noexcept;
+        template <typename U> VecSoA<T, DIM>& operator+=(const U&) noexcept;
+        template <typename U> VecSoA<T, DIM>& operator-=(const U&) noexcept;
+        template <typename U> VecSoA<T, DIM>& operator*=(const U&) noexcept;
+        template <typename U> VecSoA<T, DIM>& operator/=(const U&);
+
+        // out[i] = (*this)[i] . other[i]
+        void dot(const VecSoA<T, DIM>& other, T* out) const noexcept;
+        // out[i] = (*this)[i] x other[i]
+        template <unsigned int D = DIM, typename = enableIF<D == 3>>
+        void cross(const VecSoA<T, DIM>& other, VecSoA<T, DIM>& out) const;
+
+        void length(T* out) const noexcept;
+        void lengthSquare(T* out) const noexcept;
+        // zero-length elements are not checked (the per-element assert of Vec::normalize would stop vectorization)
+        VecSoA<T, DIM>& normalize() noexcept;
+
+    private:
+        void allocate(const std::size_t& count);
+        void release() noexcept;
+
+
+    private:
+        T* mStream[DIM]{ };
+        std::size_t mSize{ };
+        std::size_t mCapacity{ };
+};
+
+template <typename T, unsigned int DIM> VecSoA<T, DIM>::VecSoA() noexcept { }
+template <typename T, unsigned int DIM> VecSoA<T, DIM>::VecSoA(const VecSoA<T, DIM>& other) { *this = other; }
+template <typename T, unsigned int DIM> VecSoA<T, DIM>::VecSoA(VecSoA<T, DIM>&& other) noexcept { *this = move(other); }
+template <typename T, unsigned int DIM> VecSoA<T, DIM>::~VecSoA() noexcept { release(); }
+
+template <typename T, unsigned int DIM>
+VecSoA<T, DIM>::VecSoA(const std::size_t& count) { resize(count); }
+template <typename T, unsigned int DIM>
+VecSoA<T, DIM>::VecSoA(const Vec<T, DIM>* src, const std::size_t& count) { fromAoS(src, count); }
+
+template <typename T, unsigned int DIM>
+VecSoA<T, DIM>& VecSoA<T, DIM>::operator=(const VecSoA<T, DIM>& other) {
+    if (this == &other)
+        return *this;
+
+    resize(other.mSize);
+
+    for (unsigned int axis = 0; axis < DIM; ++axis) {
+        for (std::size_t i = 0; i < mSize; ++i)
+            mStream[axis][i] = other.mStream[axis][i];
+    }
+
+    return *this;
+}
+template <typename T, unsigned int DIM>
+VecSoA<T, DIM>& VecSoA<T, DIM>::operator=(VecSoA<T, DIM>&& other) noexcept {
+    if (this == &other)
+        return *this;
+
+    release();
+
+    for (unsigned int axis = 0; axis < DIM; ++axis) {
+        mStream[axis] = other.mStream[axis];
+        other.mStream[axis] = nullptr;
+    }
+
+    mSize     = other.mSize;
+    mCapacity = other.mCapacity;
+
+    other.mSize     = 0;
+    other.mCapacity = 0;
+
+    return *this;
+}
+
+template <typename T, unsigned int DIM>
+inline T* VecSoA<T, DIM>::operator[](const unsigned int& axis) {
+    assert(axis < DIM);
+
+    return mStream[axis];
+}
+template <typename T, unsigned int DIM>
+inline const T* VecSoA<T, DIM>::operator[](const unsigned int& axis) const {
+    assert(axis < DIM);
+
+    return mStream[axis];
+}
+
+template <typename T, unsigned int DIM>
+inline Vec<T, DIM> VecSoA<T, DIM>::get(const std::size_t& idx) const {
+    assert(idx < mSize);
+
+    Vec<T, DIM> v;
+    for (unsigned int axis = 0; axis < DIM; ++axis)
+        v[axis] = mStream[axis][idx];
+
+    return v;
+}
+template <typename T, unsigned int DIM>
+inline void VecSoA<T, DIM>::set(const std::size_t& idx, const Vec<T, DIM>& v) {
+    assert(idx < mSize);
+
+    for (unsigned int axis = 0; axis < DIM; ++axis)
+        mStream[axis][idx] = v[axis];
+}
+
+template <typename T, unsigned int DIM>
+void VecSoA<T, DIM>::resize(const std::size_t& count) {
+    const std::size_t oldSize = mSize;
+
+    if (count > mCapacity) {
+        VecSoA<T, DIM> grown;
+        grown.allocate(count);
+
+        for (unsigned int axis = 0; axis < DIM; ++axis) {
+            for (std::size_t i = 0; i < mSize; ++i)
+                grown.mStream[axis][i] = mStream[axis][i];
+        }
+
+        *this = move(grown);
+    }
+
+    for (unsigned int axis = 0; axis < DIM; ++axis) {
+        for (std::size_t i = oldSize; i < count; ++i)
+            mStream[axis][i] = { };
+    }
+
+    mSize = count;
+}
+template <typename T, unsigned int DIM>
+void VecSoA<T, DIM>::fromAoS(const Vec<T, DIM>* src, const std::size_t& count) {
+    resize(count);
+
+    // one pass over the source, DIM sequential write streams
+    for (std::size_t i = 0; i < count; ++i) {
+        for (unsigned int axis = 0; axis < DIM; ++axis)
+            mStream[axis][i] = src[i][axis];
+    }
+}
+template <typename T, unsigned int DIM>
+void VecSoA<T, DIM>::toAoS(Vec<T, DIM>* dst) const noexcept {
+    for (std::size_t i = 0; i < mSize; ++i) {
+        for (unsigned int axis = 0; axis < DIM; ++axis)
+            dst[i][axis] = mStream[axis][i];
+    }
+}
+
+template <typename T, unsigned int DIM>
+inline std::size_t VecSoA<T, DIM>::size() const noexcept { return mSize; }
+template <typename T, unsigned int DIM>
+inline std::size_t VecSoA<T, DIM>::capacity() const noexcept { return mCapacity; }
+
+template <typename T, unsigned int DIM>
+VecSoA<T, DIM>& VecSoA<T, DIM>::operator+=(const VecSoA<T, DIM>& other) noexcept {
+    assert(mSize == other.mSize);
+
+    for (unsigned int axis = 0; axis < DIM; ++axis) {
+        T* a = mStream[axis];
+        const T* b = other.mStream[axis];
+
+        for (std::size_t i = 0; i < mSize; ++i)
+            a[i] = static_cast<T>(a[i] + b[i]);
+    }
+
+    return *this;
+}
+template <typename T, unsigned int DIM>
+VecSoA<T, DIM>& VecSoA<T, DIM>::operator-=(const VecSoA<T, DIM>& other) noexcept {
+    assert(mSize == other.mSize);
+
+    for (unsigned int axis = 0; axis < DIM; ++axis) {
+        T* a = mStream[axis];
+        const T* b = other.mStream[axis];
+
+        for (std::size_t i = 0; i < mSize; ++i)
+            a[i] = static_cast<T>(a[i] - b[i]);
+    }
+
+    return *this;
+}
+template <typename T, unsigned int DIM> template <typename U>
+VecSoA<T, DIM>& VecSoA<T, DIM>::operator+=(const U& val) noexcept {
+    for (unsigned int axis = 0; axis < DIM; ++axis) {
+        T* a = mStream[axis];
+
+        for (std::size_t i = 0; i < mSize; ++i)
+            a[i] = static_cast<T>(a[i] + val);
+    }
+
+    return *this;
+}
+template <typename T, unsigned int DIM> template <typename U>
+VecSoA<T, DIM>& VecSoA<T, DIM>::operator-=(const U& val) noexcept {
+    for (unsigned int axis = 0; axis < DIM; ++axis) {
+        T* a = mStream[axis];
+
+        for (std::size_t i = 0; i < mSize; ++i)
+            a[i] = static_cast<T>(a[i] - val);
+    }
+
+    return *this;
+}
+template <typename T, unsigned int DIM> template <typename U>
+VecSoA<T, DIM>& VecSoA<T, DIM>::operator*=(const U& val) noexcept {
+    for (unsigned int axis = 0; axis < DIM; ++axis) {
+        T* a = mStream[axis];
+
+        for (std::size_t i = 0; i < mSize; ++i)
+            a[i] = static_cast<T>(a[i] * val);
+    }
+
+    return *this;
+}
+template <typename T, unsigned int DIM> template <typename U>
+VecSoA<T, DIM>& VecSoA<T, DIM>::operator/=(const U& val) {
+    assert(!Math::isZero(val));
+
+    for (unsigned int axis = 0; axis < DIM; ++axis) {
+        T* a = mStream[axis];
+
+        for (std::size_t i = 0; i < mSize; ++i)
+            a[i] = static_cast<T>(a[i] / val);
+    }
+
+    return *this;
+}
+
+template <typename T, unsigned int DIM>
+void VecSoA<T, DIM>::dot(const VecSoA<T, DIM>& other, T* out) const noexcept {
+    assert(mSize == other.mSize);
+
+    for (std::size_t i = 0; i < mSize; ++i)
+        out[i] = static_cast<T>(mStream[0][i] * other.mStream[0][i]);
+
+    for (unsigned int axis = 1; axis < DIM; ++axis) {
+        const T* a = mStream[axis];
+        const T* b = other.mStream[axis];
+
+        for (std::size_t i = 0; i < mSize; ++i)
+            out[i] = static_cast<T>(out[i] + a[i] * b[i]);
+    }
+}
+template <typename T, unsigned int DIM> template <unsigned int, typename>
+void VecSoA<T, DIM>::cross(const VecSoA<T, DIM>& other, VecSoA<T, DIM>& out) const {
+    assert(mSize == other.mSize);
+
+    out.resize(mSize);
+
+    const T* ax = mStream[0];
+    const T* ay = mStream[1];
+    const T* az = mStream[2];
+    const T* bx = other.mStream[0];
+    const T* by = other.mStream[1];
+    const T* bz = other.mStream[2];
+
+    T* ox = out.mStream[0];
+    T* oy = out.mStream[1];
+    T* oz = out.mStream[2];
+
+    for (std::size_t i = 0; i < mSize; ++i) {
+        const T x = static_cast<T>(ay[i] * bz[i] - az[i] * by[i]);
+        const T y = static_cast<T>(az[i] * bx[i] - ax[i] * bz[i]);
+        const T z = static_cast<T>(ax[i] * by[i] - ay[i] * bx[i]);
+
+        ox[i] = x;
+        oy[i] = y;
+        oz[i] = z;
+    }
+}
+
+template <typename T, unsigned int DIM>
+void VecSoA<T, DIM>::length(T* out) const noexcept {
+    lengthSquare(out);
+
+    for (std::size_t i = 0; i < mSize; ++i)
+        out[i] = static_cast<T>(std::sqrt(out[i]));
+}
+template <typename T, unsigned int DIM>
+void VecSoA<T, DIM>::lengthSquare(T* out) const noexcept { dot(*this, out); }
+template <typename T, unsigned int DIM>
+VecSoA<T, DIM>& VecSoA<T, DIM>::normalize() noexcept {
+    // blocks keep the lengths in L1 between the two passes
+    constexpr std::size_t BLOCK = 1024;
+    alignas(ALIGNMENT) T len[BLOCK];
+
+    for (std::size_t base = 0; base < mSize; base += BLOCK) {
+        const std::size_t count = (mSize - base < BLOCK) ? (mSize - base) : BLOCK;
+
+        for (std::size_t i = 0; i < count; ++i)
+            len[i] = static_cast<T>(mStream[0][base + i] * mStream[0][base + i]);
+        for (unsigned int axis = 1; axis < DIM; ++axis) {
+            const T* a = mStream[axis] + base;
+
+            for (std::size_t i = 0; i < count; ++i)
+                len[i] = static_cast<T>(len[i] + a[i] * a[i]);
+        }
+        for (std::size_t i = 0; i < count; ++i)
+            len[i] = static_cast<T>(std::sqrt(len[i]));
+
+        for (unsigned int axis = 0; axis < DIM; ++axis) {
+            T* a = mStream[axis] + base;
+
+            for (std::size_t i = 0; i < count; ++i)
+                a[i] = static_cast<T>(a[i] / len[i]);
+        }
+    }
+
+    return *this;
+}
+
+template <typename T, unsigned int DIM>
+void VecSoA<T, DIM>::allocate(const std::size_t& count) {
+    release();
+
+    // every stream starts on an ALIGNMENT boundary
+    const std::size_t stride = Aligned::roundUp<T>(count);
+    if (stride == 0)
+        return;
+
+    T* block = Aligned::allocate<T>(stride * DIM);
+    for (unsigned int axis = 0; axis < DIM; ++axis)
+        mStream[axis] = block + axis * stride;
+
+    mCapacity = stride;
+}
+template <typename T, unsigned int DIM>
+void VecSoA<T, DIM>::release() noexcept {
+    Aligned::release(mStream[0]);
+
+    for (unsigned int axis = 0; axis < DIM; ++axis)
+        mStream[axis] = nullptr;
+
+    mSize     = 0;
+    mCapacity = 0;
+}
\ No newline at end of file